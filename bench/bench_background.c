@@ -0,0 +1,194 @@
+// Background compositor benchmark
+// Compares the previous z-buffer 0 pass (player FOV fetched through the ECS
+// and tiles read through bounds-checked getters for every cell) against
+// render_system_compose_background, which resolves the FOV once, indexes the
+// dungeon directly and maps tile types through a glyph table. Both run on the
+// same seeded dungeon with the player's FOV computed at each sampled position,
+// and their z-buffers are compared so the rewrite is checked for equal output.
+//
+// Usage: bench_background [passes] [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "log.h"
+#include "appstate.h"
+#include "config.h"
+#include "mempool.h"
+#include "ecs.h"
+#include "components.h"
+#include "dungeon.h"
+#include "field.h"
+#include "render_system.h"
+
+#define BENCH_DEFAULT_PASSES 2000
+#define BENCH_DEFAULT_SEED 12345
+#define BENCH_VIEWPOINTS 64
+#define BENCH_CELLS (g_width * g_height)
+
+typedef struct {
+    int x, y;
+    int viewport_x, viewport_y;
+} Viewpoint;
+
+// Z-buffer cell layout the previous compositor wrote
+typedef struct {
+    char character;
+    uint8_t color;
+    bool has_content;
+} LegacyCell;
+
+static Viewpoint g_viewpoints[BENCH_VIEWPOINTS];
+static LegacyCell *g_legacy_cells;
+static int g_width, g_height; // Game area in cells, from the default render config
+static uint32_t g_viewpoint_count;
+
+// The compositor as it was before: one ECS lookup and three getters per cell
+static void legacy_compose_background(AppState *app_state) {
+    memset(g_legacy_cells, 0, BENCH_CELLS * sizeof(LegacyCell));
+
+    for (int screen_y = 0; screen_y < g_height; screen_y++) {
+        for (int screen_x = 0; screen_x < g_width; screen_x++) {
+            int dungeon_x = app_state->render.viewport_x + screen_x;
+            int dungeon_y = app_state->render.viewport_y + screen_y;
+            if (dungeon_x < 0 || dungeon_x >= DUNGEON_WIDTH || dungeon_y < 0 || dungeon_y >= DUNGEON_HEIGHT) {
+                continue;
+            }
+
+            uint8_t visibility = 0;
+            CompactFieldOfView *player_fov = ECS_GET(app_state, app_state->player, FieldOfView);
+            if (player_fov) {
+                if (field_is_visible_compact(player_fov, dungeon_x, dungeon_y)) {
+                    visibility = 1;
+                } else if (dungeon_is_explored(&app_state->dungeon, dungeon_x, dungeon_y)) {
+                    visibility = 2;
+                }
+            }
+
+            if (visibility > 0) {
+                Tile *tile = dungeon_get_tile(&app_state->dungeon, dungeon_x, dungeon_y);
+                TileInfo *info = tile ? dungeon_get_tile_info(tile->type) : NULL;
+                if (info) {
+                    LegacyCell *cell = &g_legacy_cells[screen_y * g_width + screen_x];
+                    cell->character = info->symbol;
+                    cell->color = visibility == 2 ? 0x08 : info->color;
+                    cell->has_content = true;
+                }
+            }
+        }
+    }
+}
+
+// Room centers, with the viewport centered and clamped like update_viewport
+static void pick_viewpoints(Dungeon *dungeon) {
+    BenchPoint centers[BENCH_VIEWPOINTS];
+    g_viewpoint_count = bench_room_centers(dungeon, centers, BENCH_VIEWPOINTS);
+    for (uint32_t v = 0; v < g_viewpoint_count; v++) {
+        Viewpoint *view = &g_viewpoints[v];
+        view->x = centers[v].x;
+        view->y = centers[v].y;
+        view->viewport_x = view->x - g_width / 2;
+        view->viewport_y = view->y - g_height / 2;
+        if (view->viewport_x < 0) view->viewport_x = 0;
+        if (view->viewport_y < 0) view->viewport_y = 0;
+        if (view->viewport_x > DUNGEON_WIDTH - g_width) view->viewport_x = DUNGEON_WIDTH - g_width;
+        if (view->viewport_y > DUNGEON_HEIGHT - g_height) view->viewport_y = DUNGEON_HEIGHT - g_height;
+    }
+}
+
+// Move the player to a viewpoint and recompute its FOV (explores tiles as a side effect)
+static void enter_viewpoint(AppState *app_state, const Viewpoint *view) {
+    Position *pos = ECS_GET(app_state, app_state->player, Position);
+    CompactFieldOfView *fov = ECS_GET(app_state, app_state->player, FieldOfView);
+    pos->x = (float)view->x;
+    pos->y = (float)view->y;
+    field_calculate_fov_compact(fov, &app_state->dungeon, view->x, view->y);
+    app_state->render.viewport_x = view->viewport_x;
+    app_state->render.viewport_y = view->viewport_y;
+}
+
+static double run(AppState *app_state, void (*compose)(AppState *), uint32_t passes) {
+    double total = 0;
+    for (uint32_t v = 0; v < g_viewpoint_count; v++) {
+        enter_viewpoint(app_state, &g_viewpoints[v]);
+        double start = bench_now_ns();
+        for (uint32_t pass = 0; pass < passes; pass++) {
+            compose(app_state);
+        }
+        total += bench_now_ns() - start;
+    }
+    return total / ((double)passes * g_viewpoint_count);
+}
+
+// Same cells from both compositors at every viewpoint
+static bool outputs_match(AppState *app_state) {
+    for (uint32_t v = 0; v < g_viewpoint_count; v++) {
+        enter_viewpoint(app_state, &g_viewpoints[v]);
+        legacy_compose_background(app_state);
+        render_system_compose_background(app_state);
+        const ZBufferCell *background = zbuffer_layer(&app_state->render.z_buffer, RENDER_LAYER_BACKGROUND);
+        for (int i = 0; i < BENCH_CELLS; i++) {
+            const LegacyCell *a = &g_legacy_cells[i];
+            ZBufferCell b = background[i];
+            if (a->has_content != (b != ZCELL_EMPTY) ||
+                (a->has_content && (a->character != zcell_glyph(b) || a->color != zcell_fg(b)))) {
+                fprintf(stderr, "Mismatch at viewpoint %u cell %d\n", v, i);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t passes = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_PASSES;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_SEED;
+    if (passes == 0) passes = BENCH_DEFAULT_PASSES;
+
+    AppState *app_state = bench_app_init();
+    if (!app_state) return 1;
+    if (!bench_mempool_init(app_state)) return 1;
+    ecs_init(app_state);
+
+    // Game area at the configured size
+    g_width = (int)app_state->config.render.game_area_width;
+    g_height = (int)app_state->config.render.game_area_height;
+    app_state->render.game_area_width = g_width;
+    app_state->render.game_area_height = g_height;
+
+    dungeon_init(&app_state->dungeon);
+    dungeon_generate_seeded(&app_state->dungeon, seed);
+    pick_viewpoints(&app_state->dungeon);
+
+    // Only the background layer is needed, so no renderer
+    bool allocated = zbuffer_init(&app_state->render.z_buffer, (uint32_t)BENCH_CELLS);
+    g_legacy_cells = calloc(BENCH_CELLS, sizeof(LegacyCell));
+
+    app_state->player = entity_create(app_state);
+    Position player_pos = { .x = 0, .y = 0, .entity = INVALID_ENTITY };
+    CompactFieldOfView player_fov;
+    field_init_compact(&player_fov, FOV_RADIUS);
+    ECS_ADD(app_state, app_state->player, Position, &player_pos);
+    ECS_ADD(app_state, app_state->player, FieldOfView, &player_fov);
+
+    if (!allocated || !g_legacy_cells || g_viewpoint_count == 0) {
+        fprintf(stderr, "Failed to set up benchmark\n");
+        return 1;
+    }
+
+    bool match = outputs_match(app_state);
+    printf("Background compositor, %dx%d viewport, %u viewpoints x %u passes (seed %u)\n",
+           g_width, g_height, g_viewpoint_count, passes, seed);
+    double legacy = run(app_state, legacy_compose_background, passes);
+    double current = run(app_state, render_system_compose_background, passes);
+    printf("  per-cell lookups (before):  %8.2f us/pass\n", legacy / 1000.0);
+    printf("  compositor (after):         %8.2f us/pass  (%.1fx)\n", current / 1000.0, legacy / current);
+    printf("  output %s\n", match ? "identical" : "DIFFERS");
+
+    free(g_legacy_cells);
+    zbuffer_free(&app_state->render.z_buffer);
+    ecs_shutdown(app_state);
+    bench_app_shutdown(app_state);
+    return match ? 0 : 1;
+}
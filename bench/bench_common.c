@@ -0,0 +1,66 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "bench_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "log.h"
+#include "config.h"
+#include "mempool.h"
+
+double bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+AppState *bench_app_init(void) {
+    LogConfig log_config = {
+        .min_level = LOG_LEVEL_WARN,
+        .use_colors = false,
+        .use_timestamps = false,
+        .log_file = NULL
+    };
+    log_init(log_config);
+
+    if (!appstate_init() || !config_init(appstate_get())) {
+        fprintf(stderr, "Failed to initialize AppState\n");
+        return NULL;
+    }
+    return appstate_get();
+}
+
+bool bench_mempool_init(AppState *app_state) {
+    mempool_set_chunk_limits(app_state, 1, 1024);
+    if (!mempool_init(app_state)) {
+        fprintf(stderr, "Failed to initialize memory pool\n");
+        return false;
+    }
+    return true;
+}
+
+void bench_app_shutdown(AppState *app_state) {
+    mempool_cleanup(app_state);
+    config_cleanup(app_state);
+    appstate_shutdown();
+    log_shutdown();
+}
+
+uint32_t bench_room_centers(const Dungeon *dungeon, BenchPoint *points, uint32_t max) {
+    uint32_t count = 0;
+    for (int i = 0; i < dungeon->room_count && count < max; i++) {
+        points[count].x = dungeon->rooms[i].x + dungeon->rooms[i].width / 2;
+        points[count].y = dungeon->rooms[i].y + dungeon->rooms[i].height / 2;
+        count++;
+    }
+    return count;
+}
+
+BenchPoint bench_random_floor(const Dungeon *dungeon) {
+    for (;;) {
+        BenchPoint point;
+        point.x = rand() % DUNGEON_WIDTH;
+        point.y = rand() % DUNGEON_HEIGHT;
+        if (!dungeon_tile_blocks_sight(dungeon->tiles[point.x][point.y].type)) return point;
+    }
+}
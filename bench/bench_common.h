@@ -0,0 +1,35 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "appstate.h"
+#include "dungeon.h"
+
+// Shared benchmark fixture: timing, quiet logging and AppState setup/teardown.
+// Linked into every benchmark; not part of the game build.
+
+typedef struct {
+    int x, y;
+} BenchPoint;
+
+// Monotonic clock in nanoseconds
+double bench_now_ns(void);
+
+// Log warnings and up to stderr, then bring up AppState with the default config.
+// Prints the failure and returns NULL if either step fails.
+AppState *bench_app_init(void);
+
+// Memory pool with small chunk limits, as the benchmarks size their own worlds
+bool bench_mempool_init(AppState *app_state);
+
+// Undo bench_app_init and bench_mempool_init (the pool only if it was started)
+void bench_app_shutdown(AppState *app_state);
+
+// Center tile of each room, in room order, up to max points; returns the count
+uint32_t bench_room_centers(const Dungeon *dungeon, BenchPoint *points, uint32_t max);
+
+// Uniformly random tile that doesn't block sight, drawn with rand()
+BenchPoint bench_random_floor(const Dungeon *dungeon);
+
+#endif // BENCH_COMMON_H
@@ -0,0 +1,234 @@
+// Mass spawn/despawn benchmark
+// Spawns a level's worth of items (Position + BaseInfo + Actor) and destroys them
+// again, once with direct entity_create/component_add calls and once through the
+// deferred command buffer. The buffered path folds each entity's components into
+// one storage change, which matters most for archetype storage.
+// Before timing, checks provisional handle resolution, per-entity folding, buffer
+// order and the worker-thread guard on direct structural calls; exits non-zero on
+// a mismatch.
+
+#include <stdio.h>
+#include "bench_common.h"
+#include "log.h"
+#include "appstate.h"
+#include "config.h"
+#include "mempool.h"
+#include "ecs.h"
+#include "ecs_commands.h"
+#include "components.h"
+#include "thread_pool.h"
+
+#define BENCH_ROUNDS 20
+#define VERIFY_WORKERS 2
+
+#define VERIFY(condition, what) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "Command buffer check failed: %s\n", what); \
+        return false; \
+    } \
+} while (0)
+
+static void make_item(uint32_t i, Position *pos, BaseInfo *info, Actor *actor) {
+    memset(info, 0, sizeof(BaseInfo));
+    memset(actor, 0, sizeof(Actor));
+    pos->x = (float)(i & 0xFF);
+    pos->y = (float)(i >> 8);
+    pos->entity = INVALID_ENTITY;
+    info->character = '!';
+    actor->hp = 1;
+}
+
+static void bench_direct(struct AppState *app_state, Entity *entities, uint32_t count, double *spawn_ns, double *despawn_ns) {
+    double start = bench_now_ns();
+    for (uint32_t i = 0; i < count; i++) {
+        Position pos;
+        BaseInfo info;
+        Actor actor;
+        make_item(i, &pos, &info, &actor);
+        entities[i] = entity_create(app_state);
+        ECS_ADD(app_state, entities[i], Position, &pos);
+        ECS_ADD(app_state, entities[i], BaseInfo, &info);
+        ECS_ADD(app_state, entities[i], Actor, &actor);
+    }
+    *spawn_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (uint32_t i = 0; i < count; i++) {
+        entity_destroy(app_state, entities[i]);
+    }
+    *despawn_ns += bench_now_ns() - start;
+}
+
+static void bench_buffered(struct AppState *app_state, Entity *entities, uint32_t count, double *spawn_ns, double *despawn_ns) {
+    double start = bench_now_ns();
+    for (uint32_t i = 0; i < count; i++) {
+        Position pos;
+        BaseInfo info;
+        Actor actor;
+        make_item(i, &pos, &info, &actor);
+        entities[i] = ecs_cmd_create(app_state);
+        ECS_CMD_ADD(app_state, entities[i], Position, &pos);
+        ECS_CMD_ADD(app_state, entities[i], BaseInfo, &info);
+        ECS_CMD_ADD(app_state, entities[i], Actor, &actor);
+    }
+    ecs_commands_flush(app_state);
+    *spawn_ns += bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (uint32_t i = 0; i < count; i++) {
+        ecs_cmd_destroy(app_state, ecs_commands_resolve(app_state, entities[i]));
+    }
+    ecs_commands_flush(app_state);
+    *despawn_ns += bench_now_ns() - start;
+}
+
+typedef struct {
+    struct AppState *app_state;
+    Entity entity;
+    int x;
+    bool direct_add_refused;
+} WorkerRecord;
+
+static void verify_worker_job(void *data, uint32_t worker_index) {
+    (void)worker_index;
+    WorkerRecord *record = (WorkerRecord *)data;
+    Position pos = { record->x, 0, INVALID_ENTITY };
+    ECS_CMD_SET(record->app_state, record->entity, Position, &pos);
+
+    // Direct structural changes are refused (and logged) here; the command above is the way in
+    Actor actor;
+    memset(&actor, 0, sizeof(Actor));
+    record->direct_add_refused = !ECS_ADD(record->app_state, record->entity, Actor, &actor);
+}
+
+static bool verify_commands(struct AppState *app_state) {
+    Position pos = { 3, 4, INVALID_ENTITY };
+    BaseInfo info;
+    memset(&info, 0, sizeof(BaseInfo));
+    info.character = '!';
+
+    // A provisional handle resolves to a live entity carrying what was recorded
+    Entity pending = ecs_cmd_create(app_state);
+    VERIFY(pending != INVALID_ENTITY, "create recorded");
+    VERIFY(!entity_exists(app_state, pending), "provisional handle is not live before the flush");
+    VERIFY(ECS_CMD_ADD(app_state, pending, Position, &pos), "add recorded on a provisional handle");
+    VERIFY(ECS_CMD_ADD(app_state, pending, BaseInfo, &info), "second add recorded on a provisional handle");
+    VERIFY(ecs_commands_pending(app_state) == 3, "three commands pending");
+    ecs_commands_flush(app_state);
+    VERIFY(ecs_commands_pending(app_state) == 0, "nothing pending after the flush");
+
+    Entity entity = ecs_commands_resolve(app_state, pending);
+    VERIFY(entity_exists(app_state, entity), "provisional handle resolves to a live entity");
+    Position *got = ECS_GET(app_state, entity, Position);
+    VERIFY(got && got->x == 3 && got->y == 4, "recorded Position applied");
+    VERIFY(ECS_HAS(app_state, entity, BaseInfo), "recorded BaseInfo applied");
+
+    // Folding in record order: add, remove, add again leaves the last add; a set after it wins
+    Position first = { 1, 1, INVALID_ENTITY };
+    Position second = { 2, 2, INVALID_ENTITY };
+    Actor actor;
+    memset(&actor, 0, sizeof(Actor));
+    actor.hp = 7;
+    ECS_CMD_ADD(app_state, entity, Actor, &actor);
+    ECS_CMD_REMOVE(app_state, entity, Actor);
+    actor.hp = 9;
+    ECS_CMD_ADD(app_state, entity, Actor, &actor);
+    ECS_CMD_SET(app_state, entity, Position, &first);
+    ECS_CMD_SET(app_state, entity, Position, &second);
+    ecs_commands_flush(app_state);
+    Actor *got_actor = ECS_GET(app_state, entity, Actor);
+    VERIFY(got_actor && got_actor->hp == 9, "add, remove, add folds to the last add");
+    got = ECS_GET(app_state, entity, Position);
+    VERIFY(got && got->x == 2, "later set wins");
+
+    // A set only applies to a component the entity has
+    ECS_CMD_REMOVE(app_state, entity, Actor);
+    ECS_CMD_SET(app_state, entity, Actor, &actor);
+    ecs_commands_flush(app_state);
+    VERIFY(!ECS_HAS(app_state, entity, Actor), "set after remove does not re-add");
+
+    // Destroy wins over everything else recorded for the entity
+    ECS_CMD_SET(app_state, entity, Position, &first);
+    ecs_cmd_destroy(app_state, entity);
+    ECS_CMD_ADD(app_state, entity, Actor, &actor);
+    ecs_commands_flush(app_state);
+    VERIFY(!entity_exists(app_state, entity), "destroy folds the other commands away");
+
+    // A destroyed provisional entity is never created
+    pending = ecs_cmd_create(app_state);
+    ECS_CMD_ADD(app_state, pending, Position, &pos);
+    ecs_cmd_destroy(app_state, pending);
+    ecs_commands_flush(app_state);
+    VERIFY(!entity_exists(app_state, ecs_commands_resolve(app_state, pending)), "create then destroy leaves nothing");
+
+    // Buffers apply in buffer order: the main thread's buffer first, then each worker's
+    if (app_state->ecs.workers) {
+        entity = entity_create(app_state);
+        ECS_ADD(app_state, entity, Position, &pos);
+
+        WorkerRecord record = { app_state, entity, 5, false };
+        Position main_pos = { 6, 0, INVALID_ENTITY };
+        VERIFY(thread_pool_submit(app_state->ecs.workers, 0, verify_worker_job, &record), "worker job submitted");
+        thread_pool_wait(app_state->ecs.workers);
+        ECS_CMD_SET(app_state, entity, Position, &main_pos);
+        ecs_commands_flush(app_state);
+
+        got = ECS_GET(app_state, entity, Position);
+        VERIFY(got && got->x == 5, "worker buffer applies after the main thread buffer");
+        VERIFY(record.direct_add_refused, "direct component_add refused on a worker");
+        VERIFY(!ECS_HAS(app_state, entity, Actor), "refused add left the entity unchanged");
+        entity_destroy(app_state, entity);
+    }
+    return true;
+}
+
+static void bench_spawn(struct AppState *app_state, uint32_t count) {
+    Entity *entities = malloc(sizeof(Entity) * count);
+    if (!entities) return;
+
+    double direct_spawn = 0, direct_despawn = 0, buffered_spawn = 0, buffered_despawn = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        bench_direct(app_state, entities, count, &direct_spawn, &direct_despawn);
+        bench_buffered(app_state, entities, count, &buffered_spawn, &buffered_despawn);
+    }
+
+    double scale = 1.0 / ((double)BENCH_ROUNDS * count);
+    printf("%8u items: direct %7.1f / %6.1f ns   buffered %7.1f / %6.1f ns   (spawn / despawn per entity)\n",
+           count, direct_spawn * scale, direct_despawn * scale, buffered_spawn * scale, buffered_despawn * scale);
+    free(entities);
+}
+
+int main(void) {
+    AppState *app_state = bench_app_init();
+    if (!app_state) return 1;
+    app_state->config.ecs.max_entities = MAX_ENTITIES;
+    app_state->config.ecs.worker_threads = VERIFY_WORKERS;
+    if (!bench_mempool_init(app_state)) return 1;
+
+    const struct { ECSStorageMode mode; const char *name; } backends[] = {
+        { ECS_STORAGE_SPARSE, "sparse" },
+        { ECS_STORAGE_ARCHETYPE, "archetype" }
+    };
+
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+        app_state->config.ecs.storage = backends[b].mode;
+        ecs_init(app_state);
+
+        if (!verify_commands(app_state)) {
+            fprintf(stderr, "%s storage failed the command buffer checks\n", backends[b].name);
+            ecs_shutdown(app_state);
+            bench_app_shutdown(app_state);
+            return 1;
+        }
+
+        printf("ECS mass spawn, %s storage (%d rounds per run)\n", backends[b].name, BENCH_ROUNDS);
+        bench_spawn(app_state, 100);
+        bench_spawn(app_state, 1000);
+        bench_spawn(app_state, 9000);
+
+        ecs_shutdown(app_state);
+    }
+
+    bench_app_shutdown(app_state);
+    return 0;
+}
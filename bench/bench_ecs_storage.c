@@ -0,0 +1,141 @@
+// Component storage layout benchmark
+// Compares iterating Position/Actor pairs stored the old way (one mempool
+// allocation per component behind a void* array) against the packed layout
+// SparseComponentArray now uses (component bytes contiguous by dense slot).
+// The live ECS is measured as well through component_get.
+
+#include <stdio.h>
+#include "bench_common.h"
+#include "log.h"
+#include "appstate.h"
+#include "config.h"
+#include "mempool.h"
+#include "ecs.h"
+#include "components.h"
+
+#define BENCH_ENTITIES 10000
+#define BENCH_PASSES 200
+
+// Old layout: dense array of pointers to individually allocated components
+typedef struct {
+    uint32_t sparse[BENCH_ENTITIES];
+    void *dense[BENCH_ENTITIES];
+    uint32_t count;
+} PointerArray;
+
+// New layout: dense array of packed component bytes
+typedef struct {
+    uint32_t sparse[BENCH_ENTITIES];
+    uint8_t *data;
+    uint32_t count;
+    size_t size;
+} PackedArray;
+
+static PointerArray g_ptr_pos, g_ptr_actor;
+static PackedArray g_packed_pos, g_packed_actor;
+static Entity g_entities[BENCH_ENTITIES];
+static volatile int64_t g_sink;
+
+static void fill(AppState *app_state) {
+    g_packed_pos.size = sizeof(Position);
+    g_packed_actor.size = sizeof(Actor);
+    g_packed_pos.data = malloc(sizeof(Position) * BENCH_ENTITIES);
+    g_packed_actor.data = malloc(sizeof(Actor) * BENCH_ENTITIES);
+
+    uint32_t position_id = COMPONENT_ID_Position;
+    uint32_t actor_id = COMPONENT_ID_Actor;
+
+    for (uint32_t i = 0; i < BENCH_ENTITIES; i++) {
+        Position pos = { .x = (int)i, .y = (int)(i / 7), .entity = INVALID_ENTITY };
+        Actor actor = { .energy_per_turn = 1, .hp = i, .max_hp = i };
+
+        // Interleave allocations the way entity creation does
+        Position *p = pool_malloc(sizeof(Position), app_state);
+        Actor *a = pool_malloc(sizeof(Actor), app_state);
+        void *noise = pool_malloc(sizeof(BaseInfo), app_state);
+        (void)noise;
+        *p = pos;
+        *a = actor;
+        g_ptr_pos.dense[i] = p;
+        g_ptr_pos.sparse[i] = i;
+        g_ptr_actor.dense[i] = a;
+        g_ptr_actor.sparse[i] = i;
+        g_ptr_pos.count = g_ptr_actor.count = i + 1;
+
+        memcpy(g_packed_pos.data + i * sizeof(Position), &pos, sizeof(Position));
+        memcpy(g_packed_actor.data + i * sizeof(Actor), &actor, sizeof(Actor));
+        g_packed_pos.sparse[i] = i;
+        g_packed_actor.sparse[i] = i;
+        g_packed_pos.count = g_packed_actor.count = i + 1;
+
+        g_entities[i] = entity_create(app_state);
+        component_add(app_state, g_entities[i], position_id, &pos);
+        component_add(app_state, g_entities[i], actor_id, &actor);
+    }
+}
+
+static double run_pointer(void) {
+    double start = bench_now_ns();
+    int64_t sum = 0;
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (uint32_t i = 0; i < g_ptr_pos.count; i++) {
+            Position *p = g_ptr_pos.dense[i];
+            Actor *a = g_ptr_actor.dense[g_ptr_actor.sparse[i]];
+            sum += p->x + p->y + (int64_t)a->hp;
+        }
+    }
+    g_sink = sum;
+    return (bench_now_ns() - start) / ((double)BENCH_PASSES * BENCH_ENTITIES);
+}
+
+static double run_packed(void) {
+    double start = bench_now_ns();
+    int64_t sum = 0;
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        const Position *positions = (const Position *)g_packed_pos.data;
+        for (uint32_t i = 0; i < g_packed_pos.count; i++) {
+            const Position *p = &positions[i];
+            const Actor *a = (const Actor *)(g_packed_actor.data + g_packed_actor.sparse[i] * g_packed_actor.size);
+            sum += p->x + p->y + (int64_t)a->hp;
+        }
+    }
+    g_sink = sum;
+    return (bench_now_ns() - start) / ((double)BENCH_PASSES * BENCH_ENTITIES);
+}
+
+static double run_ecs(AppState *app_state) {
+    uint32_t position_id = COMPONENT_ID_Position;
+    uint32_t actor_id = COMPONENT_ID_Actor;
+    double start = bench_now_ns();
+    int64_t sum = 0;
+    for (int pass = 0; pass < BENCH_PASSES; pass++) {
+        for (uint32_t i = 0; i < BENCH_ENTITIES; i++) {
+            Position *p = component_get(app_state, g_entities[i], position_id);
+            Actor *a = component_get(app_state, g_entities[i], actor_id);
+            sum += p->x + p->y + (int64_t)a->hp;
+        }
+    }
+    g_sink = sum;
+    return (bench_now_ns() - start) / ((double)BENCH_PASSES * BENCH_ENTITIES);
+}
+
+int main(void) {
+    AppState *app_state = bench_app_init();
+    if (!app_state) return 1;
+    app_state->config.ecs.max_entities = MAX_ENTITIES;
+    if (!bench_mempool_init(app_state)) return 1;
+    ecs_init(app_state);
+
+    fill(app_state);
+
+    printf("Position/Actor iteration over %d entities (%d passes)\n", BENCH_ENTITIES, BENCH_PASSES);
+    printf("  pointer-per-component layout: %6.2f ns/entity\n", run_pointer());
+    printf("  packed contiguous layout:     %6.2f ns/entity\n", run_packed());
+    printf("  ECS component_get (packed):   %6.2f ns/entity\n", run_ecs(app_state));
+
+    free(g_packed_pos.data);
+    free(g_packed_actor.data);
+    ecs_shutdown(app_state);
+    bench_app_shutdown(app_state);
+    return 0;
+}
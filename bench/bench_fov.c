@@ -0,0 +1,218 @@
+// Field of view benchmark
+// Compares the Bresenham raycaster (72 rays at 5 degree steps plus the 8 compass
+// directions, sqrt distance per step) against symmetric recursive shadowcasting
+// at radii 8, 16 and 32, from the center of every room of a seeded dungeon.
+// The two do not agree cell for cell: rays skip cells between them as the
+// radius grows, so the visible counts are reported rather than compared. The
+// shadowcaster is checked for symmetry instead: every floor cell it sees from a
+// viewpoint must see that viewpoint back. Last, walls are dug and doors toggled
+// around the viewpoints through dungeon_set_tile_type, and the cached FOV from
+// field_update_fov_compact is compared against a fresh calculation after each
+// edit, counting how many edits forced a recompute. Before that, a door is opened
+// or closed just outside and then just inside each viewpoint's FOV square: the
+// first must keep the cached grid and the second must recompute it.
+//
+// Usage: bench_fov [passes] [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "log.h"
+#include "appstate.h"
+#include "config.h"
+#include "dungeon.h"
+#include "field.h"
+
+#define BENCH_DEFAULT_PASSES 200
+#define BENCH_DEFAULT_SEED 12345
+#define BENCH_VIEWPOINTS 64
+
+typedef void (*FovFunction)(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y);
+
+static BenchPoint g_viewpoints[BENCH_VIEWPOINTS];
+static uint32_t g_viewpoint_count;
+
+// Average time per FOV calculation; visible receives the average visible cell count
+static double run(FovFunction calculate, Dungeon *dungeon, int radius, uint32_t passes, double *visible) {
+    CompactFieldOfView fov;
+    field_init_compact(&fov, radius);
+
+    uint64_t visible_total = 0;
+    for (uint32_t v = 0; v < g_viewpoint_count; v++) {
+        calculate(&fov, dungeon, g_viewpoints[v].x, g_viewpoints[v].y);
+        visible_total += field_count_visible_compact(&fov);
+    }
+    *visible = (double)visible_total / g_viewpoint_count;
+
+    double start = bench_now_ns();
+    for (uint32_t pass = 0; pass < passes; pass++) {
+        for (uint32_t v = 0; v < g_viewpoint_count; v++) {
+            calculate(&fov, dungeon, g_viewpoints[v].x, g_viewpoints[v].y);
+        }
+    }
+    return (bench_now_ns() - start) / ((double)passes * g_viewpoint_count);
+}
+
+// Every floor cell seen from a viewpoint sees the viewpoint back
+static bool shadowcast_is_symmetric(Dungeon *dungeon, int radius) {
+    CompactFieldOfView from, back;
+    field_init_compact(&from, radius);
+    field_init_compact(&back, radius);
+
+    for (uint32_t v = 0; v < g_viewpoint_count; v++) {
+        const BenchPoint *view = &g_viewpoints[v];
+        field_calculate_fov_shadowcast(&from, dungeon, view->x, view->y);
+        for (int dx = -radius; dx <= radius; dx++) {
+            for (int dy = -radius; dy <= radius; dy++) {
+                int x = view->x + dx;
+                int y = view->y + dy;
+                if (!field_is_visible_compact(&from, x, y) || dungeon->tiles[x][y].type == TILE_TYPE_WALL) continue;
+
+                field_calculate_fov_shadowcast(&back, dungeon, x, y);
+                if (!field_is_visible_compact(&back, view->x, view->y)) {
+                    fprintf(stderr, "Radius %d: (%d,%d) sees (%d,%d) but not back\n", radius, view->x, view->y, x, y);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool same_grid(const CompactFieldOfView *a, const CompactFieldOfView *b) {
+    return memcmp(a->visible, b->visible, (size_t)(a->radius * 2 + 1) * sizeof(a->visible[0])) == 0;
+}
+
+// A door edit one tile outside the FOV square keeps the cache; one inside recomputes.
+// Each edit is undone the same way before the next viewpoint.
+static bool door_edits_invalidate_by_box(Dungeon *dungeon, int radius) {
+    CompactFieldOfView cached, fresh;
+    field_init_compact(&cached, radius);
+    field_init_compact(&fresh, radius);
+
+    uint32_t checked = 0;
+    for (uint32_t v = 0; v < g_viewpoint_count; v++) {
+        const BenchPoint *view = &g_viewpoints[v];
+        const BenchPoint edits[2] = {
+            { view->x + radius + 1, view->y },    // Outside
+            { view->x + 1, view->y }              // Inside
+        };
+        if (edits[0].x >= dungeon->width) continue;
+
+        for (int e = 0; e < 2; e++) {
+            bool inside = e == 1;
+            TileType original = dungeon->tiles[edits[e].x][edits[e].y].type;
+            TileType door = dungeon_tile_blocks_sight(original) ? TILE_TYPE_DOOR : TILE_TYPE_DOOR_CLOSED;
+            const TileType steps[2] = { door, original };
+
+            field_update_fov_compact(&cached, dungeon, view->x, view->y);
+            for (int step = 0; step < 2; step++) {
+                dungeon_set_tile_type(dungeon, edits[e].x, edits[e].y, steps[step]);
+                bool recomputed = field_update_fov_compact(&cached, dungeon, view->x, view->y);
+                if (recomputed != inside) {
+                    fprintf(stderr, "Radius %d: door edit at (%d,%d) %s the FOV square of (%d,%d) %s\n",
+                            radius, edits[e].x, edits[e].y, inside ? "inside" : "outside", view->x, view->y,
+                            inside ? "kept the cache" : "forced a recompute");
+                    return false;
+                }
+                field_calculate_fov_compact(&fresh, dungeon, view->x, view->y);
+                if (!same_grid(&cached, &fresh)) {
+                    fprintf(stderr, "Radius %d: cached FOV at (%d,%d) stale after door edit at (%d,%d)\n",
+                            radius, view->x, view->y, edits[e].x, edits[e].y);
+                    return false;
+                }
+            }
+        }
+        checked++;
+    }
+
+    printf("  radius %2d  %u viewpoints: door edits outside kept the cache, inside recomputed\n", radius, checked);
+    return true;
+}
+
+// Each edit flips a tile near (or far from) a viewpoint, then the cached FOV is
+// updated and checked against a full recalculation
+static bool cache_matches_after_edits(Dungeon *dungeon, int radius, uint32_t edits) {
+    CompactFieldOfView cached, fresh;
+    field_init_compact(&cached, radius);
+    field_init_compact(&fresh, radius);
+
+    uint32_t recomputes = 0;
+    uint32_t hits = 0;
+    srand(radius);
+    for (uint32_t i = 0; i < edits; i++) {
+        const BenchPoint *view = &g_viewpoints[i % g_viewpoint_count];
+        field_update_fov_compact(&cached, dungeon, view->x, view->y);
+
+        // Half the edits land inside the FOV square, half up to three radii away
+        int reach = (i & 1) ? radius : radius * 3;
+        int x = view->x + rand() % (reach * 2 + 1) - reach;
+        int y = view->y + rand() % (reach * 2 + 1) - reach;
+        if (x <= 0 || y <= 0 || x >= dungeon->width - 1 || y >= dungeon->height - 1) continue;
+        TileType type = dungeon->tiles[x][y].type;
+        dungeon_set_tile_type(dungeon, x, y, type == TILE_TYPE_WALL ? TILE_TYPE_FLOOR : TILE_TYPE_WALL);
+
+        if (field_update_fov_compact(&cached, dungeon, view->x, view->y)) {
+            recomputes++;
+        } else {
+            hits++;
+        }
+        field_calculate_fov_compact(&fresh, dungeon, view->x, view->y);
+        if (!same_grid(&cached, &fresh)) {
+            fprintf(stderr, "Radius %d: cached FOV at (%d,%d) stale after edit at (%d,%d)\n",
+                    radius, view->x, view->y, x, y);
+            return false;
+        }
+    }
+
+    printf("  radius %2d  %u edits: %u recomputes, %u cache hits\n", radius, recomputes + hits, recomputes, hits);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t passes = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_PASSES;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_SEED;
+    if (passes == 0) passes = BENCH_DEFAULT_PASSES;
+
+    AppState *app_state = bench_app_init();
+    if (!app_state) return 1;
+    dungeon_init(&app_state->dungeon);
+    dungeon_generate_seeded(&app_state->dungeon, seed);
+    g_viewpoint_count = bench_room_centers(&app_state->dungeon, g_viewpoints, BENCH_VIEWPOINTS);
+    if (g_viewpoint_count == 0) {
+        fprintf(stderr, "Dungeon has no rooms\n");
+        return 1;
+    }
+
+    const int radii[] = {8, 16, FOV_MAX_RADIUS};
+    bool symmetric = true;
+    printf("FOV from %u room centers, seed %u, %u passes (grid %zu bytes, explored map %zu bytes)\n",
+           g_viewpoint_count, seed, passes, sizeof(CompactFieldOfView), sizeof(app_state->dungeon.explored));
+    for (size_t r = 0; r < sizeof(radii) / sizeof(radii[0]); r++) {
+        double ray_visible, shadow_visible;
+        double ray = run(field_calculate_fov_raycast, &app_state->dungeon, radii[r], passes, &ray_visible);
+        double shadow = run(field_calculate_fov_shadowcast, &app_state->dungeon, radii[r], passes, &shadow_visible);
+        bool same_both_ways = shadowcast_is_symmetric(&app_state->dungeon, radii[r]);
+        symmetric &= same_both_ways;
+
+        printf("  radius %2d  raycast: %8.2f us (%6.1f cells)  shadowcast: %8.2f us (%6.1f cells)  (%.1fx)  %s\n",
+               radii[r], ray / 1000.0, ray_visible, shadow / 1000.0, shadow_visible, ray / shadow,
+               same_both_ways ? "symmetric" : "ASYMMETRIC");
+    }
+
+    // Edits change the dungeon, so they come after the timings
+    bool cache_ok = true;
+    printf("Cached FOV after door edits at the FOV square edge\n");
+    for (size_t r = 0; r < sizeof(radii) / sizeof(radii[0]); r++) {
+        cache_ok &= door_edits_invalidate_by_box(&app_state->dungeon, radii[r]);
+    }
+    printf("Cached FOV after wall/floor edits\n");
+    for (size_t r = 0; r < sizeof(radii) / sizeof(radii[0]); r++) {
+        cache_ok &= cache_matches_after_edits(&app_state->dungeon, radii[r], 2000);
+    }
+
+    dungeon_cleanup(&app_state->dungeon);
+    bench_app_shutdown(app_state);
+    return symmetric && cache_ok ? 0 : 1;
+}
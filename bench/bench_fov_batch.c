@@ -0,0 +1,154 @@
+// Batched monster FOV benchmark
+// Places viewers on random floor tiles of a seeded dungeon and computes all their
+// fields of view each turn, first one at a time the way the player's FOV is done
+// (a CompactFieldOfView per viewer, shadowcasting against the tile array), then
+// through fov_batch_run on the shared opacity bitmap, on the calling thread and
+// split across a worker pool. Every viewer's visible set and can-see-player
+// answer is compared against the one-at-a-time result.
+//
+// Usage: bench_fov_batch [turns] [workers] [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "log.h"
+#include "appstate.h"
+#include "config.h"
+#include "dungeon.h"
+#include "field.h"
+#include "fov_batch.h"
+#include "thread_pool.h"
+
+#define BENCH_DEFAULT_TURNS 50
+#define BENCH_DEFAULT_WORKERS 4
+#define BENCH_DEFAULT_SEED 12345
+#define BENCH_MAX_VIEWERS 1024
+#define BENCH_RADIUS 8
+
+static BenchPoint g_spots[BENCH_MAX_VIEWERS];
+static CompactFieldOfView g_single[BENCH_MAX_VIEWERS];
+static BenchPoint g_player;
+
+// Monsters gather around the player in a real game; every fourth one is placed
+// within two radii of the player, the rest anywhere
+static void place_viewers(const Dungeon *dungeon, uint32_t count) {
+    g_player = bench_random_floor(dungeon);
+    for (uint32_t i = 0; i < count; i++) {
+        BenchPoint spot = bench_random_floor(dungeon);
+        for (int attempt = 0; (i % 4) == 0 && attempt < 256; attempt++) {
+            BenchPoint near = {g_player.x + rand() % (4 * BENCH_RADIUS + 1) - 2 * BENCH_RADIUS,
+                         g_player.y + rand() % (4 * BENCH_RADIUS + 1) - 2 * BENCH_RADIUS};
+            if (near.x >= 0 && near.x < DUNGEON_WIDTH && near.y >= 0 && near.y < DUNGEON_HEIGHT &&
+                !dungeon_tile_blocks_sight(dungeon->tiles[near.x][near.y].type)) {
+                spot = near;
+                break;
+            }
+        }
+        g_spots[i] = spot;
+    }
+}
+
+static double run_single(Dungeon *dungeon, uint32_t count, uint32_t turns) {
+    double start = bench_now_ns();
+    for (uint32_t turn = 0; turn < turns; turn++) {
+        for (uint32_t i = 0; i < count; i++) {
+            field_calculate_fov_shadowcast(&g_single[i], dungeon, g_spots[i].x, g_spots[i].y);
+        }
+    }
+    return (bench_now_ns() - start) / turns;
+}
+
+static double run_batch(FovBatch *batch, const Dungeon *dungeon, ThreadPool *workers, uint32_t count,
+                        uint32_t turns, FovBatchMode mode) {
+    double start = bench_now_ns();
+    for (uint32_t turn = 0; turn < turns; turn++) {
+        fov_batch_clear(batch);
+        for (uint32_t i = 0; i < count; i++) {
+            fov_batch_add(batch, (Entity)i, g_spots[i].x, g_spots[i].y, BENCH_RADIUS);
+        }
+        fov_batch_run(batch, dungeon, workers, g_player.x, g_player.y, mode);
+    }
+    return (bench_now_ns() - start) / turns;
+}
+
+// Full batch results against the single-viewer grids
+static bool batch_matches(const FovBatch *batch, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        const CompactFieldOfView *single = &g_single[i];
+        for (int dx = -BENCH_RADIUS; dx <= BENCH_RADIUS; dx++) {
+            for (int dy = -BENCH_RADIUS; dy <= BENCH_RADIUS; dy++) {
+                int x = g_spots[i].x + dx;
+                int y = g_spots[i].y + dy;
+                bool expected = field_is_visible_compact((CompactFieldOfView *)single, x, y);
+                if (fov_batch_is_visible(batch, i, x, y) != expected) {
+                    fprintf(stderr, "Viewer %u at (%d,%d) differs at (%d,%d)\n", i, g_spots[i].x, g_spots[i].y, x, y);
+                    return false;
+                }
+            }
+        }
+        bool sees_player = field_is_visible_compact((CompactFieldOfView *)single, g_player.x, g_player.y);
+        if (fov_batch_can_see_player(batch, i) != sees_player) {
+            fprintf(stderr, "Viewer %u can-see-player differs\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t turns = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_TURNS;
+    uint32_t worker_count = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_WORKERS;
+    uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : BENCH_DEFAULT_SEED;
+    if (turns == 0) turns = BENCH_DEFAULT_TURNS;
+    if (worker_count > THREAD_POOL_MAX_WORKERS) worker_count = THREAD_POOL_MAX_WORKERS;
+
+    AppState *app_state = bench_app_init();
+    if (!app_state) return 1;
+    dungeon_init(&app_state->dungeon);
+    dungeon_generate_seeded(&app_state->dungeon, seed);
+    srand(seed);
+
+    ThreadPool *workers = worker_count > 0 ? thread_pool_create(worker_count) : NULL;
+    FovBatch *batch = malloc(sizeof(FovBatch));
+    if (!batch || !fov_batch_init(batch, BENCH_MAX_VIEWERS) || (worker_count > 0 && !workers)) {
+        fprintf(stderr, "Failed to set up benchmark\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < BENCH_MAX_VIEWERS; i++) {
+        field_init_compact(&g_single[i], BENCH_RADIUS);
+    }
+
+    const uint32_t viewer_counts[] = {64, 256, BENCH_MAX_VIEWERS};
+    bool match = true;
+    printf("FOV radius %d, %u turns, seed %u, %u workers\n", BENCH_RADIUS, turns, seed, worker_count);
+    for (size_t c = 0; c < sizeof(viewer_counts) / sizeof(viewer_counts[0]); c++) {
+        uint32_t count = viewer_counts[c];
+        place_viewers(&app_state->dungeon, count);
+
+        double single = run_single(&app_state->dungeon, count, turns);
+        double inline_batch = run_batch(batch, &app_state->dungeon, NULL, count, turns, FOV_BATCH_FULL);
+        bool same = batch_matches(batch, count);
+        double pooled = run_batch(batch, &app_state->dungeon, workers, count, turns, FOV_BATCH_FULL);
+        same &= batch_matches(batch, count);
+        double player_only = run_batch(batch, &app_state->dungeon, workers, count, turns, FOV_BATCH_PLAYER_ONLY);
+        uint32_t in_reach = batch->cast_count;
+        uint32_t seeing = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            seeing += fov_batch_can_see_player(batch, i);
+        }
+        match &= same;
+
+        printf("  %4u viewers  one at a time: %8.1f us  batch: %8.1f us  pool: %8.1f us  "
+               "player only: %8.1f us (%u cast, %u see the player)  %s\n",
+               count, single / 1000.0, inline_batch / 1000.0, pooled / 1000.0, player_only / 1000.0,
+               in_reach, seeing, same ? "identical" : "DIFFERS");
+    }
+
+    fov_batch_cleanup(batch);
+    free(batch);
+    thread_pool_destroy(workers);
+    dungeon_cleanup(&app_state->dungeon);
+    bench_app_shutdown(app_state);
+    return match ? 0 : 1;
+}
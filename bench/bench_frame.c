@@ -0,0 +1,227 @@
+// Full frame benchmark
+// Runs the real game systems (input, action, render with FOV) headless: a
+// software renderer into an offscreen surface, a seeded dungeon, N spawned
+// enemies and a fixed input script that walks the player around. Reports
+// frames/sec, per-system and per-section timings, cells redrawn and memory
+// pool allocations, so render, FOV and ECS iteration regressions show up
+// here before they ship.
+//
+// Usage: bench_frame [frames] [entities] [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "bench_common.h"
+#include "log.h"
+#include "appstate.h"
+#include "config.h"
+#include "mempool.h"
+#include "ecs.h"
+#include "components.h"
+#include "dungeon.h"
+#include "field.h"
+#include "messages.h"
+#include "messageview.h"
+#include "playerview.h"
+#include "statusview.h"
+#include "profiler.h"
+#include "render_system.h"
+#include "input_system.h"
+#include "action_system.h"
+#include "template_system.h"
+
+#define BENCH_DEFAULT_FRAMES 500
+#define BENCH_DEFAULT_ENTITIES 200
+#define BENCH_DEFAULT_SEED 12345
+#define BENCH_WARMUP_FRAMES 10
+
+// Walks a square; a blank frame between steps mirrors key press/release
+static const Direction BENCH_SCRIPT[] = {
+    DIRECTION_RIGHT, DIRECTION_RIGHT, DIRECTION_RIGHT, DIRECTION_RIGHT,
+    DIRECTION_DOWN, DIRECTION_DOWN, DIRECTION_DOWN, DIRECTION_DOWN,
+    DIRECTION_LEFT, DIRECTION_LEFT, DIRECTION_LEFT, DIRECTION_LEFT,
+    DIRECTION_UP, DIRECTION_UP, DIRECTION_UP, DIRECTION_UP
+};
+#define BENCH_SCRIPT_LENGTH (sizeof(BENCH_SCRIPT) / sizeof(BENCH_SCRIPT[0]))
+
+// Independent of rand() so spawning does not perturb dungeon generation
+static uint32_t bench_random(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static bool bench_init(AppState *app_state) {
+    ecs_init(app_state);
+    profiler_init(app_state);
+    if (!render_system_init(app_state)) {
+        return false;
+    }
+
+    playerview_init();
+    statusview_init();
+    messages_init(app_state);
+    messageview_init(app_state);
+
+    input_system_init();
+    input_system_register();
+    action_system_init();
+    action_system_register();
+    render_system_register();
+
+    return template_system_init() == 0 && load_templates_from_file("data.json") == 0;
+}
+
+static void bench_cleanup(AppState *app_state) {
+    template_system_cleanup();
+    profiler_cleanup(app_state);
+    ecs_shutdown(app_state);
+    playerview_cleanup();
+    statusview_cleanup();
+    messageview_cleanup(app_state);
+    render_system_cleanup(app_state);
+    messages_shutdown(app_state);
+}
+
+// Seeded dungeon, player at the up stairs, enemies on random free floor tiles
+static uint32_t bench_build_world(AppState *app_state, uint32_t entity_count, uint32_t seed) {
+    dungeon_init(&app_state->dungeon);
+    dungeon_generate_seeded(&app_state->dungeon, seed);
+
+    app_state->player = create_entity_from_template("player");
+    if (app_state->player == INVALID_ENTITY) return 0;
+
+    CompactFieldOfView player_fov;
+    field_init_compact(&player_fov, (int)app_state->config.fov.radius);
+    player_fov.algorithm = app_state->config.fov.algorithm;
+    ECS_ADD(app_state, app_state->player, FieldOfView, &player_fov);
+
+    Position *player_pos = ECS_GET(app_state, app_state->player, Position);
+    if (player_pos) {
+        player_pos->x = (float)app_state->dungeon.stairs_up_x;
+        player_pos->y = (float)app_state->dungeon.stairs_up_y;
+        dungeon_place_entity_at_position(&app_state->dungeon, app_state->player,
+                                         app_state->dungeon.stairs_up_x, app_state->dungeon.stairs_up_y);
+    }
+
+    uint32_t rng = seed;
+    uint32_t spawned = 0;
+    for (uint32_t attempt = 0; spawned < entity_count && attempt < entity_count * 64; attempt++) {
+        int x = (int)(bench_random(&rng) % DUNGEON_WIDTH);
+        int y = (int)(bench_random(&rng) % DUNGEON_HEIGHT);
+        Tile *tile = dungeon_get_tile(&app_state->dungeon, x, y);
+        if (!tile || !dungeon_is_walkable(&app_state->dungeon, x, y) || tile->actor != INVALID_ENTITY) {
+            continue;
+        }
+
+        Entity enemy = create_entity_from_template("enemy");
+        if (enemy == INVALID_ENTITY) break;
+
+        Position *pos = ECS_GET(app_state, enemy, Position);
+        if (pos) {
+            pos->x = (float)x;
+            pos->y = (float)y;
+            dungeon_place_entity_at_position(&app_state->dungeon, enemy, x, y);
+        }
+        spawned++;
+    }
+    return spawned;
+}
+
+static void bench_run_frames(AppState *app_state, uint32_t frames, uint32_t *script_step) {
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        if (frame % 2 == 0) {
+            input_system_queue_action(ACTION_MOVE, BENCH_SCRIPT[*script_step % BENCH_SCRIPT_LENGTH]);
+            (*script_step)++;
+        }
+        profiler_frame_begin(app_state);
+        system_run_all(app_state);
+        profiler_frame_end(app_state);
+    }
+}
+
+static void bench_report(AppState *app_state, uint32_t frames, double elapsed_ns,
+                         uint64_t allocations, uint64_t bytes) {
+    double seconds = elapsed_ns / 1e9;
+    ProfilerStats frame = profiler_get_frame_stats(app_state);
+    printf("%u frames in %.3f s: %.1f frames/sec  (frame avg %.1f us, p99 %.1f us)\n",
+           frames, seconds, frames / seconds, frame.avg_us, frame.p99_us);
+
+    printf("  %-16s %10s %10s %10s\n", "system", "avg us", "p99 us", "entities");
+    for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+        const System *system = &app_state->ecs.systems.systems[i];
+        if (!system->profile) continue;
+
+        ProfilerStats total = profiler_ring_stats(&system->profile->total);
+        printf("  %-16s %10.1f %10.1f %10u\n", system->name, total.avg_us, total.p99_us,
+               system->profile->last_entities);
+    }
+
+    const char *sections[] = {"FOV", "Background", "Entities", "Composite", "Draw cells"};
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        ProfilerStats stats;
+        if (profiler_get_section_stats(app_state, sections[i], &stats)) {
+            printf("  %-16s %10.1f %10.1f\n", sections[i], stats.avg_us, stats.p99_us);
+        }
+    }
+
+    ProfilerStats redrawn;
+    if (profiler_get_counter_stats(app_state, "Cells redrawn", &redrawn)) {
+        printf("  cells redrawn/frame: avg %.1f, p99 %.0f\n", redrawn.avg_us, redrawn.p99_us);
+    }
+
+    printf("  FOV: %llu recomputes, %llu cache hits\n",
+           (unsigned long long)app_state->render.fov_recomputes, (unsigned long long)app_state->render.fov_cache_hits);
+
+    printf("  pool allocations: %llu (%.2f/frame, %llu bytes), fallbacks %u, peak %llu bytes\n",
+           (unsigned long long)allocations, (double)allocations / frames, (unsigned long long)bytes,
+           app_state->mempool.fallback_allocations, (unsigned long long)app_state->mempool.peak_memory_usage);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_FRAMES;
+    uint32_t entity_count = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_ENTITIES;
+    uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : BENCH_DEFAULT_SEED;
+    if (frames == 0) frames = BENCH_DEFAULT_FRAMES;
+
+    AppState *app_state = bench_app_init();
+    if (!app_state) return 1;
+    if (!config_load_from_file("adv_config.json", app_state)) {
+        fprintf(stderr, "adv_config.json not loaded, using defaults\n");
+    }
+    app_state->config.render.headless = true;
+    app_state->config.profiler.enabled = true;
+    app_state->config.profiler.dump_path[0] = '\0';
+    app_state->config.dungeon.seed = seed;
+
+    if (!bench_mempool_init(app_state)) return 1;
+
+    if (!bench_init(app_state)) {
+        fprintf(stderr, "Failed to initialize game systems headless\n");
+        return 1;
+    }
+
+    uint32_t spawned = bench_build_world(app_state, entity_count, seed);
+    if (app_state->player == INVALID_ENTITY) {
+        fprintf(stderr, "Failed to create player from templates\n");
+        return 1;
+    }
+    appstate_set_state(APP_STATE_PLAYING);
+
+    printf("Headless frame benchmark: seed %u, %u enemies, %u rooms, %u frames\n",
+           seed, spawned, app_state->dungeon.room_count, frames);
+
+    uint32_t script_step = 0;
+    bench_run_frames(app_state, BENCH_WARMUP_FRAMES, &script_step);
+
+    uint64_t allocations_before = app_state->mempool.total_allocations;
+    uint64_t bytes_before = app_state->mempool.bytes_allocated;
+    double start = bench_now_ns();
+    bench_run_frames(app_state, frames, &script_step);
+    double elapsed = bench_now_ns() - start;
+
+    bench_report(app_state, frames, elapsed, app_state->mempool.total_allocations - allocations_before,
+                 app_state->mempool.bytes_allocated - bytes_before);
+
+    bench_cleanup(app_state);
+    bench_app_shutdown(app_state);
+    return 0;
+}
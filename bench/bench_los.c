@@ -0,0 +1,130 @@
+// Line of sight query benchmark
+// Answers "can A see B" for random floor-to-floor pairs of a seeded dungeon three
+// ways: a full shadowcast FOV from A tested at B (the only option before), one
+// field_has_los call per pair walking a precomputed Bresenham line over the
+// opacity bitmap, and field_has_los_batch testing many targets from one origin.
+// Single and batched answers must agree; agreement with the FOV is reported, as
+// a Bresenham line and shadowcasting disagree on some grazing corners.
+//
+// Usage: bench_los [origins] [targets per origin] [seed]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "log.h"
+#include "appstate.h"
+#include "config.h"
+#include "dungeon.h"
+#include "field.h"
+
+#define BENCH_DEFAULT_ORIGINS 2000
+#define BENCH_DEFAULT_TARGETS 64
+#define BENCH_DEFAULT_SEED 12345
+#define BENCH_RANGE 16
+
+static bool is_floor(const Dungeon *dungeon, int x, int y) {
+    return x >= 0 && x < DUNGEON_WIDTH && y >= 0 && y < DUNGEON_HEIGHT &&
+           !dungeon_tile_blocks_sight(dungeon->tiles[x][y].type);
+}
+
+// Floor origins, each with floor targets within BENCH_RANGE on both axes
+static void pick_queries(const Dungeon *dungeon, LosTarget *origins, uint32_t origin_count,
+                         LosTarget *targets, uint32_t target_count) {
+    for (uint32_t o = 0; o < origin_count; o++) {
+        BenchPoint origin = bench_random_floor(dungeon);
+        origins[o] = (LosTarget){origin.x, origin.y};
+
+        for (uint32_t t = 0; t < target_count; t++) {
+            LosTarget *target = &targets[(size_t)o * target_count + t];
+            do {
+                target->x = origins[o].x + rand() % (2 * BENCH_RANGE + 1) - BENCH_RANGE;
+                target->y = origins[o].y + rand() % (2 * BENCH_RANGE + 1) - BENCH_RANGE;
+            } while (!is_floor(dungeon, target->x, target->y));
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t origin_count = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_ORIGINS;
+    uint32_t target_count = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_TARGETS;
+    uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : BENCH_DEFAULT_SEED;
+    if (origin_count == 0) origin_count = BENCH_DEFAULT_ORIGINS;
+    if (target_count == 0) target_count = BENCH_DEFAULT_TARGETS;
+
+    AppState *app_state = bench_app_init();
+    if (!app_state) return 1;
+    dungeon_init(&app_state->dungeon);
+    dungeon_generate_seeded(&app_state->dungeon, seed);
+    srand(seed);
+
+    size_t query_count = (size_t)origin_count * target_count;
+    LosTarget *origins = malloc(origin_count * sizeof(LosTarget));
+    LosTarget *targets = malloc(query_count * sizeof(LosTarget));
+    bool *fov_answers = malloc(query_count * sizeof(bool));
+    bool *single_answers = malloc(query_count * sizeof(bool));
+    bool *batch_answers = malloc(query_count * sizeof(bool));
+    FovOpacityMap *opacity = calloc(1, sizeof(FovOpacityMap));
+    if (!origins || !targets || !fov_answers || !single_answers || !batch_answers || !opacity) {
+        fprintf(stderr, "Failed to allocate %zu queries\n", query_count);
+        return 1;
+    }
+    pick_queries(&app_state->dungeon, origins, origin_count, targets, target_count);
+
+    double start = bench_now_ns();
+    field_opacity_map_update(opacity, &app_state->dungeon);
+    field_los_init();
+    double setup = bench_now_ns() - start;
+
+    // Full FOV per query; the radius reaches the corners of the query square
+    CompactFieldOfView fov;
+    field_init_compact(&fov, BENCH_RANGE * 3 / 2);
+    start = bench_now_ns();
+    for (size_t q = 0; q < query_count; q++) {
+        const LosTarget *origin = &origins[q / target_count];
+        field_calculate_fov_shadowcast(&fov, &app_state->dungeon, origin->x, origin->y);
+        fov_answers[q] = field_is_visible_compact(&fov, targets[q].x, targets[q].y);
+    }
+    double fov_ns = (bench_now_ns() - start) / query_count;
+
+    start = bench_now_ns();
+    for (size_t q = 0; q < query_count; q++) {
+        const LosTarget *origin = &origins[q / target_count];
+        single_answers[q] = field_has_los(opacity, origin->x, origin->y, targets[q].x, targets[q].y);
+    }
+    double single_ns = (bench_now_ns() - start) / query_count;
+
+    uint32_t visible = 0;
+    start = bench_now_ns();
+    for (uint32_t o = 0; o < origin_count; o++) {
+        size_t first = (size_t)o * target_count;
+        visible += field_has_los_batch(opacity, origins[o].x, origins[o].y, &targets[first], target_count,
+                                       &batch_answers[first]);
+    }
+    double batch_ns = (bench_now_ns() - start) / query_count;
+
+    size_t agree = 0;
+    for (size_t q = 0; q < query_count; q++) {
+        agree += fov_answers[q] == single_answers[q];
+    }
+    bool match = memcmp(single_answers, batch_answers, query_count * sizeof(bool)) == 0;
+
+    printf("Line of sight, %zu queries within %d tiles (%u origins x %u targets), seed %u\n",
+           query_count, BENCH_RANGE, origin_count, target_count, seed);
+    printf("  opacity map + line tables:  %8.1f us once\n", setup / 1000.0);
+    printf("  full FOV per query:         %8.1f ns/query\n", fov_ns);
+    printf("  field_has_los:              %8.1f ns/query  (%.0fx)\n", single_ns, fov_ns / single_ns);
+    printf("  field_has_los_batch:        %8.1f ns/query  (%.0fx)\n", batch_ns, fov_ns / batch_ns);
+    printf("  %u visible, FOV agrees on %.2f%%, batch %s\n", visible, 100.0 * agree / query_count,
+           match ? "identical" : "DIFFERS");
+
+    free(origins);
+    free(targets);
+    free(fov_answers);
+    free(single_answers);
+    free(batch_answers);
+    free(opacity);
+    dungeon_cleanup(&app_state->dungeon);
+    bench_app_shutdown(app_state);
+    return match ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+// Z-buffer layout benchmark
+// Compares the previous two-layer z-buffer (3-byte {char, color, has_content}
+// cells, both layers memset every frame and resolved with a has_content check
+// per layer) against the packed ZBuffer: 4-byte cells, only written layers
+// cleared, and one blocked composite over the written layers. Each frame
+// rewrites the whole background and scatters a few entities, like the render
+// pre-update, at the default viewport, a 200x100 overview and that overview
+// zoomed out. Composited output is compared so both layouts are checked to
+// agree.
+//
+// Usage: bench_zbuffer [frames] [entities]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_common.h"
+#include "zbuffer.h"
+
+#define BENCH_DEFAULT_FRAMES 2000
+#define BENCH_DEFAULT_ENTITIES 64
+
+typedef struct {
+    char character;
+    uint8_t color;
+    bool has_content;
+} LegacyCell;
+
+typedef struct {
+    int width, height;
+    const char *name;
+} Viewport;
+
+// Deterministic scene: mostly floor with walls, unexplored bands and entities moving per
+// frame. Tiles are generated once so the timed loops only move cells, like the compositor.
+static char scene_glyph(size_t index) { return (index % 7) == 0 ? '#' : '.'; }
+static bool scene_empty(size_t index) { return (index / 97) % 5 == 0; }
+static size_t scene_entity(uint32_t frame, uint32_t i, size_t cells) {
+    return ((size_t)i * 2654435761u + frame * 31u) % cells;
+}
+
+static double run_legacy(const Viewport *view, uint32_t frames, uint32_t entities, ZBufferCell *result) {
+    size_t cells = (size_t)view->width * (size_t)view->height;
+    LegacyCell *background = calloc(cells, sizeof(LegacyCell));
+    LegacyCell *entity_layer = calloc(cells, sizeof(LegacyCell));
+    LegacyCell *out = calloc(cells, sizeof(LegacyCell));
+    LegacyCell *tiles = calloc(cells, sizeof(LegacyCell));
+    for (size_t i = 0; i < cells; i++) {
+        if (!scene_empty(i)) tiles[i] = (LegacyCell){scene_glyph(i), 0x07, true};
+    }
+
+    double start = bench_now_ns();
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        memset(entity_layer, 0, cells * sizeof(LegacyCell));
+        memset(background, 0, cells * sizeof(LegacyCell));
+        for (size_t i = 0; i < cells; i++) {
+            if (tiles[i].has_content) background[i] = tiles[i];
+        }
+        for (uint32_t i = 0; i < entities; i++) {
+            entity_layer[scene_entity(frame, i, cells)] = (LegacyCell){'g', 0x02, true};
+        }
+        for (size_t i = 0; i < cells; i++) {
+            if (entity_layer[i].has_content) {
+                out[i] = entity_layer[i];
+            } else if (background[i].has_content) {
+                out[i] = background[i];
+            } else {
+                out[i] = (LegacyCell){0, 0, false};
+            }
+        }
+    }
+    double elapsed = bench_now_ns() - start;
+
+    for (size_t i = 0; i < cells; i++) {
+        result[i] = out[i].has_content ? zcell_pack(out[i].character, out[i].color, 0, RENDER_LAYER_BACKGROUND) : ZCELL_EMPTY;
+    }
+    free(tiles);
+    free(background);
+    free(entity_layer);
+    free(out);
+    return elapsed / frames;
+}
+
+static double run_packed(const Viewport *view, uint32_t frames, uint32_t entities, ZBufferCell *result) {
+    size_t cells = (size_t)view->width * (size_t)view->height;
+    ZBuffer zbuffer;
+    if (!zbuffer_init(&zbuffer, (uint32_t)cells)) return 0;
+    ZBufferCell *out = calloc(cells, sizeof(ZBufferCell));
+    ZBufferCell *tiles = calloc(cells, sizeof(ZBufferCell));
+    for (size_t i = 0; i < cells; i++) {
+        if (!scene_empty(i)) tiles[i] = zcell_pack(scene_glyph(i), 0x07, 0, RENDER_LAYER_BACKGROUND);
+    }
+
+    double start = bench_now_ns();
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        zbuffer_clear(&zbuffer, ZBUFFER_LAYER_BIT(RENDER_LAYER_BACKGROUND));
+        ZBufferCell *background = zbuffer_layer(&zbuffer, RENDER_LAYER_BACKGROUND);
+        for (size_t i = 0; i < cells; i++) {
+            background[i] = tiles[i];
+        }
+        ZBufferCell *actors = zbuffer_layer(&zbuffer, RENDER_LAYER_ACTORS);
+        for (uint32_t i = 0; i < entities; i++) {
+            actors[scene_entity(frame, i, cells)] = zcell_pack('g', 0x02, 0, RENDER_LAYER_ACTORS);
+        }
+        zbuffer_composite(&zbuffer, out);
+    }
+    double elapsed = bench_now_ns() - start;
+
+    // Compare glyph and color only; the layer bits differ by design
+    for (size_t i = 0; i < cells; i++) {
+        result[i] = out[i] ? zcell_pack(zcell_glyph(out[i]), zcell_fg(out[i]), 0, RENDER_LAYER_BACKGROUND) : ZCELL_EMPTY;
+    }
+    zbuffer_free(&zbuffer);
+    free(tiles);
+    free(out);
+    return elapsed / frames;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t frames = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : BENCH_DEFAULT_FRAMES;
+    uint32_t entities = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_ENTITIES;
+    if (frames == 0) frames = BENCH_DEFAULT_FRAMES;
+
+    const Viewport views[] = {
+        {48, 30, "default"},
+        {200, 100, "overview"},
+        {400, 200, "overview at 8px"}
+    };
+
+    bool match = true;
+    printf("Z-buffer clear + layer + composite, %u entities, %u frames\n", entities, frames);
+    for (size_t v = 0; v < sizeof(views) / sizeof(views[0]); v++) {
+        size_t cells = (size_t)views[v].width * (size_t)views[v].height;
+        ZBufferCell *legacy_out = calloc(cells, sizeof(ZBufferCell));
+        ZBufferCell *packed_out = calloc(cells, sizeof(ZBufferCell));
+        if (!legacy_out || !packed_out) {
+            fprintf(stderr, "Failed to allocate %zu cells\n", cells);
+            return 1;
+        }
+
+        double legacy = run_legacy(&views[v], frames, entities, legacy_out);
+        double packed = run_packed(&views[v], frames, entities, packed_out);
+        bool same = memcmp(legacy_out, packed_out, cells * sizeof(ZBufferCell)) == 0;
+        match &= same;
+
+        printf("  %-16s %3dx%-3d  two 3-byte layers: %8.2f us  packed layers: %8.2f us  (%.1fx)  %s\n",
+               views[v].name, views[v].width, views[v].height, legacy / 1000.0, packed / 1000.0,
+               legacy / packed, same ? "identical" : "DIFFERS");
+        free(legacy_out);
+        free(packed_out);
+    }
+    return match ? 0 : 1;
+}
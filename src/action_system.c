@@ -4,6 +4,7 @@
 #include "log.h"
 #include "dungeon.h"
 #include "components.h"
+#include "ecs_commands.h"
 #include "messages.h"
 #include <stdio.h>
 
@@ -11,24 +12,42 @@ void pickup_item(Entity entity, Entity item) {
     AppState *app_state = appstate_get();
     if (!app_state) return;
     
-    // add the item to the actor's inventory
-    Inventory *inventory = (Inventory *)entity_get_component(app_state, entity, component_get_id(app_state, "Inventory"));
+    // Reject stale handles - either side may have been destroyed and its slot recycled
+    if (!entity_exists(app_state, entity) || !entity_exists(app_state, item)) {
+        LOG_WARN("pickup_item called with stale entity handle (%u, %u)", entity, item);
+        return;
+    }
+    
+    // The inventory and the item's position change through the command buffer, since
+    // the action system may run on a pool worker; both land at the next flush. Only the
+    // carrier's own action picks up, so one pickup per carrier is pending at a time.
+    Inventory *inventory = ECS_GET(app_state, entity, Inventory);
     if (inventory) {
-        inventory->items[inventory->item_count++] = item;
+        uint8_t capacity = inventory->max_items < MAX_INVENTORY_ITEMS ? inventory->max_items : MAX_INVENTORY_ITEMS;
+        if (inventory->item_count >= capacity) {
+            messages_add(app_state, "Your pack is full.");
+            return;
+        }
+        
+        Inventory updated = *inventory;
+        updated.items[updated.item_count++] = item;
+        ECS_CMD_SET(app_state, entity, Inventory, &updated);
     }
 
     // remove the item from the tile
-    Position *position_item = (Position *)entity_get_component(app_state, item, component_get_id(app_state, "Position"));
+    Position *position_item = ECS_GET(app_state, item, Position);
     if (position_item) {
         // Remove item from its current tile position
         dungeon_remove_entity_from_position(&app_state->dungeon, item, position_item->x, position_item->y);
         
         // Set position to indicate it's in inventory
-        position_item->entity = entity;
+        Position carried = *position_item;
+        carried.entity = entity;
+        ECS_CMD_SET(app_state, item, Position, &carried);
     }
     
     // Print pickup message
-    BaseInfo *item_info = (BaseInfo *)entity_get_component(app_state, item, component_get_id(app_state, "BaseInfo"));
+    BaseInfo *item_info = ECS_GET(app_state, item, BaseInfo);
     if (item_info) {
         char pickup_message[256];
         snprintf(pickup_message, sizeof(pickup_message), "You picked up: %s", item_info->name);
@@ -38,7 +57,7 @@ void pickup_item(Entity entity, Entity item) {
 }
 
 void action_move_entity(Entity entity, Direction direction, AppState *app_state) {
-    Position *position = (Position *)entity_get_component(app_state, entity, component_get_id(app_state, "Position"));
+    Position *position = ECS_GET(app_state, entity, Position);
     if (!position || !app_state) {
         return;
     }
@@ -66,6 +85,17 @@ void action_move_entity(Entity entity, Direction direction, AppState *app_state)
             return; // No movement
     }
 
+    // Walking into a closed door opens it and uses up the move; the edit lets cached
+    // FOVs that cover the door know it stopped blocking sight
+    Tile *target = dungeon_get_tile(&app_state->dungeon, new_x, new_y);
+    if (target && target->type == TILE_TYPE_DOOR_CLOSED) {
+        dungeon_set_tile_type(&app_state->dungeon, new_x, new_y, TILE_TYPE_DOOR);
+        if (entity == app_state->player) {
+            messages_add(app_state, "You open the door.");
+        }
+        return;
+    }
+
     // Check if the new position is walkable
     if (dungeon_is_walkable(&app_state->dungeon, new_x, new_y)) {
         // Remove entity from old tile position
@@ -76,7 +106,7 @@ void action_move_entity(Entity entity, Direction direction, AppState *app_state)
         position->y = new_y;
         
         // Mark entity as moved using flags in BaseInfo
-        BaseInfo *base_info = (BaseInfo *)entity_get_component(app_state, entity, component_get_id(app_state, "BaseInfo"));
+        BaseInfo *base_info = ECS_GET(app_state, entity, BaseInfo);
         if (base_info) {
             ENTITY_SET_FLAG(base_info->flags, ENTITY_FLAG_MOVED);
         }
@@ -104,7 +134,7 @@ void action_quit(void) {
 }
 
 void action_system(Entity entity, AppState *app_state) {
-    Action *action = (Action *)entity_get_component(app_state, entity, component_get_id(app_state, "Action"));
+    Action *action = ECS_GET(app_state, entity, Action);
 
     switch (action->type) {
         case ACTION_MOVE:
@@ -125,7 +155,7 @@ void action_system_register(void) {
         return;
     }
     
-    uint32_t component_mask = (1 << component_get_id(app_state, "Action")) | (1 << component_get_id(app_state, "Position"));
+    uint32_t component_mask = COMPONENT_BIT(Action) | COMPONENT_BIT(Position);
     
     // Action system depends on input system and should run early
     static const char* dependencies[] = {"InputSystem", NULL};
@@ -137,7 +167,13 @@ void action_system_register(void) {
         .pre_update = NULL,
         .post_update = NULL,
         .priority = SYSTEM_PRIORITY_EARLY,
-        .dependencies = dependencies
+        .dependencies = dependencies,
+        // Moves read item BaseInfo flags and fill the mover's Inventory. Tiles (slots and
+        // opened doors) and the message log aren't components; the systems before and after this one
+        // are main-thread systems, so nothing else touches them while it runs.
+        .read_mask = component_mask | COMPONENT_BIT(BaseInfo) | COMPONENT_BIT(Inventory),
+        .write_mask = COMPONENT_BIT(Position) | COMPONENT_BIT(BaseInfo) | COMPONENT_BIT(Inventory),
+        .threading = SYSTEM_THREADING_WORKER
     };
     
     if (system_register(app_state, &config)) {
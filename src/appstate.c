@@ -31,6 +31,8 @@ bool appstate_init(void) {
     g_appstate->current_state = APP_STATE_MENU;
     g_appstate->player = INVALID_ENTITY;
     g_appstate->error_counter = 0;
+    g_appstate->main_thread = SDL_ThreadID();
+    g_appstate->error_tls = SDL_TLSCreate();
     
     // Initialize ECS state
     g_appstate->ecs.initialized = false;
@@ -51,10 +53,11 @@ bool appstate_init(void) {
     g_appstate->render.font_medium = NULL;
     g_appstate->render.font_large = NULL;
     g_appstate->render.initialized = false;
-    g_appstate->render.z_buffer_0 = NULL;
-    g_appstate->render.z_buffer_1 = NULL;
+    memset(&g_appstate->render.z_buffer, 0, sizeof(ZBuffer));
     g_appstate->render.viewport_x = 0;
     g_appstate->render.viewport_y = 0;
+    g_appstate->render.fov_recomputes = 0;
+    g_appstate->render.fov_cache_hits = 0;
     
     // Initialize message view state
     g_appstate->message_view.window = NULL;
@@ -13,6 +13,12 @@
 #include "field.h"
 #include "mempool.h"
 #include "config.h"
+#include "profiler.h"
+#include "glyph_atlas.h"
+#include "text_cache.h"
+#include "zbuffer.h"
+#include "map_build_thread.h"
+#include "frame_scheduler.h"
 
 // Forward declarations
 struct ComponentHashEntry;
@@ -48,6 +54,13 @@ typedef enum {
     SYSTEM_PRIORITY_LAST = 400      // Must run last (e.g., rendering)
 } SystemPriority;
 
+// Where a system may execute when ecs.worker_threads > 0
+typedef enum {
+    SYSTEM_THREADING_MAIN = 0,      // Main thread only, never alongside another system (SDL, global state)
+    SYSTEM_THREADING_WORKER,        // On a worker, concurrently with systems it doesn't conflict with
+    SYSTEM_THREADING_PARALLEL       // As WORKER, with its entities split into chunks across workers
+} SystemThreading;
+
 // System function pointer types (avoiding circular dependency)
 typedef void (*SystemFunction)(Entity entity, struct AppState *app_state);
 typedef void (*SystemPreUpdateFunction)(struct AppState *app_state);
@@ -70,16 +83,36 @@ typedef struct {
     bool enabled;
     uint32_t execution_order;  // Calculated execution order after sorting
     
+    // Scheduling
+    uint32_t read_mask;        // Components the system reads
+    uint32_t write_mask;       // Components the system writes
+    SystemThreading threading;
+    uint32_t level;            // DAG level; systems sharing a level never conflict
+    
     // Performance tracking
     uint32_t execution_count;
-    float total_execution_time;
+    float total_execution_time;     // Milliseconds across all runs, accumulated while profiling
+    struct SystemProfile *profile;  // Rolling per-phase timings (profiler.h)
+    
+    // Cached query for sparse storage: alive entities whose mask contains component_mask
+    Entity *query_entities;         // Dense list of matching entities (room for holes mid-walk)
+    uint32_t *query_sparse;         // Entity slot -> index in query_entities (UINT32_MAX if absent)
+    uint32_t query_count;
+    uint32_t query_walk_end;        // Entries a running walk will visit; erases there leave holes
+    uint32_t query_holes;
+    
+    // Cached query for archetype storage: indices of matching archetypes. A run
+    // snapshots their rows into query_entities before calling the system.
+    uint32_t *query_archetypes;
+    uint32_t query_archetype_count;
+    uint32_t query_archetypes_scanned; // Archetypes examined so far; new ones are checked lazily
 } System;
 
 // Sparse component array definition (simplified for now)
 typedef struct SparseComponentArray {
     uint32_t *sparse;           // Entity -> dense index mapping (size: MAX_ENTITIES)
     uint32_t *dense_entities;   // Dense array of entity IDs that have this component
-    void **dense_components;    // Dense array of component data
+    uint8_t *dense_data;        // Packed component bytes, slot i at i * component_size
     uint32_t count;             // Number of components currently stored
     uint32_t capacity;          // Current capacity of dense arrays
     size_t component_size;      // Size of individual component
@@ -94,20 +127,13 @@ typedef enum {
     APP_STATE_GAME_OVER
 } AppStateEnum;
 
-// Z-buffer cell for rendering
-typedef struct {
-    char character;
-    uint8_t color;
-    bool has_content;
-} ZBufferCell;
-
 // ECS State (consolidated from ecs.c)
 typedef struct {
     // Component registry
     struct {
         ComponentRegistryEntry component_info[32]; // MAX_COMPONENTS
         SparseComponentArray component_arrays[32]; // MAX_COMPONENTS
-        uint32_t component_active[1000]; // MAX_ENTITIES
+        uint32_t component_active[10000]; // MAX_ENTITIES
         uint32_t component_count;
         bool initialized;
         ComponentHashTable name_lookup;
@@ -118,11 +144,29 @@ typedef struct {
         System systems[32]; // MAX_SYSTEMS
         uint32_t system_count;
         bool needs_sorting;
+        uint32_t level_count;  // Number of DAG levels after sorting
     } systems;
     
     // Entity management
-    stack active_entities;
-    stack inactive_entities;
+    uint64_t alive[(10000 + 63) / 64]; // Liveness bitset, one bit per entity slot (MAX_ENTITIES)
+    uint16_t generations[10000];       // Current generation per slot, ECS_GENERATION_DEAD set when free (MAX_ENTITIES)
+    uint32_t free_list[10000];         // Stack of unused entity slot indices (MAX_ENTITIES)
+    uint32_t free_count;               // Number of IDs currently on the free list
+    uint32_t active_count;             // Number of live entities
+    
+    // Archetype storage backend, non-NULL when ecs.storage is "archetype"
+    struct ArchetypeStorage *archetypes;
+    
+    // Worker threads for system scheduling, non-NULL when ecs.worker_threads > 0
+    struct ThreadPool *workers;
+    struct SystemJob *jobs;            // Job records for the level being dispatched
+    uint32_t job_capacity;
+    
+    // Deferred structural changes: buffer 0 is the main thread, buffer i + 1 is worker i
+    struct ECSCommandBuffer *command_buffers;
+    uint32_t command_buffer_count;
+    uint64_t *command_order;           // Flush scratch: sort keys for every pending command
+    uint32_t command_order_capacity;
     bool initialized;
 } ECSState;
 
@@ -146,23 +190,63 @@ typedef struct {
     
     // Render system globals
    typedef struct {
-        SDL_Window *window;
+        SDL_Window *window;             // NULL when headless
         SDL_Renderer *renderer;
+        SDL_Surface *headless_surface;  // Software renderer target when config.render.headless
         
         // Multiple font sizes for different UI purposes
         TTF_Font *font_small;   // 14pt - for sidebar, status line
         TTF_Font *font_medium;  // 16pt - for main game, character creation
         TTF_Font *font_large;   // 18pt - for main menu
         
+        // Layout in pixels, from config.render; UI panels use the configured cell size
+        int window_width_px;
+        int window_height_px;
+        SDL_Rect sidebar_rect;
+        SDL_Rect status_rect;
+        SDL_Rect map_area;          // Fixed region the map is drawn into
+        
+        // Map grid at the current zoom level
+        int zoom_level;             // Index into RENDER_ZOOM_LEVELS
+        int zoom_pending;           // Level to switch to on the next pass, -1 if none
+        int cell_size;              // Map cell size in pixels
+        int game_area_width;        // Map cells that fit map_area at cell_size
+        int game_area_height;
+        const char *font_path;      // Font file the fonts were loaded from
+        TTF_Font *map_font;         // Opened at the map cell size for the atlas
+        
+        // Map glyphs baked from map_font, drawn as batched quads
+        GlyphAtlas map_atlas;
+        GlyphBatch map_batch;
+        SDL_Texture *grid_overlay;  // Pre-rendered graph paper lines for the game area
+        
+        // Rasterized UI strings shared by every view and window
+        TextCache text_cache;
+        
         bool initialized;
         
-        // Z-buffers
-        ZBufferCell *z_buffer_0;  // Background layer
-        ZBufferCell *z_buffer_1;  // Entity layer
+        // Map layers, game_area_width * game_area_height cells each
+        ZBuffer z_buffer;
+        
+        // Persistent game area; only cells that differ from previous_cells are redrawn
+        SDL_Texture *game_area_target;  // NULL when render targets are unsupported
+        ZBufferCell *previous_cells;    // What game_area_target currently shows
+        bool game_area_valid;           // False forces a full redraw
+        uint32_t cells_redrawn;         // Cells drawn by the last frame
+        
+        // Frames are recorded into a snapshot whose cells may be built on the map build thread
+        MapBuildThread map_build;
+        RenderSnapshot *recording;      // Snapshot being recorded, NULL outside post_update
+        bool invalidate_pending;        // Next snapshot redraws the whole game area
+        bool purge_text_pending;        // Next snapshot drops cached text (device reset)
         
         // Viewport state
         int viewport_x;
         int viewport_y;
+        
+        // Player FOV passes since startup, split by whether the cached grid was reused
+        uint64_t fov_recomputes;
+        uint64_t fov_cache_hits;
     } RenderState;
 
 // Main AppState structure - consolidates all global state
@@ -183,9 +267,12 @@ typedef struct AppState {
     // Message system (from g_message_queue)
     MessageQueue messages;
     
-    // Error handling (from g_last_error)
+    // Error handling (from g_last_error). error and error_counter belong to the main
+    // thread; pool workers and the map build thread keep their own context under error_tls.
     ErrorContext error;
     uint32_t error_counter;
+    SDL_threadID main_thread;
+    SDL_TLSID error_tls;
 
 
     // Message view state 
@@ -200,6 +287,10 @@ typedef struct AppState {
     // Configuration (from g_config)
     GameConfig config;
 
+    // Frame and per-system timing
+    ProfilerState profiler;
+    FrameScheduler frame_scheduler;
+
 } AppState;
 
 // Singleton access functions
@@ -0,0 +1,272 @@
+#include "archetype.h"
+#include "appstate.h"
+#include "log.h"
+#include "error.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Column offsets are aligned so every component type can be read in place
+#define ARCHETYPE_COLUMN_ALIGN 8
+
+static size_t align_up(size_t value) {
+    return (value + ARCHETYPE_COLUMN_ALIGN - 1) & ~(size_t)(ARCHETYPE_COLUMN_ALIGN - 1);
+}
+
+// ===== ARCHETYPE LAYOUT =====
+
+// Lay out columns for a given capacity, returning the total chunk size
+static size_t archetype_layout(ArchetypeStorage *storage, Archetype *archetype, uint32_t capacity) {
+    size_t offset = align_up(capacity * sizeof(Entity));
+
+    for (uint32_t c = 0; c < storage->component_count; c++) {
+        if (archetype->mask & (1u << c)) {
+            archetype->column_offset[c] = offset;
+            offset = align_up(offset + capacity * storage->component_sizes[c]);
+        } else {
+            archetype->column_offset[c] = 0;
+        }
+    }
+
+    return offset;
+}
+
+static uint32_t archetype_find_or_create(ArchetypeStorage *storage, uint32_t mask) {
+    // Archetype counts stay small, so a linear scan beats maintaining a hash
+    for (uint32_t i = 0; i < storage->archetype_count; i++) {
+        if (storage->archetypes[i].mask == mask) {
+            return i;
+        }
+    }
+
+    if (storage->archetype_count >= ARCHETYPE_MAX) {
+        ERROR_SET(RESULT_ERROR_SYSTEM_LIMIT, "Maximum archetypes reached (%d)", ARCHETYPE_MAX);
+        return ARCHETYPE_NONE;
+    }
+
+    uint32_t index = storage->archetype_count++;
+    Archetype *archetype = &storage->archetypes[index];
+    memset(archetype, 0, sizeof(Archetype));
+    archetype->mask = mask;
+
+    // Fit as many rows as the chunk budget allows, then shrink until padding fits too
+    size_t row_bytes = sizeof(Entity);
+    for (uint32_t c = 0; c < storage->component_count; c++) {
+        if (mask & (1u << c)) {
+            row_bytes += storage->component_sizes[c];
+        }
+    }
+
+    uint32_t capacity = (uint32_t)(ARCHETYPE_CHUNK_BYTES / row_bytes);
+    if (capacity == 0) {
+        capacity = 1;
+    }
+    while (capacity > 1 && archetype_layout(storage, archetype, capacity) > ARCHETYPE_CHUNK_BYTES) {
+        capacity--;
+    }
+
+    archetype->chunk_capacity = capacity;
+    archetype->chunk_bytes = archetype_layout(storage, archetype, capacity);
+
+    LOG_DEBUG("Created archetype %u (mask 0x%08x, %u entities per chunk)", index, mask, capacity);
+    return index;
+}
+
+// ===== ROW MANAGEMENT =====
+
+// Reserve a row at the end of an archetype
+static bool archetype_push_row(Archetype *archetype, uint32_t *chunk_out, uint32_t *row_out) {
+    if (archetype->chunk_count == 0 ||
+        archetype->chunks[archetype->chunk_count - 1].count >= archetype->chunk_capacity) {
+
+        if (archetype->chunk_count == archetype->chunk_allocated) {
+            uint32_t new_allocated = archetype->chunk_allocated ? archetype->chunk_allocated * 2 : 4;
+            ArchetypeChunk *new_chunks = realloc(archetype->chunks, new_allocated * sizeof(ArchetypeChunk));
+            if (!new_chunks) {
+                return false;
+            }
+            memset(new_chunks + archetype->chunk_allocated, 0,
+                   (new_allocated - archetype->chunk_allocated) * sizeof(ArchetypeChunk));
+            archetype->chunks = new_chunks;
+            archetype->chunk_allocated = new_allocated;
+        }
+
+        ArchetypeChunk *chunk = &archetype->chunks[archetype->chunk_count];
+        if (!chunk->data) {
+            chunk->data = malloc(archetype->chunk_bytes);
+            if (!chunk->data) {
+                return false;
+            }
+        }
+        chunk->count = 0;
+        archetype->chunk_count++;
+    }
+
+    uint32_t chunk_index = archetype->chunk_count - 1;
+    *chunk_out = chunk_index;
+    *row_out = archetype->chunks[chunk_index].count++;
+    archetype->entity_count++;
+    return true;
+}
+
+// Swap-remove a row, moving the archetype's last row into the gap
+static void archetype_remove_row(ArchetypeStorage *storage, Archetype *archetype, uint32_t chunk_index, uint32_t row) {
+    uint32_t last_chunk = archetype->chunk_count - 1;
+    uint32_t last_row = archetype->chunks[last_chunk].count - 1;
+
+    if (chunk_index != last_chunk || row != last_row) {
+        uint8_t *dst = archetype->chunks[chunk_index].data;
+        uint8_t *src = archetype->chunks[last_chunk].data;
+
+        Entity moved = ((Entity *)src)[last_row];
+        ((Entity *)dst)[row] = moved;
+
+        for (uint32_t c = 0; c < storage->component_count; c++) {
+            if (archetype->mask & (1u << c)) {
+                size_t size = storage->component_sizes[c];
+                memcpy(dst + archetype->column_offset[c] + row * size,
+                       src + archetype->column_offset[c] + last_row * size, size);
+            }
+        }
+
+        ArchetypeLocation *location = &storage->locations[ENTITY_INDEX(moved)];
+        location->chunk = chunk_index;
+        location->row = row;
+    }
+
+    // Empty trailing chunks keep their buffers for reuse
+    if (--archetype->chunks[last_chunk].count == 0) {
+        archetype->chunk_count--;
+    }
+    archetype->entity_count--;
+}
+
+// ===== PUBLIC API =====
+
+ArchetypeStorage *archetype_storage_create(const size_t *component_sizes, uint32_t component_count, uint32_t max_entities) {
+    if (!component_sizes || component_count > ARCHETYPE_MAX_COMPONENTS) {
+        ERROR_SET(RESULT_ERROR_INVALID_PARAMETER, "Invalid component layout for archetype storage");
+        return NULL;
+    }
+
+    ArchetypeStorage *storage = calloc(1, sizeof(ArchetypeStorage));
+    if (!storage) {
+        return NULL;
+    }
+
+    storage->locations = malloc(max_entities * sizeof(ArchetypeLocation));
+    if (!storage->locations) {
+        free(storage);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < max_entities; i++) {
+        storage->locations[i].archetype = ARCHETYPE_NONE;
+    }
+    storage->location_count = max_entities;
+
+    memcpy(storage->component_sizes, component_sizes, component_count * sizeof(size_t));
+    storage->component_count = component_count;
+
+    LOG_INFO("Archetype storage created (%u components, %d byte chunks)", component_count, ARCHETYPE_CHUNK_BYTES);
+    return storage;
+}
+
+void archetype_storage_destroy(ArchetypeStorage *storage) {
+    if (!storage) return;
+
+    for (uint32_t i = 0; i < storage->archetype_count; i++) {
+        Archetype *archetype = &storage->archetypes[i];
+        for (uint32_t c = 0; c < archetype->chunk_allocated; c++) {
+            free(archetype->chunks[c].data);
+        }
+        free(archetype->chunks);
+    }
+
+    LOG_INFO("Archetype storage destroyed (%u archetypes)", storage->archetype_count);
+    free(storage->locations);
+    free(storage);
+}
+
+bool archetype_set_mask(ArchetypeStorage *storage, Entity entity, uint32_t mask) {
+    uint32_t index = ENTITY_INDEX(entity);
+    if (!storage || index >= storage->location_count) {
+        return false;
+    }
+
+    ArchetypeLocation *location = &storage->locations[index];
+    uint32_t old_index = location->archetype;
+    if (old_index != ARCHETYPE_NONE && storage->archetypes[old_index].mask == mask) {
+        return true;
+    }
+
+    ArchetypeLocation new_location = { ARCHETYPE_NONE, 0, 0 };
+
+    if (mask != 0) {
+        new_location.archetype = archetype_find_or_create(storage, mask);
+        if (new_location.archetype == ARCHETYPE_NONE) {
+            return false;
+        }
+
+        Archetype *dst = &storage->archetypes[new_location.archetype];
+        if (!archetype_push_row(dst, &new_location.chunk, &new_location.row)) {
+            ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Failed to grow archetype for mask 0x%08x", mask);
+            return false;
+        }
+
+        uint8_t *dst_data = dst->chunks[new_location.chunk].data;
+        ((Entity *)dst_data)[new_location.row] = entity;
+
+        // Carry over shared components, zero the new ones
+        uint32_t old_mask = old_index != ARCHETYPE_NONE ? storage->archetypes[old_index].mask : 0;
+        for (uint32_t c = 0; c < storage->component_count; c++) {
+            if (!(mask & (1u << c))) continue;
+
+            size_t size = storage->component_sizes[c];
+            uint8_t *dst_component = dst_data + dst->column_offset[c] + new_location.row * size;
+            if (old_mask & (1u << c)) {
+                Archetype *src = &storage->archetypes[old_index];
+                memcpy(dst_component, src->chunks[location->chunk].data + src->column_offset[c] + location->row * size, size);
+            } else {
+                memset(dst_component, 0, size);
+            }
+        }
+    }
+
+    if (old_index != ARCHETYPE_NONE) {
+        archetype_remove_row(storage, &storage->archetypes[old_index], location->chunk, location->row);
+    }
+
+    *location = new_location;
+    return true;
+}
+
+void *archetype_get_component(ArchetypeStorage *storage, Entity entity, uint32_t component_id) {
+    uint32_t index = ENTITY_INDEX(entity);
+    if (!storage || index >= storage->location_count || component_id >= storage->component_count) {
+        return NULL;
+    }
+
+    const ArchetypeLocation *location = &storage->locations[index];
+    if (location->archetype == ARCHETYPE_NONE) {
+        return NULL;
+    }
+
+    const Archetype *archetype = &storage->archetypes[location->archetype];
+    if (!(archetype->mask & (1u << component_id))) {
+        return NULL;
+    }
+
+    return archetype->chunks[location->chunk].data + archetype->column_offset[component_id] +
+           location->row * storage->component_sizes[component_id];
+}
+
+Entity *archetype_chunk_entities(const Archetype *archetype, uint32_t chunk) {
+    return (Entity *)archetype->chunks[chunk].data;
+}
+
+void *archetype_chunk_column(const Archetype *archetype, uint32_t chunk, uint32_t component_id) {
+    if (!(archetype->mask & (1u << component_id))) {
+        return NULL;
+    }
+    return archetype->chunks[chunk].data + archetype->column_offset[component_id];
+}
@@ -0,0 +1,65 @@
+#ifndef ARCHETYPE_H
+#define ARCHETYPE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "types.h"
+
+// Archetype storage configuration
+#define ARCHETYPE_CHUNK_BYTES (16 * 1024)  // Target size of one chunk of SoA columns
+#define ARCHETYPE_MAX_COMPONENTS 32        // Component masks are 32 bits wide
+#define ARCHETYPE_MAX 256                  // Maximum number of distinct component masks
+#define ARCHETYPE_NONE UINT32_MAX          // Location of an entity with no components
+
+// A fixed-size block holding up to chunk_capacity entities of one archetype.
+// Layout: the entity handle column, then one column per component in the mask.
+typedef struct {
+    uint8_t *data;
+    uint32_t count;                 // Rows in use
+} ArchetypeChunk;
+
+// All entities sharing one component mask
+typedef struct {
+    uint32_t mask;                  // Component mask shared by every entity here
+    uint32_t chunk_capacity;        // Entities per chunk
+    size_t chunk_bytes;             // Allocation size of each chunk
+    size_t column_offset[ARCHETYPE_MAX_COMPONENTS]; // Byte offset of each component column in a chunk
+    ArchetypeChunk *chunks;
+    uint32_t chunk_count;           // Chunks in use; all but the last are full
+    uint32_t chunk_allocated;       // Chunks with a data buffer (empty ones are kept for reuse)
+    uint32_t entity_count;
+} Archetype;
+
+// Where an entity's row lives
+typedef struct {
+    uint32_t archetype;             // ARCHETYPE_NONE when the entity has no components
+    uint32_t chunk;
+    uint32_t row;
+} ArchetypeLocation;
+
+typedef struct ArchetypeStorage {
+    size_t component_sizes[ARCHETYPE_MAX_COMPONENTS];
+    uint32_t component_count;
+    Archetype archetypes[ARCHETYPE_MAX];
+    uint32_t archetype_count;
+    ArchetypeLocation *locations;   // Indexed by entity slot
+    uint32_t location_count;
+} ArchetypeStorage;
+
+// Storage lifetime
+ArchetypeStorage *archetype_storage_create(const size_t *component_sizes, uint32_t component_count, uint32_t max_entities);
+void archetype_storage_destroy(ArchetypeStorage *storage);
+
+// Move an entity to the archetype for mask, keeping the components both masks share.
+// Components new to the entity are zeroed. A mask of 0 removes the entity entirely.
+bool archetype_set_mask(ArchetypeStorage *storage, Entity entity, uint32_t mask);
+
+// Component access
+void *archetype_get_component(ArchetypeStorage *storage, Entity entity, uint32_t component_id);
+
+// Chunk column access for iteration
+Entity *archetype_chunk_entities(const Archetype *archetype, uint32_t chunk);
+void *archetype_chunk_column(const Archetype *archetype, uint32_t chunk, uint32_t component_id);
+
+#endif // ARCHETYPE_H
@@ -0,0 +1,39 @@
+#include "bitgrid.h"
+
+static uint32_t popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (uint32_t)((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+uint32_t bitrow_popcount(const uint64_t *row, size_t words) {
+    uint32_t count = 0;
+    for (size_t i = 0; i < words; i++) {
+        count += popcount64(row[i]);
+    }
+    return count;
+}
+
+void bitrow_or_shifted(uint64_t *dst, size_t dst_words, const uint64_t *src, size_t src_words, int offset) {
+    // Whole words and the bit shift within a word; floor division keeps shift in 0..63
+    int word_offset = offset >= 0 ? offset / BITGRID_WORD_BITS : -((-offset + BITGRID_WORD_BITS - 1) / BITGRID_WORD_BITS);
+    int shift = offset - word_offset * BITGRID_WORD_BITS;
+
+    for (size_t i = 0; i < src_words; i++) {
+        uint64_t word = src[i];
+        if (!word) continue;
+
+        long low = (long)i + word_offset;
+        if (low >= 0 && (size_t)low < dst_words) {
+            dst[low] |= word << shift;
+        }
+        if (shift && low + 1 >= 0 && (size_t)(low + 1) < dst_words) {
+            dst[low + 1] |= word >> (BITGRID_WORD_BITS - shift);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef BITGRID_H
+#define BITGRID_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Bit rows packed into 64-bit words: bit i of a row is bit (i % 64) of word i / 64.
+// A grid is an array of rows of the same word count, so clears, merges and counts
+// go a word (64 cells) at a time.
+#define BITGRID_WORD_BITS 64
+#define BITGRID_WORDS(bits) (((bits) + BITGRID_WORD_BITS - 1) / BITGRID_WORD_BITS)
+
+static inline bool bitrow_test(const uint64_t *row, int bit) {
+    return (row[bit >> 6] >> (bit & 63)) & 1u;
+}
+
+static inline void bitrow_set(uint64_t *row, int bit) {
+    row[bit >> 6] |= (uint64_t)1 << (bit & 63);
+}
+
+// Set bits in the first words of a row
+uint32_t bitrow_popcount(const uint64_t *row, size_t words);
+
+// dst |= src moved offset bits along the row (negative moves toward bit 0). Bits
+// landing outside dst's dst_words are dropped.
+void bitrow_or_shifted(uint64_t *dst, size_t dst_words, const uint64_t *src, size_t src_words, int offset);
+
+#endif // BITGRID_H
@@ -18,26 +18,6 @@ static CharacterConfig g_character_config = {0};
 // Initialize random seed (call once at startup)
 static bool random_initialized = false;
 
-// Helper function to render text at a specific position
-static void render_text_at_position(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, SDL_Color color) {
-    if (!font || !text) return;
-    
-    SDL_Surface *text_surface = TTF_RenderText_Solid(font, text, color);
-    if (text_surface) {
-        SDL_Texture *text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
-        if (text_texture) {
-            int text_w, text_h;
-            SDL_QueryTexture(text_texture, NULL, NULL, &text_w, &text_h);
-            
-            SDL_Rect text_rect = {x, y, text_w, text_h};
-            SDL_RenderCopy(renderer, text_texture, NULL, &text_rect);
-            
-            SDL_DestroyTexture(text_texture);
-        }
-        SDL_FreeSurface(text_surface);
-    }
-}
-
 // Initialize random number generator if needed
 static void ensure_random_initialized(void) {
     if (!random_initialized) {
@@ -621,7 +601,7 @@ Entity character_creation_finalize(CharacterCreation *creation) {
     
     // Add Position component
     Position pos = {0, 0, INVALID_ENTITY};
-    component_add(app_state, player, component_get_id(app_state, "Position"), &pos);
+    ECS_ADD(app_state, player, Position, &pos);
     
     // Add BaseInfo component with character data
     BaseInfo base_info = {0};
@@ -634,7 +614,7 @@ Entity character_creation_finalize(CharacterCreation *creation) {
     snprintf(base_info.description, sizeof(base_info.description), 
              "A %s %s named %s", 
              race->name, class->name, creation->name);
-    component_add(app_state, player, component_get_id(app_state, "BaseInfo"), &base_info);
+    ECS_ADD(app_state, player, BaseInfo, &base_info);
     
     // Add Actor component with rolled stats
     Actor actor = {0};
@@ -651,21 +631,22 @@ Entity character_creation_finalize(CharacterCreation *creation) {
     actor.damage_sides = 6;
     actor.damage_bonus = character_creation_get_ability_modifier(final_scores.strength);
     
-    component_add(app_state, player, component_get_id(app_state, "Actor"), &actor);
+    ECS_ADD(app_state, player, Actor, &actor);
     
     // Add Action component
     Action action = {ACTION_NONE, 0};
-    component_add(app_state, player, component_get_id(app_state, "Action"), &action);
+    ECS_ADD(app_state, player, Action, &action);
     
     // Add Inventory component  
     Inventory inventory = {0};
     inventory.max_items = 10 + character_creation_get_ability_modifier(final_scores.strength);
-    component_add(app_state, player, component_get_id(app_state, "Inventory"), &inventory);
+    ECS_ADD(app_state, player, Inventory, &inventory);
     
     // Add FieldOfView component - essential for dungeon rendering
     CompactFieldOfView player_fov;
-    field_init_compact(&player_fov, FOV_RADIUS);
-    if (!component_add(app_state, player, component_get_id(app_state, "FieldOfView"), &player_fov)) {
+    field_init_compact(&player_fov, (int)app_state->config.fov.radius);
+    player_fov.algorithm = app_state->config.fov.algorithm;
+    if (!ECS_ADD(app_state, player, FieldOfView, &player_fov)) {
         LOG_ERROR("Failed to add FieldOfView component to player");
         entity_destroy(app_state, player);
         return INVALID_ENTITY;
@@ -1065,6 +1046,7 @@ static void render_wrapped_text(SDL_Renderer *renderer, TTF_Font *font, const ch
         return;
     }
     
+    AppState *app_state = appstate_get();
     char *text_copy = strdup(text);
     char *line_start = text_copy;
     char *current_pos = text_copy;
@@ -1088,7 +1070,7 @@ static void render_wrapped_text(SDL_Renderer *renderer, TTF_Font *font, const ch
         
         if (text_width > max_width && current_pos != line_start) {
             // Word doesn't fit, render current line and start new one
-            render_text_at_position(renderer, font, line_start, x, current_y, color);
+            render_system_draw_text(app_state, renderer, font, line_start, x, current_y, color);
             current_y += line_height + 2;
             line_start = current_pos;
             *word_end = saved_char;
@@ -1099,7 +1081,7 @@ static void render_wrapped_text(SDL_Renderer *renderer, TTF_Font *font, const ch
             if (*current_pos == '\n') {
                 // Force new line
                 *current_pos = '\0';
-                render_text_at_position(renderer, font, line_start, x, current_y, color);
+                render_system_draw_text(app_state, renderer, font, line_start, x, current_y, color);
                 current_y += line_height + 2;
                 current_pos++;
                 line_start = current_pos;
@@ -1111,7 +1093,7 @@ static void render_wrapped_text(SDL_Renderer *renderer, TTF_Font *font, const ch
     
     // Render final line if there's text remaining
     if (line_start < current_pos) {
-        render_text_at_position(renderer, font, line_start, x, current_y, color);
+        render_system_draw_text(app_state, renderer, font, line_start, x, current_y, color);
         current_y += line_height + 2;
     }
     
@@ -1154,13 +1136,13 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
     // Check if configuration is loaded
     CharacterConfig *config = get_character_config();
     if (!config || !config->loaded) {
-        render_text_at_position(renderer, font, "ERROR: Character configuration not loaded!", 20, 60, red);
-        render_text_at_position(renderer, font, "Check race.json and class.json files", 20, 100, white);
+        render_system_draw_text(app_state, renderer, font, "ERROR: Character configuration not loaded!", 20, 60, red);
+        render_system_draw_text(app_state, renderer, font, "Check race.json and class.json files", 20, 100, white);
         return;
     }
     
     // Header
-    render_text_at_position(renderer, font, "CHARACTER CREATION - Basic Fantasy RPG", 20, 10, cyan);
+    render_system_draw_text(app_state, renderer, font, "CHARACTER CREATION - Basic Fantasy RPG", 20, 10, cyan);
     
     // Step indicators
     int step_y = 40;
@@ -1169,7 +1151,7 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
     step_colors[creation->current_step] = yellow;
     
     for (int i = 0; i < 4; i++) {
-        render_text_at_position(renderer, font, step_names[i], 20 + i * 120, step_y, step_colors[i]);
+        render_system_draw_text(app_state, renderer, font, step_names[i], 20 + i * 120, step_y, step_colors[i]);
     }
     
     // Main content area starts at y=80
@@ -1177,7 +1159,7 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
     
     switch (creation->current_step) {
         case STEP_STATS:
-            render_text_at_position(renderer, font, "ABILITY SCORES", 20, content_y, yellow);
+            render_system_draw_text(app_state, renderer, font, "ABILITY SCORES", 20, content_y, yellow);
             content_y += 30;
             
             if (creation->stats_rolled) {
@@ -1187,7 +1169,7 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                         creation->scores.strength, character_creation_get_ability_modifier(creation->scores.strength),
                         creation->scores.dexterity, character_creation_get_ability_modifier(creation->scores.dexterity),
                         creation->scores.constitution, character_creation_get_ability_modifier(creation->scores.constitution));
-                render_text_at_position(renderer, font, stats_text, 20, content_y, white);
+                render_system_draw_text(app_state, renderer, font, stats_text, 20, content_y, white);
                 content_y += 25;
                 
                 snprintf(stats_text, sizeof(stats_text), 
@@ -1195,34 +1177,34 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                         creation->scores.intelligence, character_creation_get_ability_modifier(creation->scores.intelligence),
                         creation->scores.wisdom, character_creation_get_ability_modifier(creation->scores.wisdom),
                         creation->scores.charisma, character_creation_get_ability_modifier(creation->scores.charisma));
-                render_text_at_position(renderer, font, stats_text, 20, content_y, white);
+                render_system_draw_text(app_state, renderer, font, stats_text, 20, content_y, white);
                 content_y += 40;
                 
-                render_text_at_position(renderer, font, "Press R/SPACE to reroll stats", 20, content_y, light_blue);
+                render_system_draw_text(app_state, renderer, font, "Press R/SPACE to reroll stats", 20, content_y, light_blue);
                 content_y += 20;
-                render_text_at_position(renderer, font, "Press ENTER or TAB to continue to race selection", 20, content_y, light_blue);
+                render_system_draw_text(app_state, renderer, font, "Press ENTER or TAB to continue to race selection", 20, content_y, light_blue);
             } else {
-                render_text_at_position(renderer, font, "Press R or SPACE to roll your ability scores", 20, content_y, light_blue);
+                render_system_draw_text(app_state, renderer, font, "Press R or SPACE to roll your ability scores", 20, content_y, light_blue);
                 content_y += 40;
                 
-                render_text_at_position(renderer, font, "Ability scores determine your character's capabilities:", 20, content_y, white);
+                render_system_draw_text(app_state, renderer, font, "Ability scores determine your character's capabilities:", 20, content_y, white);
                 content_y += 25;
-                render_text_at_position(renderer, font, "STR - Physical strength, melee damage", 40, content_y, gray);
+                render_system_draw_text(app_state, renderer, font, "STR - Physical strength, melee damage", 40, content_y, gray);
                 content_y += 20;
-                render_text_at_position(renderer, font, "DEX - Agility, missile accuracy, armor class", 40, content_y, gray);
+                render_system_draw_text(app_state, renderer, font, "DEX - Agility, missile accuracy, armor class", 40, content_y, gray);
                 content_y += 20;
-                render_text_at_position(renderer, font, "CON - Health, hit points, endurance", 40, content_y, gray);
+                render_system_draw_text(app_state, renderer, font, "CON - Health, hit points, endurance", 40, content_y, gray);
                 content_y += 20;
-                render_text_at_position(renderer, font, "INT - Reasoning, magic-user spells", 40, content_y, gray);
+                render_system_draw_text(app_state, renderer, font, "INT - Reasoning, magic-user spells", 40, content_y, gray);
                 content_y += 20;
-                render_text_at_position(renderer, font, "WIS - Perception, cleric spells", 40, content_y, gray);
+                render_system_draw_text(app_state, renderer, font, "WIS - Perception, cleric spells", 40, content_y, gray);
                 content_y += 20;
-                render_text_at_position(renderer, font, "CHA - Leadership, reaction rolls", 40, content_y, gray);
+                render_system_draw_text(app_state, renderer, font, "CHA - Leadership, reaction rolls", 40, content_y, gray);
             }
             break;
             
         case STEP_RACE:
-            render_text_at_position(renderer, font, "SELECT RACE", 20, content_y, yellow);
+            render_system_draw_text(app_state, renderer, font, "SELECT RACE", 20, content_y, yellow);
             content_y += 30;
             
             for (int i = 0; i < config->race_count; i++) {
@@ -1238,7 +1220,7 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                 if (is_selected) strcat(race_line, " [SELECTED]");
                 if (!can_select) strcat(race_line, " [UNAVAILABLE]");
                 
-                render_text_at_position(renderer, font, race_line, 20, content_y, color);
+                render_system_draw_text(app_state, renderer, font, race_line, 20, content_y, color);
                 content_y += 25;
                 
                 // Show basic description
@@ -1285,13 +1267,13 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                                 strcat(modifiers, temp);
                             }
                             
-                            render_text_at_position(renderer, font, modifiers, 40, content_y, light_blue);
+                            render_system_draw_text(app_state, renderer, font, modifiers, 40, content_y, light_blue);
                             content_y += 20;
                         }
                         
                         // Show special abilities
                         if (config->races[i].special_ability_count > 0) {
-                            render_text_at_position(renderer, font, "Special Abilities:", 40, content_y, light_blue);
+                            render_system_draw_text(app_state, renderer, font, "Special Abilities:", 40, content_y, light_blue);
                             content_y += 20;
                             for (int j = 0; j < config->races[i].special_ability_count; j++) {
                                 char ability_text[512];
@@ -1308,11 +1290,11 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                 }
             }
             
-            render_text_at_position(renderer, font, "Use UP/DOWN arrows to browse, numbers 1-9 or ENTER to select", 20, content_y + 20, light_blue);
+            render_system_draw_text(app_state, renderer, font, "Use UP/DOWN arrows to browse, numbers 1-9 or ENTER to select", 20, content_y + 20, light_blue);
             break;
             
         case STEP_CLASS:
-            render_text_at_position(renderer, font, "SELECT CLASS", 20, content_y, yellow);
+            render_system_draw_text(app_state, renderer, font, "SELECT CLASS", 20, content_y, yellow);
             content_y += 30;
             
             RaceConfig *selected_race = (creation->selected_race >= 0) ? &config->races[creation->selected_race] : NULL;
@@ -1330,7 +1312,7 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                 if (is_selected) strcat(class_line, " [SELECTED]");
                 if (!can_select) strcat(class_line, " [UNAVAILABLE]");
                 
-                render_text_at_position(renderer, font, class_line, 20, content_y, color);
+                render_system_draw_text(app_state, renderer, font, class_line, 20, content_y, color);
                 content_y += 25;
                 
                 // Show basic description
@@ -1343,18 +1325,18 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                         // Show requirements and other details
                         char requirements[256];
                         character_creation_get_class_requirements_text(&config->classes[i], selected_race, requirements, sizeof(requirements));
-                        render_text_at_position(renderer, font, requirements, 40, content_y, light_blue);
+                        render_system_draw_text(app_state, renderer, font, requirements, 40, content_y, light_blue);
                         content_y += 20;
                         
                         char details[256];
                         snprintf(details, sizeof(details), "Hit Die: %s | Role: %s", 
                                 config->classes[i].hit_die, config->classes[i].role);
-                        render_text_at_position(renderer, font, details, 40, content_y, light_blue);
+                        render_system_draw_text(app_state, renderer, font, details, 40, content_y, light_blue);
                         content_y += 20;
                         
                         // Show special abilities
                         if (config->classes[i].special_ability_count > 0) {
-                            render_text_at_position(renderer, font, "Special Abilities:", 40, content_y, light_blue);
+                            render_system_draw_text(app_state, renderer, font, "Special Abilities:", 40, content_y, light_blue);
                             content_y += 20;
                             for (int j = 0; j < config->classes[i].special_ability_count; j++) {
                                 char ability_text[512];
@@ -1371,11 +1353,11 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                 }
             }
             
-            render_text_at_position(renderer, font, "Use UP/DOWN arrows to browse, numbers 1-9 or ENTER to select", 20, content_y + 20, light_blue);
+            render_system_draw_text(app_state, renderer, font, "Use UP/DOWN arrows to browse, numbers 1-9 or ENTER to select", 20, content_y + 20, light_blue);
             break;
             
         case STEP_REVIEW:
-            render_text_at_position(renderer, font, "CHARACTER REVIEW", 20, content_y, yellow);
+            render_system_draw_text(app_state, renderer, font, "CHARACTER REVIEW", 20, content_y, yellow);
             content_y += 40;
             
             // Show final character stats
@@ -1387,10 +1369,10 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                         creation->name, 
                         config->races[creation->selected_race].name,
                         config->classes[creation->selected_class].name);
-                render_text_at_position(renderer, font, char_summary, 20, content_y, green);
+                render_system_draw_text(app_state, renderer, font, char_summary, 20, content_y, green);
                 content_y += 40;
                 
-                render_text_at_position(renderer, font, "Final Ability Scores (including racial modifiers):", 20, content_y, white);
+                render_system_draw_text(app_state, renderer, font, "Final Ability Scores (including racial modifiers):", 20, content_y, white);
                 content_y += 25;
                 
                 char stats_text[256];
@@ -1399,7 +1381,7 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                         final_scores.strength, character_creation_get_ability_modifier(final_scores.strength),
                         final_scores.dexterity, character_creation_get_ability_modifier(final_scores.dexterity),
                         final_scores.constitution, character_creation_get_ability_modifier(final_scores.constitution));
-                render_text_at_position(renderer, font, stats_text, 20, content_y, white);
+                render_system_draw_text(app_state, renderer, font, stats_text, 20, content_y, white);
                 content_y += 25;
                 
                 snprintf(stats_text, sizeof(stats_text), 
@@ -1407,22 +1389,22 @@ void character_creation_render(CharacterCreation *creation, SDL_Renderer *render
                         final_scores.intelligence, character_creation_get_ability_modifier(final_scores.intelligence),
                         final_scores.wisdom, character_creation_get_ability_modifier(final_scores.wisdom),
                         final_scores.charisma, character_creation_get_ability_modifier(final_scores.charisma));
-                render_text_at_position(renderer, font, stats_text, 20, content_y, white);
+                render_system_draw_text(app_state, renderer, font, stats_text, 20, content_y, white);
                 content_y += 40;
                 
-                render_text_at_position(renderer, font, "Press ENTER to begin your adventure!", 20, content_y, green);
-                render_text_at_position(renderer, font, "Use BACKSPACE or F1-F3 to go back and modify your character", 20, content_y + 25, light_blue);
+                render_system_draw_text(app_state, renderer, font, "Press ENTER to begin your adventure!", 20, content_y, green);
+                render_system_draw_text(app_state, renderer, font, "Use BACKSPACE or F1-F3 to go back and modify your character", 20, content_y + 25, light_blue);
             }
             break;
     }
     
     // Show validation message if present
     if (creation->validation_message[0] != '\0') {
-        render_text_at_position(renderer, font, creation->validation_message, 20, 550, red);
+        render_system_draw_text(app_state, renderer, font, creation->validation_message, 20, 550, red);
     }
     
     // Navigation help
-    render_text_at_position(renderer, font, "Navigation: TAB=Next, BACKSPACE=Previous, F1-F4=Jump to step, I=Toggle detail view", 20, 580, gray);
+    render_system_draw_text(app_state, renderer, font, "Navigation: TAB=Next, BACKSPACE=Previous, F1-F4=Jump to step, I=Toggle detail view", 20, 580, gray);
     
     // Present the rendered frame to the screen
     SDL_RenderPresent(renderer);
@@ -2,15 +2,17 @@
 #include "ecs.h"
 #include "field.h"
 #include "appstate.h"
+#include "log.h"
 
 void components_init(struct AppState *app_state) {
-    // Register all component types with the ECS
-    component_register(app_state, "Position", sizeof(Position));
-    component_register(app_state, "BaseInfo", sizeof(BaseInfo));
-    component_register(app_state, "Action", sizeof(Action));
-    component_register(app_state, "FieldOfView", sizeof(CompactFieldOfView));
-    component_register(app_state, "Actor", sizeof(Actor));
-    component_register(app_state, "Inventory", sizeof(Inventory));
+    // Register all component types with the ECS, in COMPONENT_LIST order so the
+    // runtime IDs match the compile-time COMPONENT_ID_* constants
+#define COMPONENT_REGISTER_ENTRY(name, type) \
+    if (component_register(app_state, #name, sizeof(type)) != COMPONENT_ID_##name) { \
+        LOG_ERROR("Component '%s' did not register at its compile-time ID %d", #name, COMPONENT_ID_##name); \
+    }
+    COMPONENT_LIST(COMPONENT_REGISTER_ENTRY)
+#undef COMPONENT_REGISTER_ENTRY
 }
 
 // Convenience functions for common flag checks
@@ -18,7 +20,7 @@ bool entity_is_player(Entity entity) {
     struct AppState *app_state = appstate_get();
     if (!app_state) return false;
     
-    BaseInfo *base_info = (BaseInfo *)entity_get_component(app_state, entity, component_get_id(app_state, "BaseInfo"));
+    BaseInfo *base_info = ECS_GET(app_state, entity, BaseInfo);
     return base_info ? ENTITY_HAS_FLAG(base_info->flags, ENTITY_FLAG_PLAYER) : false;
 }
 
@@ -26,7 +28,7 @@ bool entity_can_carry(Entity entity) {
     struct AppState *app_state = appstate_get();
     if (!app_state) return false;
     
-    BaseInfo *base_info = (BaseInfo *)entity_get_component(app_state, entity, component_get_id(app_state, "BaseInfo"));
+    BaseInfo *base_info = ECS_GET(app_state, entity, BaseInfo);
     return base_info ? ENTITY_HAS_FLAG(base_info->flags, ENTITY_FLAG_CAN_CARRY) : false;
 }
 
@@ -34,7 +36,7 @@ bool entity_is_carryable(Entity entity) {
     struct AppState *app_state = appstate_get();
     if (!app_state) return false;
     
-    BaseInfo *base_info = (BaseInfo *)entity_get_component(app_state, entity, component_get_id(app_state, "BaseInfo"));
+    BaseInfo *base_info = ECS_GET(app_state, entity, BaseInfo);
     return base_info ? ENTITY_HAS_FLAG(base_info->flags, ENTITY_FLAG_CARRYABLE) : false;
 }
 
@@ -42,7 +44,7 @@ bool entity_has_moved(Entity entity) {
     struct AppState *app_state = appstate_get();
     if (!app_state) return false;
     
-    BaseInfo *base_info = (BaseInfo *)entity_get_component(app_state, entity, component_get_id(app_state, "BaseInfo"));
+    BaseInfo *base_info = ECS_GET(app_state, entity, BaseInfo);
     return base_info ? ENTITY_HAS_FLAG(base_info->flags, ENTITY_FLAG_MOVED) : false;
 }
 
@@ -50,7 +52,7 @@ void entity_clear_moved_flag(Entity entity) {
     struct AppState *app_state = appstate_get();
     if (!app_state) return;
     
-    BaseInfo *base_info = (BaseInfo *)entity_get_component(app_state, entity, component_get_id(app_state, "BaseInfo"));
+    BaseInfo *base_info = ECS_GET(app_state, entity, BaseInfo);
     if (base_info) {
         ENTITY_CLEAR_FLAG(base_info->flags, ENTITY_FLAG_MOVED);
     }
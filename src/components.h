@@ -96,10 +96,36 @@ typedef struct Action {
     int action_data;
 } Action;
 
+// Registered component types, in ID order: X(Name, StorageType)
+// Names are also the strings used by JSON templates.
+#define COMPONENT_LIST(X) \
+    X(Position, Position) \
+    X(BaseInfo, BaseInfo) \
+    X(Action, Action) \
+    X(FieldOfView, CompactFieldOfView) \
+    X(Actor, Actor) \
+    X(Inventory, Inventory)
+
+// Compile-time component IDs: COMPONENT_ID_Position, COMPONENT_ID_BaseInfo, ...
+typedef enum {
+#define COMPONENT_ENUM_ENTRY(name, type) COMPONENT_ID_##name,
+    COMPONENT_LIST(COMPONENT_ENUM_ENTRY)
+#undef COMPONENT_ENUM_ENTRY
+    COMPONENT_ID_COUNT
+} ComponentId;
+
+// Storage type for each component name: ComponentType_FieldOfView is CompactFieldOfView
+#define COMPONENT_TYPEDEF_ENTRY(name, type) typedef type ComponentType_##name;
+COMPONENT_LIST(COMPONENT_TYPEDEF_ENTRY)
+#undef COMPONENT_TYPEDEF_ENTRY
+
+// Component mask bit for a component name
+#define COMPONENT_BIT(name) (1u << COMPONENT_ID_##name)
+
 // Forward declaration
 struct AppState;
 
-// Component initialization function
+// Component initialization function - registers every COMPONENT_LIST entry at its fixed ID
 void components_init(struct AppState *app_state);
 
 #endif
@@ -13,14 +13,17 @@ static const GameConfig DEFAULT_CONFIG = {
         .max_entities = 1000,
         .max_components = 32,
         .max_systems = 32,
-        .initial_component_capacity = 16
+        .initial_component_capacity = 16,
+        .storage = ECS_STORAGE_SPARSE,
+        .worker_threads = 0
     },
     .dungeon = {
         .width = 100,
         .height = 100,
         .max_rooms = 20,
         .min_room_size = 5,
-        .max_room_size = 15
+        .max_room_size = 15,
+        .seed = 0
     },
     .render = {
         .cell_size = 16,
@@ -28,11 +31,15 @@ static const GameConfig DEFAULT_CONFIG = {
         .game_area_width = 48,
         .game_area_height = 30,
         .status_line_height = 1,
-        .window_title = "Adventure Game"
+        .window_title = "Adventure Game",
+        .headless = false,
+        .text_cache_kb = 2048,
+        .map_build_thread = false
     },
     .fov = {
         .radius = 8,
-        .grid_size = 17  // Will be recalculated
+        .grid_size = 17,  // Will be recalculated
+        .algorithm = FOV_ALGORITHM_SHADOWCAST
     },
     .spatial = {
         .cell_size = 10,
@@ -64,6 +71,15 @@ static const GameConfig DEFAULT_CONFIG = {
         .enable_statistics = true,
         .enable_pool_allocation = true
     },
+    .profiler = {
+        .enabled = false,
+        .dump_path = ""
+    },
+    .frame = {
+        .mode = FRAME_MODE_EVENT,
+        .frame_ms = 16,
+        .idle_timeout_ms = 1000
+    },
     .loaded = false,
     .config_file_path = ""
 };
@@ -74,11 +90,13 @@ static const struct {
     struct { uint32_t min, max; } max_components;
     struct { uint32_t min, max; } max_systems;
     struct { uint32_t min, max; } initial_component_capacity;
+    struct { uint32_t min, max; } worker_threads;
 } ECS_LIMITS = {
     .max_entities = {100, 10000},
     .max_components = {8, 64},
     .max_systems = {4, 64},
-    .initial_component_capacity = {4, 256}
+    .initial_component_capacity = {4, 256},
+    .worker_threads = {0, 16}
 };
 
 static const struct {
@@ -98,11 +116,27 @@ static const struct {
     struct { uint32_t min, max; } sidebar_width;
     struct { uint32_t min, max; } game_area_width;
     struct { uint32_t min, max; } game_area_height;
+    struct { uint32_t min, max; } text_cache_kb;
 } RENDER_LIMITS = {
     .cell_size = {8, 32},
     .sidebar_width = {8, 30},
-    .game_area_width = {20, 100},
-    .game_area_height = {15, 50}
+    .game_area_width = {20, 200},
+    .game_area_height = {15, 100},
+    .text_cache_kb = {64, 65536}
+};
+
+static const struct {
+    struct { uint32_t min, max; } radius;
+} FOV_LIMITS = {
+    .radius = {1, FOV_MAX_RADIUS}
+};
+
+static const struct {
+    struct { uint32_t min, max; } frame_ms;
+    struct { uint32_t min, max; } idle_timeout_ms;
+} FRAME_LIMITS = {
+    .frame_ms = {1, 1000},
+    .idle_timeout_ms = {0, 60000}
 };
 
 // Helper function to safely get integer from JSON
@@ -164,6 +198,22 @@ static bool load_ecs_config(const cJSON *json, ECSConfig *ecs) {
         return false;
     }
     
+    // Storage backend is optional
+    char storage[16];
+    ecs->storage = DEFAULT_CONFIG.ecs.storage;
+    if (json_get_string(ecs_json, "storage", storage, sizeof(storage))) {
+        if (strcmp(storage, "archetype") == 0) {
+            ecs->storage = ECS_STORAGE_ARCHETYPE;
+        } else if (strcmp(storage, "sparse") != 0) {
+            LOG_WARN("Unknown ecs.storage '%s', using sparse", storage);
+        }
+    }
+    
+    // Worker threads are optional; 0 keeps the scheduler single-threaded
+    if (!json_get_uint32(ecs_json, "worker_threads", &ecs->worker_threads)) {
+        ecs->worker_threads = DEFAULT_CONFIG.ecs.worker_threads;
+    }
+    
     return true;
 }
 
@@ -184,6 +234,9 @@ static bool load_dungeon_config(const cJSON *json, DungeonConfig *dungeon) {
         return false;
     }
     
+    // Seed is optional; 0 keeps clock seeding
+    json_get_uint32(dungeon_json, "seed", &dungeon->seed);
+    
     return true;
 }
 
@@ -209,6 +262,15 @@ static bool load_render_config(const cJSON *json, RenderConfig *render) {
         strcpy(render->window_title, DEFAULT_CONFIG.render.window_title);
     }
     
+    // Headless is optional
+    json_get_bool(render_json, "headless", &render->headless);
+    
+    // Text cache budget is optional
+    json_get_uint32(render_json, "text_cache_kb", &render->text_cache_kb);
+    
+    // Map build thread is optional
+    json_get_bool(render_json, "map_build_thread", &render->map_build_thread);
+    
     return true;
 }
 
@@ -218,6 +280,18 @@ static bool load_remaining_configs(const cJSON *json, struct AppState *app_state
     const cJSON *fov_json = cJSON_GetObjectItemCaseSensitive(json, "fov");
     if (cJSON_IsObject(fov_json)) {
         json_get_uint32(fov_json, "radius", &app_state->config.fov.radius);
+
+        char algorithm[16];
+        if (json_get_string(fov_json, "algorithm", algorithm, sizeof(algorithm))) {
+            if (strcmp(algorithm, "raycast") == 0) {
+                app_state->config.fov.algorithm = FOV_ALGORITHM_RAYCAST;
+            } else if (strcmp(algorithm, "shadowcast") == 0) {
+                app_state->config.fov.algorithm = FOV_ALGORITHM_SHADOWCAST;
+            } else {
+                LOG_WARN("Unknown fov.algorithm '%s', using shadowcast", algorithm);
+                app_state->config.fov.algorithm = FOV_ALGORITHM_SHADOWCAST;
+            }
+        }
     }
     
     // Spatial
@@ -263,6 +337,33 @@ static bool load_remaining_configs(const cJSON *json, struct AppState *app_state
         json_get_bool(mempool_json, "enable_pool_allocation", &app_state->config.mempool.enable_pool_allocation);
     }
     
+    // Profiler
+    const cJSON *profiler_json = cJSON_GetObjectItemCaseSensitive(json, "profiler");
+    if (cJSON_IsObject(profiler_json)) {
+        json_get_bool(profiler_json, "enabled", &app_state->config.profiler.enabled);
+        json_get_string(profiler_json, "dump_path", app_state->config.profiler.dump_path, sizeof(app_state->config.profiler.dump_path));
+    }
+    
+    // Frame scheduler
+    const cJSON *frame_json = cJSON_GetObjectItemCaseSensitive(json, "frame");
+    if (cJSON_IsObject(frame_json)) {
+        char mode[16];
+        if (json_get_string(frame_json, "mode", mode, sizeof(mode))) {
+            if (strcmp(mode, "fixed") == 0) {
+                app_state->config.frame.mode = FRAME_MODE_FIXED;
+            } else if (strcmp(mode, "event") == 0) {
+                app_state->config.frame.mode = FRAME_MODE_EVENT;
+            } else if (strcmp(mode, "adaptive") == 0) {
+                app_state->config.frame.mode = FRAME_MODE_ADAPTIVE;
+            } else {
+                LOG_WARN("Unknown frame.mode '%s', using event", mode);
+                app_state->config.frame.mode = DEFAULT_CONFIG.frame.mode;
+            }
+        }
+        json_get_uint32(frame_json, "frame_ms", &app_state->config.frame.frame_ms);
+        json_get_uint32(frame_json, "idle_timeout_ms", &app_state->config.frame.idle_timeout_ms);
+    }
+    
     return true;
 }
 
@@ -295,6 +396,12 @@ static bool validate_ranges(struct AppState *app_state) {
         valid = false;
     }
     
+    if (app_state->config.ecs.worker_threads > ECS_LIMITS.worker_threads.max) {
+        LOG_ERROR("worker_threads (%u) out of range [%u, %u]", 
+                  app_state->config.ecs.worker_threads, ECS_LIMITS.worker_threads.min, ECS_LIMITS.worker_threads.max);
+        valid = false;
+    }
+    
     // Validate dungeon limits
     if (app_state->config.dungeon.width < DUNGEON_LIMITS.width.min || 
         app_state->config.dungeon.width > DUNGEON_LIMITS.width.max) {
@@ -317,6 +424,61 @@ static bool validate_ranges(struct AppState *app_state) {
         valid = false;
     }
     
+    if (app_state->config.render.sidebar_width < RENDER_LIMITS.sidebar_width.min || 
+        app_state->config.render.sidebar_width > RENDER_LIMITS.sidebar_width.max) {
+        LOG_ERROR("sidebar_width (%u) out of range [%u, %u]", 
+                  app_state->config.render.sidebar_width, RENDER_LIMITS.sidebar_width.min, RENDER_LIMITS.sidebar_width.max);
+        valid = false;
+    }
+    
+    if (app_state->config.render.game_area_width < RENDER_LIMITS.game_area_width.min || 
+        app_state->config.render.game_area_width > RENDER_LIMITS.game_area_width.max) {
+        LOG_ERROR("game_area_width (%u) out of range [%u, %u]", 
+                  app_state->config.render.game_area_width, RENDER_LIMITS.game_area_width.min, RENDER_LIMITS.game_area_width.max);
+        valid = false;
+    }
+    
+    if (app_state->config.render.game_area_height < RENDER_LIMITS.game_area_height.min || 
+        app_state->config.render.game_area_height > RENDER_LIMITS.game_area_height.max) {
+        LOG_ERROR("game_area_height (%u) out of range [%u, %u]", 
+                  app_state->config.render.game_area_height, RENDER_LIMITS.game_area_height.min, RENDER_LIMITS.game_area_height.max);
+        valid = false;
+    }
+    
+    if (app_state->config.render.status_line_height < 1) {
+        LOG_ERROR("status_line_height must be at least 1");
+        valid = false;
+    }
+    
+    if (app_state->config.render.text_cache_kb < RENDER_LIMITS.text_cache_kb.min || 
+        app_state->config.render.text_cache_kb > RENDER_LIMITS.text_cache_kb.max) {
+        LOG_ERROR("text_cache_kb (%u) out of range [%u, %u]", 
+                  app_state->config.render.text_cache_kb, RENDER_LIMITS.text_cache_kb.min, RENDER_LIMITS.text_cache_kb.max);
+        valid = false;
+    }
+    
+    // Validate field of view
+    if (app_state->config.fov.radius < FOV_LIMITS.radius.min || 
+        app_state->config.fov.radius > FOV_LIMITS.radius.max) {
+        LOG_ERROR("fov radius (%u) out of range [%u, %u]", 
+                  app_state->config.fov.radius, FOV_LIMITS.radius.min, FOV_LIMITS.radius.max);
+        valid = false;
+    }
+    
+    // Validate frame pacing
+    if (app_state->config.frame.frame_ms < FRAME_LIMITS.frame_ms.min || 
+        app_state->config.frame.frame_ms > FRAME_LIMITS.frame_ms.max) {
+        LOG_ERROR("frame_ms (%u) out of range [%u, %u]", 
+                  app_state->config.frame.frame_ms, FRAME_LIMITS.frame_ms.min, FRAME_LIMITS.frame_ms.max);
+        valid = false;
+    }
+    
+    if (app_state->config.frame.idle_timeout_ms > FRAME_LIMITS.idle_timeout_ms.max) {
+        LOG_ERROR("idle_timeout_ms (%u) out of range [%u, %u]", 
+                  app_state->config.frame.idle_timeout_ms, FRAME_LIMITS.idle_timeout_ms.min, FRAME_LIMITS.idle_timeout_ms.max);
+        valid = false;
+    }
+    
     return valid;
 }
 
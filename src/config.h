@@ -7,12 +7,33 @@
 // Forward declaration  
 struct AppState;
 
+// Component storage backends selectable via "ecs.storage"
+typedef enum {
+    ECS_STORAGE_SPARSE = 0,       // One sparse-set array per component type
+    ECS_STORAGE_ARCHETYPE         // Chunked SoA tables grouped by component mask
+} ECSStorageMode;
+
+// Field of view algorithms selectable via "fov.algorithm"
+typedef enum {
+    FOV_ALGORITHM_SHADOWCAST = 0, // Symmetric recursive shadowcasting, gap free at any radius
+    FOV_ALGORITHM_RAYCAST         // 80 Bresenham rays; leaves gaps past radius 8
+} FovAlgorithm;
+
+// Main loop pacing selectable via "frame.mode"
+typedef enum {
+    FRAME_MODE_FIXED = 0,         // Run every frame_ms regardless of activity
+    FRAME_MODE_EVENT,             // Block until input or a requested frame (default)
+    FRAME_MODE_ADAPTIVE           // Like event, but vsync paces frames while animating
+} FrameMode;
+
 // Configuration categories for better organization
 typedef struct {
     uint32_t max_entities;
     uint32_t max_components;
     uint32_t max_systems;
     uint32_t initial_component_capacity;
+    ECSStorageMode storage;
+    uint32_t worker_threads;          // System scheduler workers, 0 = run serially
 } ECSConfig;
 
 typedef struct {
@@ -21,6 +42,7 @@ typedef struct {
     uint32_t max_rooms;
     uint32_t min_room_size;
     uint32_t max_room_size;
+    uint32_t seed;                // Generation seed, 0 = seed from the clock
 } DungeonConfig;
 
 typedef struct {
@@ -30,11 +52,15 @@ typedef struct {
     uint32_t game_area_height;    // in cells
     uint32_t status_line_height;  // in cells
     char window_title[64];
+    bool headless;                // Offscreen software renderer, no window or display
+    uint32_t text_cache_kb;       // Texture budget for cached UI strings
+    bool map_build_thread;        // Build gameplay map cells on a worker thread
 } RenderConfig;
 
 typedef struct {
     uint32_t radius;
     uint32_t grid_size;           // calculated: radius * 2 + 1
+    FovAlgorithm algorithm;
 } FieldOfViewConfig;
 
 typedef struct {
@@ -72,6 +98,17 @@ typedef struct {
     bool enable_pool_allocation;     // Global enable/disable for pool allocation
 } MemoryPoolConfig;
 
+typedef struct {
+    bool enabled;                    // Collect per-system and frame timings
+    char dump_path[256];             // Statistics written here on shutdown ("" = none); .json or CSV
+} ProfilerConfig;
+
+typedef struct {
+    FrameMode mode;
+    uint32_t frame_ms;               // Target frame interval while frames are running
+    uint32_t idle_timeout_ms;        // Longest block in event/adaptive mode (0 = until an event)
+} FrameConfig;
+
 // Main configuration structure
 typedef struct {
     ECSConfig ecs;
@@ -83,6 +120,8 @@ typedef struct {
     MessageConfig message;
     MessageViewConfig message_view;
     MemoryPoolConfig mempool;
+    ProfilerConfig profiler;
+    FrameConfig frame;
     
     // Metadata
     bool loaded;
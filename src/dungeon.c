@@ -16,7 +16,8 @@ static void init_tile_info_table(void) {
     // Initialize basic tile info
     tile_info_table[TILE_TYPE_WALL] = (TileInfo){.type = TILE_TYPE_WALL, .is_walkable = false, .symbol = '#', .color = 0x07};
     tile_info_table[TILE_TYPE_FLOOR] = (TileInfo){.type = TILE_TYPE_FLOOR, .is_walkable = true, .symbol = '.', .color = 0x07};
-    tile_info_table[TILE_TYPE_DOOR] = (TileInfo){.type = TILE_TYPE_DOOR, .is_walkable = true, .symbol = '+', .color = 0x06};
+    tile_info_table[TILE_TYPE_DOOR] = (TileInfo){.type = TILE_TYPE_DOOR, .is_walkable = true, .symbol = '\'', .color = 0x06};
+    tile_info_table[TILE_TYPE_DOOR_CLOSED] = (TileInfo){.type = TILE_TYPE_DOOR_CLOSED, .is_walkable = false, .symbol = '+', .color = 0x06};
     tile_info_table[TILE_TYPE_WINDOW] = (TileInfo){.type = TILE_TYPE_WINDOW, .is_walkable = false, .symbol = '=', .color = 0x06};
     tile_info_table[TILE_TYPE_STAIRS_UP] = (TileInfo){.type = TILE_TYPE_STAIRS_UP, .is_walkable = true, .symbol = '<', .color = 0x04};
     tile_info_table[TILE_TYPE_STAIRS_DOWN] = (TileInfo){.type = TILE_TYPE_STAIRS_DOWN, .is_walkable = true, .symbol = '>', .color = 0x04};
@@ -115,12 +116,13 @@ void dungeon_init(Dungeon *dungeon) {
             dungeon->tiles[x][y].x = x;
             dungeon->tiles[x][y].y = y;
             dungeon->tiles[x][y].type = TILE_TYPE_WALL;
-            dungeon->tiles[x][y].explored = false;
             dungeon->tiles[x][y].actor = INVALID_ENTITY;
             dungeon->tiles[x][y].item = INVALID_ENTITY;
         }
     }
     
+    memset(dungeon->explored, 0, sizeof(dungeon->explored));
+    
     // Initialize room array
     memset(dungeon->rooms, 0, sizeof(dungeon->rooms));
     
@@ -129,11 +131,20 @@ void dungeon_init(Dungeon *dungeon) {
     dungeon->stairs_up_y = -1;
     dungeon->stairs_down_x = -1;
     dungeon->stairs_down_y = -1;
+    
+    // Every tile may have changed; the version keeps counting so FOVs from the last map never match
+    dungeon->opacity_version++;
+    dungeon->edit_log_floor = dungeon->opacity_version;
 }
 
 void dungeon_generate(Dungeon *dungeon) {
+    dungeon_generate_seeded(dungeon, (unsigned int)time(NULL));
+}
+
+void dungeon_generate_seeded(Dungeon *dungeon, unsigned int seed) {
     // Seed random number generator
-    srand(time(NULL));
+    srand(seed);
+    LOG_INFO("Generating dungeon with seed %u", seed);
     
     // Generate rooms
     int attempts = 0;
@@ -207,11 +218,17 @@ void dungeon_generate(Dungeon *dungeon) {
             int door_x = room->x + rand() % room->width;
             int door_y = room->y + rand() % room->height;
             
-            if (door_x >= 0 && door_x < DUNGEON_WIDTH && door_y >= 0 && door_y < DUNGEON_HEIGHT) {
-                dungeon->tiles[door_x][door_y].type = TILE_TYPE_DOOR;
+            // Doors start closed, so keep them off the stairs
+            if (door_x >= 0 && door_x < DUNGEON_WIDTH && door_y >= 0 && door_y < DUNGEON_HEIGHT &&
+                dungeon->tiles[door_x][door_y].type == TILE_TYPE_FLOOR) {
+                dungeon->tiles[door_x][door_y].type = TILE_TYPE_DOOR_CLOSED;
             }
         }
     }
+    
+    // Carving and doors are a whole-map change like init
+    dungeon->opacity_version++;
+    dungeon->edit_log_floor = dungeon->opacity_version;
 }
 
 void dungeon_cleanup(Dungeon *dungeon) {
@@ -242,20 +259,37 @@ bool dungeon_is_walkable(Dungeon *dungeon, int x, int y) {
     return false;
 }
 
+void dungeon_set_tile_type(Dungeon *dungeon, int x, int y, TileType type) {
+    Tile *tile = dungeon ? dungeon_get_tile(dungeon, x, y) : NULL;
+    if (!tile || tile->type == type) return;
+    
+    bool was_blocking = dungeon_tile_blocks_sight(tile->type);
+    tile->type = type;
+    if (was_blocking != dungeon_tile_blocks_sight(type)) {
+        dungeon->opacity_version++;
+        dungeon->edit_log[dungeon->opacity_version % DUNGEON_EDIT_LOG_SIZE] = (DungeonEdit){x, y};
+    }
+}
+
 // Check if a position has been explored
 bool dungeon_is_explored(Dungeon *dungeon, int x, int y) {
     Tile *tile = dungeon_get_tile(dungeon, x, y);
-    return tile ? tile->explored : false;
+    return tile ? bitrow_test(dungeon->explored[x], y) : false;
 }
 
 // Mark a position as explored
 void dungeon_mark_explored(Dungeon *dungeon, int x, int y) {
     Tile *tile = dungeon_get_tile(dungeon, x, y);
     if (tile) {
-        tile->explored = true;
+        bitrow_set(dungeon->explored[x], y);
     }
 }
 
+// Tiles explored so far
+uint32_t dungeon_explored_count(const Dungeon *dungeon) {
+    return dungeon ? bitrow_popcount(&dungeon->explored[0][0], (size_t)DUNGEON_WIDTH * DUNGEON_COLUMN_WORDS) : 0;
+}
+
 // Tile-based entity management functions
 void dungeon_place_entity_at_position(Dungeon *dungeon, Entity entity, int x, int y) {
     if (!dungeon) {
@@ -280,7 +314,7 @@ void dungeon_place_entity_at_position(Dungeon *dungeon, Entity entity, int x, in
     AppState *app_state = appstate_get();
     if (!app_state) return;
     
-    Actor *actor = (Actor *)entity_get_component(app_state, entity, component_get_id(app_state, "Actor"));
+    Actor *actor = ECS_GET(app_state, entity, Actor);
     if (actor) {
         tile->actor = entity;
     } else {
@@ -329,6 +363,17 @@ bool dungeon_get_entities_at_position(Dungeon *dungeon, int x, int y, Entity *ac
     
     Tile *tile = &dungeon->tiles[x][y];
     
+    // Drop slots whose entity was destroyed or recycled since it was placed here
+    AppState *app_state = appstate_get();
+    if (app_state) {
+        if (tile->actor != INVALID_ENTITY && !entity_exists(app_state, tile->actor)) {
+            tile->actor = INVALID_ENTITY;
+        }
+        if (tile->item != INVALID_ENTITY && !entity_exists(app_state, tile->item)) {
+            tile->item = INVALID_ENTITY;
+        }
+    }
+    
     if (actor_out) *actor_out = tile->actor;
     if (item_out) *item_out = tile->item;
     
@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include "baseds.h"
 #include "types.h"
+#include "bitgrid.h"
 
 // Compile-time maximum limits (for array declarations)
 // Runtime limits are controlled by configuration system
@@ -19,6 +20,13 @@
 #define MAX_ROOMS_COMPILE_TIME 100
 #define MAX_ROOMS MAX_ROOMS_COMPILE_TIME
 
+// Words per dungeon column in per-tile bitsets (bit y of column x)
+#define DUNGEON_COLUMN_WORDS BITGRID_WORDS(DUNGEON_HEIGHT)
+
+// Opacity edits remembered for FOV cache invalidation; a cached FOV more edits
+// behind than this is recalculated
+#define DUNGEON_EDIT_LOG_SIZE 64
+
 // Room size limits (use config system at runtime)
 #define MIN_ROOM_SIZE 3
 #define MAX_ROOM_SIZE 50
@@ -26,7 +34,8 @@
 typedef enum {
     TILE_TYPE_WALL,
     TILE_TYPE_FLOOR,
-    TILE_TYPE_DOOR,
+    TILE_TYPE_DOOR,           // Open door
+    TILE_TYPE_DOOR_CLOSED,    // Blocks movement and sight until something walks into it
     TILE_TYPE_WINDOW,
     TILE_TYPE_STAIRS_UP,
     TILE_TYPE_STAIRS_DOWN,
@@ -51,16 +60,32 @@ typedef struct {
     int x;
     int y;
     TileType type;
-    bool explored;
     Entity actor; // there can be only one actor per tile.
     Entity item; // there can be only one item per tile -> but this may be a stack.
     // entity_count and entity fields removed
 } Tile;
 
+// A tile whose sight blocking changed
+typedef struct {
+    int x;
+    int y;
+} DungeonEdit;
+
 typedef struct {
     int width;
     int height;
     Tile tiles[DUNGEON_WIDTH][DUNGEON_HEIGHT];
+    
+    // Tiles the player has seen, laid out like tiles: one bit row per column x
+    uint64_t explored[DUNGEON_WIDTH][DUNGEON_COLUMN_WORDS];
+    
+    // Bumped whenever a tile starts or stops blocking sight. Edit v is kept in
+    // edit_log[v % DUNGEON_EDIT_LOG_SIZE]; versions up to edit_log_floor were whole-map
+    // changes (init, generation) with no single tile to check.
+    uint32_t opacity_version;
+    uint32_t edit_log_floor;
+    DungeonEdit edit_log[DUNGEON_EDIT_LOG_SIZE];
+    
     Room rooms[MAX_ROOMS];
     int room_count;
     int stairs_up_x;
@@ -71,15 +96,23 @@ typedef struct {
 
 void dungeon_init(Dungeon *dungeon);
 void dungeon_generate(Dungeon *dungeon);
+void dungeon_generate_seeded(Dungeon *dungeon, unsigned int seed); // Same seed, same layout
 void dungeon_cleanup(Dungeon *dungeon);
 
 Tile* dungeon_get_tile(Dungeon *dungeon, int x, int y);
 TileInfo* dungeon_get_tile_info(TileType type);
 bool dungeon_is_walkable(Dungeon *dungeon, int x, int y);
 
+// Walls and closed doors block line of sight; everything else is see-through
+static inline bool dungeon_tile_blocks_sight(TileType type) { return type == TILE_TYPE_WALL || type == TILE_TYPE_DOOR_CLOSED; }
+
+// Change a tile's type (open a door, dig a wall); logs the edit when sight blocking changes
+void dungeon_set_tile_type(Dungeon *dungeon, int x, int y, TileType type);
+
 // Explored map functions
 bool dungeon_is_explored(Dungeon *dungeon, int x, int y);
 void dungeon_mark_explored(Dungeon *dungeon, int x, int y);
+uint32_t dungeon_explored_count(const Dungeon *dungeon);
 
 // Tile-based entity management functions
 void dungeon_place_entity_at_position(Dungeon *dungeon, Entity entity, int x, int y);
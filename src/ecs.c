@@ -8,6 +8,10 @@
 #include "config.h"
 #include "mempool.h"
 #include "error.h"
+#include "archetype.h"
+#include "thread_pool.h"
+#include "ecs_commands.h"
+#include "profiler.h"
 
 // Hash table for component name lookups
 #define COMPONENT_HASH_TABLE_SIZE 64
@@ -108,26 +112,27 @@ typedef struct {
 // SparseComponentArray is now defined in appstate.h
 
 // Forward declarations for sparse array functions
-static bool sparse_array_init(SparseComponentArray *array, size_t component_size, AppState *app_state);
-static void sparse_array_cleanup(SparseComponentArray *array, AppState *app_state);
+static bool sparse_array_init(SparseComponentArray *array, size_t component_size);
+static void sparse_array_cleanup(SparseComponentArray *array);
 static bool sparse_array_resize(SparseComponentArray *array, uint32_t new_capacity);
-static bool sparse_array_add(SparseComponentArray *array, Entity entity, void *component_data, AppState *app_state);
+static bool sparse_array_add(SparseComponentArray *array, Entity entity, void *component_data);
 static void* sparse_array_get(SparseComponentArray *array, Entity entity);
-static bool sparse_array_remove(SparseComponentArray *array, Entity entity, AppState *app_state);
+static bool sparse_array_remove(SparseComponentArray *array, Entity entity);
 
 // ComponentRegistryEntry is now defined in appstate.h
 
 // Sparse component array utility functions
-static bool sparse_array_init(SparseComponentArray *array, size_t component_size, AppState *app_state) {
+// Component bytes are packed contiguously in dense_data, slot i at i * component_size.
+static bool sparse_array_init(SparseComponentArray *array, size_t component_size) {
     array->sparse = calloc(MAX_ENTITIES, sizeof(uint32_t));
     array->dense_entities = malloc(INITIAL_COMPONENT_CAPACITY * sizeof(uint32_t));
-    array->dense_components = malloc(INITIAL_COMPONENT_CAPACITY * sizeof(void*));
+    array->dense_data = malloc(INITIAL_COMPONENT_CAPACITY * component_size);
     array->count = 0;
     array->capacity = INITIAL_COMPONENT_CAPACITY;
     array->component_size = component_size;
     
-    if (!array->sparse || !array->dense_entities || !array->dense_components) {
-        sparse_array_cleanup(array, app_state);
+    if (!array->sparse || !array->dense_entities || !array->dense_data) {
+        sparse_array_cleanup(array);
         return false;
     }
     
@@ -139,7 +144,7 @@ static bool sparse_array_init(SparseComponentArray *array, size_t component_size
     return true;
 }
 
-static void sparse_array_cleanup(SparseComponentArray *array, AppState *app_state) {
+static void sparse_array_cleanup(SparseComponentArray *array) {
     if (array->sparse) {
         free(array->sparse);
         array->sparse = NULL;
@@ -148,15 +153,9 @@ static void sparse_array_cleanup(SparseComponentArray *array, AppState *app_stat
         free(array->dense_entities);
         array->dense_entities = NULL;
     }
-    if (array->dense_components) {
-        // Free individual component data using memory pool
-        for (uint32_t i = 0; i < array->count; i++) {
-            if (array->dense_components[i]) {
-                pool_free(array->dense_components[i], app_state);
-            }
-        }
-        free(array->dense_components);
-        array->dense_components = NULL;
+    if (array->dense_data) {
+        free(array->dense_data);
+        array->dense_data = NULL;
     }
     array->count = 0;
     array->capacity = 0;
@@ -164,27 +163,35 @@ static void sparse_array_cleanup(SparseComponentArray *array, AppState *app_stat
 
 static bool sparse_array_resize(SparseComponentArray *array, uint32_t new_capacity) {
     uint32_t *new_entities = realloc(array->dense_entities, new_capacity * sizeof(uint32_t));
-    void **new_components = realloc(array->dense_components, new_capacity * sizeof(void*));
+    if (!new_entities) {
+        return false;
+    }
+    array->dense_entities = new_entities;
     
-    if (!new_entities || !new_components) {
+    uint8_t *new_data = realloc(array->dense_data, new_capacity * array->component_size);
+    if (!new_data) {
         return false;
     }
+    array->dense_data = new_data;
     
-    array->dense_entities = new_entities;
-    array->dense_components = new_components;
     array->capacity = new_capacity;
     return true;
 }
 
-static bool sparse_array_add(SparseComponentArray *array, Entity entity, void *component_data, AppState *app_state) {
+static bool sparse_array_add(SparseComponentArray *array, Entity entity, void *component_data) {
+    uint32_t index = ENTITY_INDEX(entity);
+    if (index >= MAX_ENTITIES) {
+        return false;
+    }
+    
     // Check if entity already has this component
-    if (entity < MAX_ENTITIES && array->sparse[entity] != UINT32_MAX) {
+    if (array->sparse[index] != UINT32_MAX) {
         // Update existing component
-        memcpy(array->dense_components[array->sparse[entity]], component_data, array->component_size);
+        memcpy(array->dense_data + (size_t)array->sparse[index] * array->component_size, component_data, array->component_size);
         return true;
     }
     
-    // Resize if needed
+    // Grow geometrically if needed
     if (array->count >= array->capacity) {
         uint32_t new_capacity = array->capacity * 2;
         if (!sparse_array_resize(array, new_capacity)) {
@@ -192,72 +199,60 @@ static bool sparse_array_add(SparseComponentArray *array, Entity entity, void *c
         }
     }
     
-    // Allocate memory for new component using memory pool
-    void *new_component = pool_malloc(array->component_size, app_state);
-    if (!new_component) {
-        return false;
-    }
-    
-    // Copy component data
-    memcpy(new_component, component_data, array->component_size);
-    
-    // Add to dense arrays
+    // Append to dense arrays
     uint32_t dense_index = array->count;
     array->dense_entities[dense_index] = entity;
-    array->dense_components[dense_index] = new_component;
+    memcpy(array->dense_data + (size_t)dense_index * array->component_size, component_data, array->component_size);
     
     // Update sparse mapping
-    if (entity < MAX_ENTITIES) {
-        array->sparse[entity] = dense_index;
-    }
+    array->sparse[index] = dense_index;
     
     array->count++;
     return true;
 }
 
 static void* sparse_array_get(SparseComponentArray *array, Entity entity) {
-    if (entity >= MAX_ENTITIES) {
+    uint32_t index = ENTITY_INDEX(entity);
+    if (index >= MAX_ENTITIES) {
         return NULL;
     }
     
-    uint32_t dense_index = array->sparse[entity];
+    uint32_t dense_index = array->sparse[index];
     if (dense_index == UINT32_MAX || dense_index >= array->count) {
         return NULL;
     }
     
-    return array->dense_components[dense_index];
+    return array->dense_data + (size_t)dense_index * array->component_size;
 }
 
-static bool sparse_array_remove(SparseComponentArray *array, Entity entity, AppState *app_state) {
-    if (entity >= MAX_ENTITIES) {
+static bool sparse_array_remove(SparseComponentArray *array, Entity entity) {
+    uint32_t index = ENTITY_INDEX(entity);
+    if (index >= MAX_ENTITIES) {
         return false;
     }
     
-    uint32_t dense_index = array->sparse[entity];
+    uint32_t dense_index = array->sparse[index];
     if (dense_index == UINT32_MAX || dense_index >= array->count) {
         return false;
     }
     
-    // Free the component data using memory pool
-    if (array->dense_components[dense_index]) {
-        pool_free(array->dense_components[dense_index], app_state);
-    }
-    
     // Move last element to fill the gap (swap-remove)
     uint32_t last_index = array->count - 1;
     if (dense_index != last_index) {
         array->dense_entities[dense_index] = array->dense_entities[last_index];
-        array->dense_components[dense_index] = array->dense_components[last_index];
+        memmove(array->dense_data + (size_t)dense_index * array->component_size,
+                array->dense_data + (size_t)last_index * array->component_size,
+                array->component_size);
         
         // Update sparse mapping for moved entity
-        Entity moved_entity = array->dense_entities[dense_index];
-        if (moved_entity < MAX_ENTITIES) {
-            array->sparse[moved_entity] = dense_index;
+        uint32_t moved_index = ENTITY_INDEX(array->dense_entities[dense_index]);
+        if (moved_index < MAX_ENTITIES) {
+            array->sparse[moved_index] = dense_index;
         }
     }
     
     // Clear sparse mapping for removed entity
-    array->sparse[entity] = UINT32_MAX;
+    array->sparse[index] = UINT32_MAX;
     array->count--;
     
     return true;
@@ -365,6 +360,52 @@ static bool validate_system_dependencies(struct AppState *app_state) {
     return true;
 }
 
+// Two systems conflict when one writes what the other reads or writes.
+// Main-thread systems conflict with everything, so they always run alone.
+static bool systems_conflict(const System *a, const System *b) {
+    if (a->threading == SYSTEM_THREADING_MAIN || b->threading == SYSTEM_THREADING_MAIN) {
+        return true;
+    }
+    return (a->write_mask & (b->read_mask | b->write_mask)) != 0 ||
+           (b->write_mask & a->read_mask) != 0;
+}
+
+static bool system_depends_on(const System *system, const System *other) {
+    for (uint32_t d = 0; d < system->dependency_count; d++) {
+        if (strcmp_ci(system->dependencies[d], other->name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Assign DAG levels over the sorted order: each system lands one level after the
+// latest earlier system it conflicts with or depends on. Systems sharing a level
+// can run concurrently; levels run in order.
+static void build_system_levels(struct AppState *app_state) {
+    uint32_t level_count = 0;
+    
+    for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+        System *system = &app_state->ecs.systems.systems[i];
+        uint32_t level = 0;
+        
+        for (uint32_t j = 0; j < i; j++) {
+            System *earlier = &app_state->ecs.systems.systems[j];
+            if (earlier->level + 1 > level &&
+                (systems_conflict(system, earlier) || system_depends_on(system, earlier))) {
+                level = earlier->level + 1;
+            }
+        }
+        
+        system->level = level;
+        if (level + 1 > level_count) {
+            level_count = level + 1;
+        }
+    }
+    
+    app_state->ecs.systems.level_count = level_count;
+}
+
 static void topological_sort_systems(struct AppState *app_state) {
     uint32_t in_degree[MAX_SYSTEMS] = {0};
     uint32_t queue[MAX_SYSTEMS];
@@ -434,13 +475,16 @@ static void topological_sort_systems(struct AppState *app_state) {
     
     app_state->ecs.systems.needs_sorting = false;
     
+    build_system_levels(app_state);
+    
     LOG_INFO("Systems sorted by dependencies and priority:");
     for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
-        LOG_INFO("  %d. %s (priority: %d, order: %d)", 
+        LOG_INFO("  %d. %s (priority: %d, order: %d, level: %d)", 
                  i + 1,
                  app_state->ecs.systems.systems[i].name,
                  app_state->ecs.systems.systems[i].priority,
-                 app_state->ecs.systems.systems[i].execution_order);
+                 app_state->ecs.systems.systems[i].execution_order,
+                 app_state->ecs.systems.systems[i].level);
     }
 }
 
@@ -456,50 +500,142 @@ ECS system implementation:
    - system_count: number of registered systems
 */
 
-// Helper function to check if entity is in active stack
+// Entity liveness bitset helpers (indexed by slot, not by handle)
+#define ALIVE_WORD(index) ((index) >> 6)
+#define ALIVE_BIT(index) (UINT64_C(1) << ((index) & 63))
+#define ALIVE_WORD_COUNT ((MAX_ENTITIES + 63) / 64)
+
+// Set in generations[] while a slot is free; never matches a handle's 12-bit generation
+#define ECS_GENERATION_DEAD 0x8000u
+
+// Helper function to check if an entity handle is live - a single generation compare.
+// Handles to destroyed or recycled slots carry an old generation and are rejected.
 static bool entity_is_active(struct AppState *app_state, Entity entity) {
-    if (!app_state) return false;
+    uint32_t index = ENTITY_INDEX(entity);
+    if (!app_state || index >= MAX_ENTITIES) return false;
     
-    ll_node *current = app_state->ecs.active_entities.list.head;
-    while (current != NULL) {
-        Entity *active_entity = (Entity *)current->data;
-        if (*active_entity == entity) {
-            return true;
+    return app_state->ecs.generations[index] == ENTITY_GENERATION(entity);
+}
+
+// ===== SYSTEM QUERIES =====
+
+static void system_query_insert(System *system, Entity entity) {
+    uint32_t index = ENTITY_INDEX(entity);
+    if (system->query_sparse[index] != UINT32_MAX) return;
+    
+    system->query_sparse[index] = system->query_count;
+    system->query_entities[system->query_count++] = entity;
+}
+
+static void system_query_erase(System *system, Entity entity) {
+    uint32_t index = ENTITY_INDEX(entity);
+    uint32_t position = system->query_sparse[index];
+    if (position == UINT32_MAX) return;
+    system->query_sparse[index] = UINT32_MAX;
+    
+    // Mid-walk a swap-remove would move an entity the walk has already visited into
+    // a slot it has not reached yet, so leave a hole and compact once the walk ends.
+    // Entries appended during the walk are never visited and swap-remove as usual.
+    if (position < system->query_walk_end) {
+        system->query_entities[position] = INVALID_ENTITY;
+        system->query_holes++;
+        return;
+    }
+    
+    // Swap-remove, keeping the moved entity's back-reference current
+    Entity last = system->query_entities[--system->query_count];
+    system->query_entities[position] = last;
+    if (last != entity) {
+        system->query_sparse[ENTITY_INDEX(last)] = position;
+    }
+}
+
+// Close the holes left by erases during a walk, keeping the remaining order
+static void system_query_compact(System *system) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < system->query_count; i++) {
+        Entity entity = system->query_entities[i];
+        if (entity == INVALID_ENTITY) continue;
+        
+        system->query_entities[count] = entity;
+        system->query_sparse[ENTITY_INDEX(entity)] = count++;
+    }
+    system->query_count = count;
+    system->query_holes = 0;
+}
+
+// Keep every system's cached query in step with an entity's liveness/mask change.
+// Only the sparse backend keeps per-entity queries; archetype queries track archetypes instead.
+static void system_queries_update(struct AppState *app_state, Entity entity,
+                                  bool was_alive, uint32_t old_mask, bool is_alive, uint32_t new_mask) {
+    if (app_state->ecs.archetypes) return;
+    
+    for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+        System *system = &app_state->ecs.systems.systems[i];
+        uint32_t mask = system->component_mask;
+        bool matched = was_alive && (old_mask & mask) == mask;
+        bool matches = is_alive && (new_mask & mask) == mask;
+        
+        if (matches && !matched) {
+            system_query_insert(system, entity);
+        } else if (matched && !matches) {
+            system_query_erase(system, entity);
         }
-        current = current->next;
     }
-    return false;
 }
 
-static void entity_remove_from_active(struct AppState *app_state, Entity entity) {
-    if (!app_state) return;
+// Build a system's query storage and seed it with the entities that already match
+static bool system_query_init(struct AppState *app_state, System *system) {
+    system->query_count = 0;
+    system->query_walk_end = 0;
+    system->query_holes = 0;
+    system->query_archetype_count = 0;
+    system->query_archetypes_scanned = 0;
+    system->query_entities = NULL;
+    system->query_sparse = NULL;
+    system->query_archetypes = NULL;
+    
+    if (app_state->ecs.archetypes) {
+        system->query_archetypes = malloc(ARCHETYPE_MAX * sizeof(uint32_t));
+        system->query_entities = malloc(MAX_ENTITIES * sizeof(Entity));
+        return system->query_archetypes != NULL && system->query_entities != NULL;
+    }
+    
+    // Holes (at most one per walked entry) and live entries can coexist until a walk ends
+    system->query_entities = malloc(2 * MAX_ENTITIES * sizeof(Entity));
+    system->query_sparse = malloc(MAX_ENTITIES * sizeof(uint32_t));
+    if (!system->query_entities || !system->query_sparse) {
+        return false;
+    }
     
-    ll_node *current = app_state->ecs.active_entities.list.head;
-    ll_node *prev = NULL;
-    
-    while (current != NULL) {
-        Entity *active_entity = (Entity *)current->data;
-        if (*active_entity == entity) {
-            // Remove this node
-            if (prev == NULL) {
-                // First node
-                app_state->ecs.active_entities.list.head = current->next;
-                if (app_state->ecs.active_entities.list.head == NULL) {
-                    app_state->ecs.active_entities.list.tail = NULL;
-                }
-            } else {
-                prev->next = current->next;
-                if (current->next == NULL) {
-                    app_state->ecs.active_entities.list.tail = prev;
-                }
+    for (uint32_t i = 0; i < MAX_ENTITIES; i++) {
+        system->query_sparse[i] = UINT32_MAX;
+    }
+    
+    for (uint32_t word = 0; word < ALIVE_WORD_COUNT; word++) {
+        uint64_t bits = app_state->ecs.alive[word];
+        while (bits != 0) {
+            uint32_t index = (word << 6) + (uint32_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+            
+            if ((app_state->ecs.components.component_active[index] & system->component_mask) == system->component_mask) {
+                system_query_insert(system, ENTITY_MAKE(index, app_state->ecs.generations[index]));
             }
-            pool_free(current, app_state);
-            app_state->ecs.active_entities.list.size--;
-            return;
         }
-        prev = current;
-        current = current->next;
     }
+    
+    return true;
+}
+
+static void system_query_cleanup(System *system) {
+    free(system->query_entities);
+    free(system->query_sparse);
+    free(system->query_archetypes);
+    system->query_entities = NULL;
+    system->query_sparse = NULL;
+    system->query_archetypes = NULL;
+    system->query_count = 0;
+    system->query_archetype_count = 0;
 }
 
 void ecs_init(struct AppState *app_state) {
@@ -525,11 +661,25 @@ void ecs_init(struct AppState *app_state) {
     // Register components - all components must be registered during ecs_init
     components_init(app_state);
 
+    // Archetype backend replaces the per-component sparse arrays
+    app_state->ecs.archetypes = NULL;
+    if (app_state->config.ecs.storage == ECS_STORAGE_ARCHETYPE) {
+        size_t component_sizes[MAX_COMPONENTS];
+        for (uint32_t i = 0; i < app_state->ecs.components.component_count; i++) {
+            component_sizes[i] = app_state->ecs.components.component_info[i].data_size;
+        }
+        app_state->ecs.archetypes = archetype_storage_create(component_sizes, app_state->ecs.components.component_count, MAX_ENTITIES);
+        if (!app_state->ecs.archetypes) {
+            LOG_ERROR("Failed to create archetype storage");
+            return;
+        }
+    }
+
     // Initialize sparse component arrays after components are registered
     size_t total_memory = 0;
-    for (uint32_t i = 0; i < app_state->ecs.components.component_count; i++) {
+    for (uint32_t i = 0; i < app_state->ecs.components.component_count && !app_state->ecs.archetypes; i++) {
         if (!sparse_array_init(&app_state->ecs.components.component_arrays[i], 
-                              app_state->ecs.components.component_info[i].data_size, app_state)) {
+                              app_state->ecs.components.component_info[i].data_size)) {
             LOG_ERROR("Failed to initialize sparse array for component %s", 
                       app_state->ecs.components.component_info[i].name);
             return;
@@ -538,7 +688,7 @@ void ecs_init(struct AppState *app_state) {
         // Calculate initial memory usage (just the sparse array overhead)
         size_t component_overhead = (MAX_ENTITIES * sizeof(uint32_t)) + // sparse array
                                    (INITIAL_COMPONENT_CAPACITY * sizeof(uint32_t)) + // dense entities
-                                   (INITIAL_COMPONENT_CAPACITY * sizeof(void*)); // dense components
+                                   (INITIAL_COMPONENT_CAPACITY * app_state->ecs.components.component_info[i].data_size); // packed component data
         total_memory += component_overhead;
         
         LOG_INFO("Initialized sparse storage for component '%s' (initial capacity: %d entities)", 
@@ -552,18 +702,43 @@ void ecs_init(struct AppState *app_state) {
     LOG_INFO("Memory savings: ~%.1fMB compared to dense allocation", 
              (684000.0 - total_memory) / (1024 * 1024));
 
-    // Initialize entity stacks
-    stack_init(&app_state->ecs.active_entities, sizeof(Entity));
-    stack_init(&app_state->ecs.inactive_entities, sizeof(Entity));
+    // Initialize entity liveness bitset, generations and free list
+    memset(app_state->ecs.alive, 0, sizeof(app_state->ecs.alive));
+    for (uint32_t i = 0; i < MAX_ENTITIES; i++) {
+        app_state->ecs.generations[i] = ECS_GENERATION_DEAD;
+    }
+    app_state->ecs.active_count = 0;
     
-    // Push all entity IDs to inactive stack (in reverse order so they pop in order)
-    for (int i = MAX_ENTITIES - 1; i >= 0; i--) {
-        Entity entity_id = i;
-        stack_push(&app_state->ecs.inactive_entities, &entity_id);
+    // Push all entity IDs to the free list (in reverse order so they pop in order)
+    uint32_t max_entities = config_get_max_entities(app_state);
+    if (max_entities > MAX_ENTITIES) {
+        max_entities = MAX_ENTITIES;
+    }
+    app_state->ecs.free_count = 0;
+    for (uint32_t i = max_entities; i > 0; i--) {
+        app_state->ecs.free_list[app_state->ecs.free_count++] = i - 1;
+    }
+
+    // Worker threads for the system scheduler
+    app_state->ecs.workers = NULL;
+    app_state->ecs.jobs = NULL;
+    app_state->ecs.job_capacity = 0;
+    if (app_state->config.ecs.worker_threads > 0) {
+        app_state->ecs.workers = thread_pool_create(app_state->config.ecs.worker_threads);
+        if (!app_state->ecs.workers) {
+            LOG_WARN("Failed to start %u worker threads, running systems serially", app_state->config.ecs.worker_threads);
+        }
+    }
+
+    // One command buffer for the main thread plus one per worker
+    if (!ecs_commands_init(app_state, 1 + thread_pool_worker_count(app_state->ecs.workers))) {
+        LOG_ERROR("Failed to create ECS command buffers");
+        return;
     }
 
     app_state->ecs.initialized = true;
-    LOG_INFO("ECS initialized with %d components using sparse storage", app_state->ecs.components.component_count);
+    LOG_INFO("ECS initialized with %d components using %s storage", app_state->ecs.components.component_count,
+             app_state->ecs.archetypes ? "archetype" : "sparse");
 }
 
 void ecs_shutdown(struct AppState *app_state) {
@@ -574,13 +749,46 @@ void ecs_shutdown(struct AppState *app_state) {
     
     // Cleanup sparse component arrays
     for (uint32_t i = 0; i < app_state->ecs.components.component_count; i++) {
-        sparse_array_cleanup(&app_state->ecs.components.component_arrays[i], app_state);
+        sparse_array_cleanup(&app_state->ecs.components.component_arrays[i]);
+    }
+    
+    // Stop worker threads before tearing down the data they touch
+    thread_pool_destroy(app_state->ecs.workers);
+    app_state->ecs.workers = NULL;
+    free(app_state->ecs.jobs);
+    app_state->ecs.jobs = NULL;
+    app_state->ecs.job_capacity = 0;
+    
+    ecs_commands_cleanup(app_state);
+    
+    // Cleanup cached system queries and timing history
+    for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+        system_query_cleanup(&app_state->ecs.systems.systems[i]);
+        profiler_system_profile_destroy(app_state->ecs.systems.systems[i].profile);
+        app_state->ecs.systems.systems[i].profile = NULL;
     }
+    app_state->ecs.systems.system_count = 0;
+    
+    // Cleanup archetype storage
+    archetype_storage_destroy(app_state->ecs.archetypes);
+    app_state->ecs.archetypes = NULL;
     
     // Cleanup component hash table
     component_hash_table_cleanup(&app_state->ecs.components.name_lookup, app_state);
     
-    LOG_INFO("ECS shutdown complete - sparse storage cleaned up");
+    app_state->ecs.initialized = false;
+    LOG_INFO("ECS shutdown complete - component storage cleaned up");
+}
+
+// Structural changes made directly from a pool worker would race the other workers
+// walking the same storage; they have to be recorded with ecs_cmd_* instead.
+static bool ecs_structural_change_allowed(struct AppState *app_state, const char *operation) {
+    if (thread_pool_current_worker(app_state->ecs.workers) == THREAD_POOL_NOT_WORKER) {
+        return true;
+    }
+    LOG_ERROR("%s called on a worker thread; record it with the ecs_cmd_* equivalent", operation);
+    ERROR_SET(RESULT_ERROR_INVALID_PARAMETER, "%s called on a worker thread", operation);
+    return false;
 }
 
 Entity entity_create(struct AppState *app_state) {
@@ -594,21 +802,29 @@ Entity entity_create(struct AppState *app_state) {
         return INVALID_ENTITY;
     }
     
-    // Check if we have any inactive entities
-    if (stack_empty(&app_state->ecs.inactive_entities)) {
+    if (!ecs_structural_change_allowed(app_state, "entity_create")) {
+        return INVALID_ENTITY;
+    }
+    
+    // Check if we have any free entity IDs
+    if (app_state->ecs.free_count == 0) {
         LOG_ERROR("Maximum entities reached");
         return INVALID_ENTITY;
     }
     
-    // Pop entity ID from inactive stack
-    Entity *entity_ptr = (Entity *)stack_top(&app_state->ecs.inactive_entities);
-    Entity entity_id = *entity_ptr;
-    stack_pop(&app_state->ecs.inactive_entities);
+    // Pop slot index from the free list and revive it at its current generation
+    uint32_t index = app_state->ecs.free_list[--app_state->ecs.free_count];
+    uint16_t generation = app_state->ecs.generations[index] & ENTITY_GENERATION_MASK;
+    app_state->ecs.generations[index] = generation;
+    
+    // Mark as alive
+    app_state->ecs.alive[ALIVE_WORD(index)] |= ALIVE_BIT(index);
+    app_state->ecs.active_count++;
     
-    // Add to active stack
-    stack_push(&app_state->ecs.active_entities, &entity_id);
+    Entity entity = ENTITY_MAKE(index, generation);
+    system_queries_update(app_state, entity, false, 0, true, 0);
     
-    return entity_id;
+    return entity;
 }
 
 void entity_destroy(struct AppState *app_state, Entity entity) {
@@ -617,21 +833,39 @@ void entity_destroy(struct AppState *app_state, Entity entity) {
         return;
     }
     
-    if (entity >= config_get_max_entities(app_state) || !entity_is_active(app_state, entity)) return;
+    if (!entity_is_active(app_state, entity)) return;
+    if (!ecs_structural_change_allowed(app_state, "entity_destroy")) return;
+    
+    uint32_t index = ENTITY_INDEX(entity);
+    
+    system_queries_update(app_state, entity, true, app_state->ecs.components.component_active[index], false, 0);
+    
+    // Release component storage so the slot starts clean when recycled
+    if (app_state->ecs.archetypes) {
+        archetype_set_mask(app_state->ecs.archetypes, entity, 0);
+    } else {
+        uint32_t mask = app_state->ecs.components.component_active[index];
+        for (uint32_t c = 0; c < app_state->ecs.components.component_count; c++) {
+            if (mask & app_state->ecs.components.component_info[c].bit_flag) {
+                sparse_array_remove(&app_state->ecs.components.component_arrays[c], entity);
+            }
+        }
+    }
     
     // Clear all component flags for this entity
-    app_state->ecs.components.component_active[entity] = 0;
+    app_state->ecs.components.component_active[index] = 0;
     
-    // Remove from active stack
-    entity_remove_from_active(app_state, entity);
+    // Mark as dead and bump the generation so outstanding handles go stale
+    app_state->ecs.alive[ALIVE_WORD(index)] &= ~ALIVE_BIT(index);
+    app_state->ecs.generations[index] = ((ENTITY_GENERATION(entity) + 1) & ENTITY_GENERATION_MASK) | ECS_GENERATION_DEAD;
+    app_state->ecs.active_count--;
     
-    // Add to inactive stack
-    stack_push(&app_state->ecs.inactive_entities, &entity);
+    // Return slot to the free list
+    app_state->ecs.free_list[app_state->ecs.free_count++] = index;
 }
 
 bool entity_exists(struct AppState *app_state, Entity entity) {
-    if (!app_state) return false;
-    return entity < config_get_max_entities(app_state) && entity_is_active(app_state, entity);
+    return entity_is_active(app_state, entity);
 }
 
 void *entity_get_component(struct AppState *app_state, Entity entity, uint32_t component_id) {
@@ -695,8 +929,12 @@ bool component_add(struct AppState *app_state, Entity entity, uint32_t component
     
     VALIDATE_NOT_NULL_FALSE(data, "component data");
     
-    if (entity >= config_get_max_entities(app_state)) {
-        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_BOUNDS, "Entity ID %u exceeds maximum %u", entity, config_get_max_entities(app_state));
+    if (!ecs_structural_change_allowed(app_state, "component_add")) {
+        return false;
+    }
+    
+    if (ENTITY_INDEX(entity) >= config_get_max_entities(app_state)) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_BOUNDS, "Entity ID %u exceeds maximum %u", ENTITY_INDEX(entity), config_get_max_entities(app_state));
     }
     
     if (!entity_is_active(app_state, entity)) {
@@ -707,30 +945,55 @@ bool component_add(struct AppState *app_state, Entity entity, uint32_t component
         ERROR_RETURN_FALSE(RESULT_ERROR_COMPONENT_NOT_FOUND, "Component ID %u is invalid (max: %u)", component_id, app_state->ecs.components.component_count);
     }
     
-    // Add component using sparse storage
-    if (!sparse_array_add(&app_state->ecs.components.component_arrays[component_id], entity, data, app_state)) {
+    uint32_t index = ENTITY_INDEX(entity);
+    uint32_t new_mask = app_state->ecs.components.component_active[index] | app_state->ecs.components.component_info[component_id].bit_flag;
+    
+    if (app_state->ecs.archetypes) {
+        // Move the entity to the archetype for its new mask, then fill in the component
+        if (!archetype_set_mask(app_state->ecs.archetypes, entity, new_mask)) {
+            ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to add component %u to entity %u", component_id, entity);
+        }
+        memcpy(archetype_get_component(app_state->ecs.archetypes, entity, component_id), data,
+               app_state->ecs.components.component_info[component_id].data_size);
+    } else if (!sparse_array_add(&app_state->ecs.components.component_arrays[component_id], entity, data)) {
         ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to add component %u to entity %u", component_id, entity);
     }
     
     // Set component flag
-    app_state->ecs.components.component_active[entity] |= app_state->ecs.components.component_info[component_id].bit_flag;
+    uint32_t old_mask = app_state->ecs.components.component_active[index];
+    app_state->ecs.components.component_active[index] = new_mask;
+    system_queries_update(app_state, entity, true, old_mask, true, new_mask);
     
     return true;
 }
 
 bool component_remove(struct AppState *app_state, Entity entity, uint32_t component_id) {
-    if (!app_state || entity >= MAX_ENTITIES || !entity_is_active(app_state, entity) || 
+    if (!app_state || !entity_is_active(app_state, entity) || 
         component_id >= MAX_COMPONENTS || component_id >= app_state->ecs.components.component_count) {
         return false;
     }
+    if (!ecs_structural_change_allowed(app_state, "component_remove")) {
+        return false;
+    }
+    
+    uint32_t index = ENTITY_INDEX(entity);
     
     // Check if component is active
-    if (app_state->ecs.components.component_active[entity] & app_state->ecs.components.component_info[component_id].bit_flag) {
-        // Remove component using sparse storage
-        sparse_array_remove(&app_state->ecs.components.component_arrays[component_id], entity, app_state);
+    if (app_state->ecs.components.component_active[index] & app_state->ecs.components.component_info[component_id].bit_flag) {
+        uint32_t new_mask = app_state->ecs.components.component_active[index] & ~app_state->ecs.components.component_info[component_id].bit_flag;
+        
+        if (app_state->ecs.archetypes) {
+            if (!archetype_set_mask(app_state->ecs.archetypes, entity, new_mask)) {
+                return false;
+            }
+        } else {
+            sparse_array_remove(&app_state->ecs.components.component_arrays[component_id], entity);
+        }
         
         // Clear component flag
-        app_state->ecs.components.component_active[entity] &= ~app_state->ecs.components.component_info[component_id].bit_flag;
+        uint32_t old_mask = app_state->ecs.components.component_active[index];
+        app_state->ecs.components.component_active[index] = new_mask;
+        system_queries_update(app_state, entity, true, old_mask, true, new_mask);
         return true;
     }
     
@@ -743,8 +1006,8 @@ void *component_get(struct AppState *app_state, Entity entity, uint32_t componen
         return NULL;
     }
     
-    if (entity >= MAX_ENTITIES) {
-        ERROR_SET(RESULT_ERROR_OUT_OF_BOUNDS, "Entity ID %u exceeds maximum %d", entity, MAX_ENTITIES);
+    if (ENTITY_INDEX(entity) >= MAX_ENTITIES) {
+        ERROR_SET(RESULT_ERROR_OUT_OF_BOUNDS, "Entity ID %u exceeds maximum %d", ENTITY_INDEX(entity), MAX_ENTITIES);
         return NULL;
     }
     
@@ -759,7 +1022,10 @@ void *component_get(struct AppState *app_state, Entity entity, uint32_t componen
     }
     
     // Check if component is active
-    if (app_state->ecs.components.component_active[entity] & app_state->ecs.components.component_info[component_id].bit_flag) {
+    if (app_state->ecs.components.component_active[ENTITY_INDEX(entity)] & app_state->ecs.components.component_info[component_id].bit_flag) {
+        if (app_state->ecs.archetypes) {
+            return archetype_get_component(app_state->ecs.archetypes, entity, component_id);
+        }
         return sparse_array_get(&app_state->ecs.components.component_arrays[component_id], entity);
     }
     
@@ -768,12 +1034,60 @@ void *component_get(struct AppState *app_state, Entity entity, uint32_t componen
 }
 
 bool component_has(struct AppState *app_state, Entity entity, uint32_t component_id) {
-    if (!app_state || entity >= MAX_ENTITIES || !entity_is_active(app_state, entity) || 
+    if (!app_state || !entity_is_active(app_state, entity) || 
         component_id >= MAX_COMPONENTS || component_id >= app_state->ecs.components.component_count) {
         return false;
     }
     
-    return (app_state->ecs.components.component_active[entity] & app_state->ecs.components.component_info[component_id].bit_flag) != 0;
+    return (app_state->ecs.components.component_active[ENTITY_INDEX(entity)] & app_state->ecs.components.component_info[component_id].bit_flag) != 0;
+}
+
+bool component_apply_batch(struct AppState *app_state, Entity entity, uint32_t remove_mask,
+                           uint32_t data_mask, const void *const *data) {
+    if (!app_state || !entity_is_active(app_state, entity)) {
+        return false;
+    }
+    if (!ecs_structural_change_allowed(app_state, "component_apply_batch")) {
+        return false;
+    }
+    
+    uint32_t index = ENTITY_INDEX(entity);
+    uint32_t valid_mask = app_state->ecs.components.component_count >= 32 ? UINT32_MAX :
+                          (1u << app_state->ecs.components.component_count) - 1;
+    data_mask &= valid_mask;
+    remove_mask &= valid_mask & ~data_mask;
+    
+    uint32_t old_mask = app_state->ecs.components.component_active[index];
+    uint32_t new_mask = (old_mask & ~remove_mask) | data_mask;
+    
+    if (app_state->ecs.archetypes) {
+        // One archetype move for the whole batch instead of one per component
+        if (new_mask != old_mask && !archetype_set_mask(app_state->ecs.archetypes, entity, new_mask)) {
+            ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to move entity %u to component mask 0x%x", entity, new_mask);
+        }
+        for (uint32_t bits = data_mask; bits != 0; bits &= bits - 1) {
+            uint32_t c = (uint32_t)__builtin_ctz(bits);
+            memcpy(archetype_get_component(app_state->ecs.archetypes, entity, c), data[c],
+                   app_state->ecs.components.component_info[c].data_size);
+        }
+    } else {
+        for (uint32_t bits = old_mask & remove_mask; bits != 0; bits &= bits - 1) {
+            sparse_array_remove(&app_state->ecs.components.component_arrays[__builtin_ctz(bits)], entity);
+        }
+        for (uint32_t bits = data_mask; bits != 0; bits &= bits - 1) {
+            uint32_t c = (uint32_t)__builtin_ctz(bits);
+            if (!sparse_array_add(&app_state->ecs.components.component_arrays[c], entity, (void *)data[c])) {
+                // Keep the mask in step with what actually landed in storage
+                new_mask &= ~(1u << c);
+                ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Failed to add component %u to entity %u", c, entity);
+            }
+        }
+    }
+    
+    app_state->ecs.components.component_active[index] = new_mask;
+    system_queries_update(app_state, entity, true, old_mask, true, new_mask);
+    
+    return new_mask == ((old_mask & ~remove_mask) | data_mask);
 }
 
 // Helper function to count NULL-terminated dependency array
@@ -799,8 +1113,8 @@ bool system_register(struct AppState *app_state, const SystemConfig *config) {
         return false;
     }
     
-    if (!config->name || !config->function) {
-        ERROR_SET(RESULT_ERROR_NULL_POINTER, "System name and function are required");
+    if (!config->name || (!config->function && !config->pre_update && !config->post_update)) {
+        ERROR_SET(RESULT_ERROR_NULL_POINTER, "System name and at least one function are required");
         return false;
     }
     
@@ -830,6 +1144,10 @@ bool system_register(struct AppState *app_state, const SystemConfig *config) {
     system->pre_update_function = config->pre_update;   // Can be NULL
     system->post_update_function = config->post_update; // Can be NULL
     system->component_mask = config->component_mask;
+    system->read_mask = config->read_mask ? config->read_mask : config->component_mask;
+    system->write_mask = config->write_mask ? config->write_mask : config->component_mask;
+    system->threading = config->threading;
+    system->level = 0;
     
     // Priority and dependency setup
     system->priority = config->priority;
@@ -838,6 +1156,16 @@ bool system_register(struct AppState *app_state, const SystemConfig *config) {
     system->execution_order = system->priority; // Initial order, will be refined by sorting
     system->execution_count = 0;
     system->total_execution_time = 0.0f;
+    system->profile = profiler_system_profile_create();
+    
+    // Build the cached entity/archetype query for this system's mask
+    if (!system_query_init(app_state, system)) {
+        system_query_cleanup(system);
+        profiler_system_profile_destroy(system->profile);
+        system->profile = NULL;
+        ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate query for system '%s'", config->name);
+        return false;
+    }
     
     // Copy dependencies if provided
     if (config->dependencies && dependency_count > 0) {
@@ -862,6 +1190,283 @@ bool system_register(struct AppState *app_state, const SystemConfig *config) {
     return true;
 }
 
+// Run a system over its cached query - only the entities that match its mask.
+// Entities the system destroys or strips of a component leave holes that are skipped
+// and compacted afterwards; entities that start matching mid-walk are appended past
+// the snapshot and wait for the next run.
+static uint32_t system_run_sparse(AppState *app_state, System *system) {
+    uint32_t entities_processed = 0;
+    if (!system->function) {
+        return 0;
+    }
+    
+    uint32_t count = system->query_count;
+    system->query_walk_end = count;
+    for (uint32_t i = 0; i < count; i++) {
+        Entity entity = system->query_entities[i];
+        if (entity == INVALID_ENTITY) {
+            continue;
+        }
+        
+        system->function(entity, app_state);
+        entities_processed++;
+    }
+    system->query_walk_end = 0;
+    
+    if (system->query_holes > 0) {
+        system_query_compact(system);
+    }
+    
+    return entities_processed;
+}
+
+// Pick up archetypes created since the system's query was last refreshed
+static void system_query_refresh_archetypes(ArchetypeStorage *storage, System *system) {
+    while (system->query_archetypes_scanned < storage->archetype_count) {
+        uint32_t a = system->query_archetypes_scanned++;
+        if ((storage->archetypes[a].mask & system->component_mask) == system->component_mask) {
+            system->query_archetypes[system->query_archetype_count++] = a;
+        }
+    }
+}
+
+// Run a system over the archetypes whose mask contains the system mask.
+// The matching rows are snapshotted first: a component change moves an entity to
+// another archetype (possibly one still to be walked) and a swap-remove moves rows
+// around, so walking the chunks live could visit an entity twice. Entities the
+// system destroys or strips of a component are skipped; entities that start
+// matching mid-walk wait for the next run, the same as with sparse storage.
+static uint32_t system_run_archetype(AppState *app_state, System *system) {
+    ArchetypeStorage *storage = app_state->ecs.archetypes;
+    uint32_t entities_processed = 0;
+    if (!system->function) {
+        return 0;
+    }
+    
+    system_query_refresh_archetypes(storage, system);
+    
+    uint32_t count = 0;
+    for (uint32_t q = 0; q < system->query_archetype_count; q++) {
+        Archetype *archetype = &storage->archetypes[system->query_archetypes[q]];
+        for (uint32_t chunk = 0; chunk < archetype->chunk_count; chunk++) {
+            uint32_t rows = archetype->chunks[chunk].count;
+            memcpy(&system->query_entities[count], archetype_chunk_entities(archetype, chunk), rows * sizeof(Entity));
+            count += rows;
+        }
+    }
+    
+    uint32_t mask = system->component_mask;
+    for (uint32_t i = 0; i < count; i++) {
+        Entity entity = system->query_entities[i];
+        if (!entity_is_active(app_state, entity) ||
+            (app_state->ecs.components.component_active[ENTITY_INDEX(entity)] & mask) != mask) {
+            continue;
+        }
+        
+        system->function(entity, app_state);
+        entities_processed++;
+    }
+    
+    return entities_processed;
+}
+
+// ===== PARALLEL SCHEDULING =====
+
+// Entities per job when a PARALLEL system is split across workers (sparse storage)
+#define SYSTEM_JOB_ENTITIES 256
+
+// One unit of work handed to a worker
+typedef struct SystemJob {
+    AppState *app_state;
+    System *system;
+    Archetype *archetype;       // Archetype storage: the chunk to process
+    uint32_t chunk;
+    uint32_t begin;             // Sparse storage: range within the system's query
+    uint32_t end;
+    bool whole_system;          // Run the full query (WORKER systems)
+    uint32_t entities_processed;
+    uint64_t ticks;             // Time spent in the job, when profiling
+} SystemJob;
+
+static void system_job_run(void *data, uint32_t worker_index) {
+    SystemJob *job = (SystemJob *)data;
+    System *system = job->system;
+    uint64_t start = profiler_enabled(job->app_state) ? profiler_now() : 0;
+    (void)worker_index;
+    
+    if (job->whole_system) {
+        job->entities_processed = job->app_state->ecs.archetypes
+            ? system_run_archetype(job->app_state, system)
+            : system_run_sparse(job->app_state, system);
+    } else if (job->archetype) {
+        Entity *entities = archetype_chunk_entities(job->archetype, job->chunk);
+        uint32_t count = job->archetype->chunks[job->chunk].count;
+        for (uint32_t row = 0; row < count; row++) {
+            system->function(entities[row], job->app_state);
+        }
+        job->entities_processed = count;
+    } else {
+        for (uint32_t i = job->begin; i < job->end; i++) {
+            system->function(system->query_entities[i], job->app_state);
+        }
+        job->entities_processed = job->end - job->begin;
+    }
+    
+    if (start) {
+        job->ticks = profiler_now() - start;
+    }
+}
+
+static SystemJob *system_job_push(AppState *app_state, uint32_t *job_count) {
+    if (*job_count >= app_state->ecs.job_capacity) {
+        uint32_t new_capacity = app_state->ecs.job_capacity ? app_state->ecs.job_capacity * 2 : 64;
+        SystemJob *new_jobs = realloc(app_state->ecs.jobs, new_capacity * sizeof(SystemJob));
+        if (!new_jobs) {
+            return NULL;
+        }
+        app_state->ecs.jobs = new_jobs;
+        app_state->ecs.job_capacity = new_capacity;
+    }
+    
+    SystemJob *job = &app_state->ecs.jobs[(*job_count)++];
+    memset(job, 0, sizeof(SystemJob));
+    job->app_state = app_state;
+    return job;
+}
+
+// Build the jobs for one system. Queries don't change while a level runs because
+// structural changes made during a level are recorded in command buffers and
+// only applied once the level has finished.
+static bool system_build_jobs(AppState *app_state, System *system, uint32_t *job_count) {
+    // Nothing to hand out when pre/post update do all the work
+    if (!system->function) {
+        return true;
+    }
+    
+    if (system->threading != SYSTEM_THREADING_PARALLEL) {
+        SystemJob *job = system_job_push(app_state, job_count);
+        if (!job) return false;
+        job->system = system;
+        job->whole_system = true;
+        return true;
+    }
+    
+    if (app_state->ecs.archetypes) {
+        ArchetypeStorage *storage = app_state->ecs.archetypes;
+        system_query_refresh_archetypes(storage, system);
+        for (uint32_t q = 0; q < system->query_archetype_count; q++) {
+            Archetype *archetype = &storage->archetypes[system->query_archetypes[q]];
+            for (uint32_t chunk = 0; chunk < archetype->chunk_count; chunk++) {
+                SystemJob *job = system_job_push(app_state, job_count);
+                if (!job) return false;
+                job->system = system;
+                job->archetype = archetype;
+                job->chunk = chunk;
+            }
+        }
+        return true;
+    }
+    
+    for (uint32_t begin = 0; begin < system->query_count; begin += SYSTEM_JOB_ENTITIES) {
+        SystemJob *job = system_job_push(app_state, job_count);
+        if (!job) return false;
+        job->system = system;
+        job->begin = begin;
+        job->end = begin + SYSTEM_JOB_ENTITIES < system->query_count ? begin + SYSTEM_JOB_ENTITIES : system->query_count;
+    }
+    return true;
+}
+
+// Fold one run's phase timings into the system's counters and profile
+static void system_record_run(AppState *app_state, System *system,
+                              const uint64_t phase_ticks[PROFILER_PHASE_COUNT], uint32_t entities_processed) {
+    system->execution_count++;
+    
+    if (profiler_enabled(app_state)) {
+        profiler_record_system(app_state, system->profile, phase_ticks, entities_processed);
+        system->total_execution_time += profiler_ticks_to_us(app_state,
+            phase_ticks[PROFILER_PHASE_PRE_UPDATE] + phase_ticks[PROFILER_PHASE_ENTITIES] +
+            phase_ticks[PROFILER_PHASE_POST_UPDATE]) / 1000.0f;
+    }
+    
+    // Log detailed execution info for debugging (only occasionally)
+    if (system->execution_count % 1000 == 0) {
+        LOG_DEBUG("System '%s' executed 1000 times, processed %d entities this frame", 
+                 system->name, entities_processed);
+    }
+}
+
+// Run every enabled system in one DAG level. Pre/post updates stay on the main thread
+// in sorted order; worker jobs are dealt round-robin in a fixed order, so the same
+// entities always land on the same worker in the same sequence.
+static void system_run_level(AppState *app_state, uint32_t level) {
+    uint32_t system_count = app_state->ecs.systems.system_count;
+    bool profiling = profiler_enabled(app_state);
+    uint64_t phase_ticks[MAX_SYSTEMS][PROFILER_PHASE_COUNT];
+    uint32_t entities_processed[MAX_SYSTEMS];
+    memset(phase_ticks, 0, sizeof(uint64_t) * PROFILER_PHASE_COUNT * system_count);
+    memset(entities_processed, 0, sizeof(uint32_t) * system_count);
+    
+    for (uint32_t i = 0; i < system_count; i++) {
+        System *system = &app_state->ecs.systems.systems[i];
+        if (system->enabled && system->level == level && system->pre_update_function) {
+            uint64_t start = profiling ? profiler_now() : 0;
+            system->pre_update_function(app_state);
+            phase_ticks[i][PROFILER_PHASE_PRE_UPDATE] = profiling ? profiler_now() - start : 0;
+        }
+    }
+    
+    uint32_t job_count = 0;
+    for (uint32_t i = 0; i < system_count; i++) {
+        System *system = &app_state->ecs.systems.systems[i];
+        if (!system->enabled || system->level != level) {
+            continue;
+        }
+        
+        if (system->threading == SYSTEM_THREADING_MAIN) {
+            // Main-thread systems conflict with everything, so they are alone in their level
+            uint64_t start = profiling ? profiler_now() : 0;
+            entities_processed[i] = app_state->ecs.archetypes
+                ? system_run_archetype(app_state, system)
+                : system_run_sparse(app_state, system);
+            phase_ticks[i][PROFILER_PHASE_ENTITIES] = profiling ? profiler_now() - start : 0;
+        } else if (!system_build_jobs(app_state, system, &job_count)) {
+            LOG_ERROR("Failed to allocate jobs for system '%s'", system->name);
+        }
+    }
+    
+    uint32_t worker_count = thread_pool_worker_count(app_state->ecs.workers);
+    for (uint32_t j = 0; j < job_count; j++) {
+        if (!thread_pool_submit(app_state->ecs.workers, j % worker_count, system_job_run, &app_state->ecs.jobs[j])) {
+            // Queue full: run it here rather than drop it
+            system_job_run(&app_state->ecs.jobs[j], 0);
+        }
+    }
+    thread_pool_wait(app_state->ecs.workers);
+    
+    // Entity phase of worker systems is the summed job time across workers
+    for (uint32_t j = 0; j < job_count; j++) {
+        uint32_t i = (uint32_t)(app_state->ecs.jobs[j].system - app_state->ecs.systems.systems);
+        phase_ticks[i][PROFILER_PHASE_ENTITIES] += app_state->ecs.jobs[j].ticks;
+        entities_processed[i] += app_state->ecs.jobs[j].entities_processed;
+    }
+    
+    for (uint32_t i = 0; i < system_count; i++) {
+        System *system = &app_state->ecs.systems.systems[i];
+        if (system->enabled && system->level == level) {
+            if (system->post_update_function) {
+                uint64_t start = profiling ? profiler_now() : 0;
+                system->post_update_function(app_state);
+                phase_ticks[i][PROFILER_PHASE_POST_UPDATE] = profiling ? profiler_now() - start : 0;
+            }
+            system_record_run(app_state, system, phase_ticks[i], entities_processed[i]);
+        }
+    }
+    
+    // Sync point: apply structural changes recorded during this level
+    ecs_commands_flush(app_state);
+}
+
 bool system_run_all(AppState *app_state) {
     if (!app_state) {
         ERROR_SET(RESULT_ERROR_NULL_POINTER, "AppState pointer is NULL");
@@ -877,6 +1482,16 @@ bool system_run_all(AppState *app_state) {
         topological_sort_systems(app_state);
     }
     
+    // With worker threads, run level by level so non-conflicting systems overlap
+    if (app_state->ecs.workers) {
+        for (uint32_t level = 0; level < app_state->ecs.systems.level_count; level++) {
+            system_run_level(app_state, level);
+        }
+        return !appstate_should_quit();
+    }
+    
+    bool profiling = profiler_enabled(app_state);
+    
     for (uint32_t sys = 0; sys < app_state->ecs.systems.system_count; sys++) {
         System *system = &app_state->ecs.systems.systems[sys];
         
@@ -885,51 +1500,36 @@ bool system_run_all(AppState *app_state) {
             continue;
         }
         
+        uint64_t phase_ticks[PROFILER_PHASE_COUNT] = {0, 0, 0};
+        uint64_t start = profiling ? profiler_now() : 0;
+        
         // Call pre-update function if it exists
         if (system->pre_update_function) {
             system->pre_update_function(app_state);
         }
+        uint64_t pre_end = profiling ? profiler_now() : 0;
         
-        // Iterate through all active entities
-        ll_node *current = app_state->ecs.active_entities.list.head;
-        uint32_t entities_processed = 0;
-        
-        while (current != NULL) {
-            Entity entity = *(Entity *)current->data;
-            
-            // Check if entity has all required components
-            bool has_all_components = true;
-            
-            for (uint32_t comp = 0; comp < app_state->ecs.components.component_count; comp++) {
-                if (system->component_mask & app_state->ecs.components.component_info[comp].bit_flag) {
-                    if (!(app_state->ecs.components.component_active[entity] & app_state->ecs.components.component_info[comp].bit_flag)) {
-                        has_all_components = false;
-                        break;
-                    }
-                }
-            }
-            
-            if (has_all_components) {
-                system->function(entity, app_state);
-                entities_processed++;
-            }
-            
-            current = current->next;
-        }
+        uint32_t entities_processed = app_state->ecs.archetypes
+            ? system_run_archetype(app_state, system)
+            : system_run_sparse(app_state, system);
+        uint64_t entities_end = profiling ? profiler_now() : 0;
         
         // Call post-update function if it exists
         if (system->post_update_function) {
             system->post_update_function(app_state);
         }
         
-        // Update performance tracking
-        system->execution_count++;
-        
-        // Log detailed execution info for debugging (only occasionally)
-        if (system->execution_count % 1000 == 0) {
-            LOG_DEBUG("System '%s' executed 1000 times, processed %d entities this frame", 
-                     system->name, entities_processed);
+        if (profiling) {
+            phase_ticks[PROFILER_PHASE_PRE_UPDATE] = pre_end - start;
+            phase_ticks[PROFILER_PHASE_ENTITIES] = entities_end - pre_end;
+            phase_ticks[PROFILER_PHASE_POST_UPDATE] = profiler_now() - entities_end;
         }
+        
+        // Sync point: apply structural changes the system recorded
+        ecs_commands_flush(app_state);
+        
+        // Update performance tracking
+        system_record_run(app_state, system, phase_ticks, entities_processed);
     }
     
     // Check if quit was requested
@@ -26,6 +26,12 @@ typedef enum {
     SYSTEM_PRIORITY_LAST = 400
 } SystemPriority;
 
+typedef enum {
+    SYSTEM_THREADING_MAIN = 0,
+    SYSTEM_THREADING_WORKER,
+    SYSTEM_THREADING_PARALLEL
+} SystemThreading;
+
 typedef void (*SystemFunction)(Entity entity, struct AppState *app_state);
 typedef void (*SystemPreUpdateFunction)(struct AppState *app_state);
 typedef void (*SystemPostUpdateFunction)(struct AppState *app_state);
@@ -47,11 +53,14 @@ typedef void (*SystemPostUpdateFunction)(struct AppState *app_state);
 typedef struct {
     const char *name;                           // System name (required)
     uint32_t component_mask;                    // Required components (required)
-    SystemFunction function;                    // Main system function (required)
+    SystemFunction function;                    // Per-entity function (NULL if pre/post update do all the work)
     SystemPreUpdateFunction pre_update;        // Optional pre-update function
     SystemPostUpdateFunction post_update;      // Optional post-update function
     SystemPriority priority;                   // System priority (defaults to NORMAL)
     const char **dependencies;                 // Optional dependency names (NULL-terminated array)
+    uint32_t read_mask;                        // Components read (0 = component_mask)
+    uint32_t write_mask;                       // Components written (0 = component_mask)
+    SystemThreading threading;                 // Where the system may run (defaults to MAIN)
 } SystemConfig;
 
 // Convenience macro for creating SystemConfig with defaults
@@ -62,14 +71,18 @@ typedef struct {
     .pre_update = NULL, \
     .post_update = NULL, \
     .priority = SYSTEM_PRIORITY_NORMAL, \
-    .dependencies = NULL \
+    .dependencies = NULL, \
+    .read_mask = 0, \
+    .write_mask = 0, \
+    .threading = SYSTEM_THREADING_MAIN \
 }
 
 // ECS Core functions
 void ecs_init(struct AppState *app_state);
 void ecs_shutdown(struct AppState *app_state);
 
-// Entity management
+// Entity management. Structural calls (create, destroy, add, remove, apply_batch) fail on
+// pool worker threads; systems running there record them with ecs_cmd_* instead.
 Entity entity_create(struct AppState *app_state);
 void entity_destroy(struct AppState *app_state, Entity entity);
 bool entity_exists(struct AppState *app_state, Entity entity);
@@ -81,9 +94,21 @@ bool component_remove(struct AppState *app_state, Entity entity, uint32_t compon
 void *component_get(struct AppState *app_state, Entity entity, uint32_t component_id);
 bool component_has(struct AppState *app_state, Entity entity, uint32_t component_id);
 
+// Apply several component changes with a single storage move: drop the components in
+// remove_mask, then add or overwrite each component in data_mask from data[component_id]
+bool component_apply_batch(struct AppState *app_state, Entity entity, uint32_t remove_mask,
+                           uint32_t data_mask, const void *const *data);
+
 // Component registration
 uint32_t component_register(struct AppState *app_state, const char *name, size_t size);
-uint32_t component_get_id(struct AppState *app_state, const char *name);
+uint32_t component_get_id(struct AppState *app_state, const char *name);  // Name lookup, for data-driven paths
+
+// Typed component access by compile-time ID, e.g. ECS_GET(app_state, entity, Position)
+#define ECS_GET(app_state, entity, name) \
+    ((ComponentType_##name *)component_get((app_state), (entity), COMPONENT_ID_##name))
+#define ECS_HAS(app_state, entity, name) component_has((app_state), (entity), COMPONENT_ID_##name)
+#define ECS_ADD(app_state, entity, name, data) component_add((app_state), (entity), COMPONENT_ID_##name, (data))
+#define ECS_REMOVE(app_state, entity, name) component_remove((app_state), (entity), COMPONENT_ID_##name)
 
 // System management - Clean, unified registration API
 bool system_register(struct AppState *app_state, const SystemConfig *config);
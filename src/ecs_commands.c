@@ -0,0 +1,408 @@
+#include "ecs_commands.h"
+#include "ecs.h"
+#include "appstate.h"
+#include "thread_pool.h"
+#include "log.h"
+#include "error.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Provisional handle layout
+#define ECS_COMMAND_BUFFER_MASK (ECS_COMMAND_MAX_BUFFERS - 1)
+#define ECS_COMMAND_CREATE_MASK (ECS_COMMAND_MAX_CREATES - 1)
+#define PROVISIONAL_MAKE(buffer, create) \
+    ENTITY_MAKE(ECS_COMMAND_PROVISIONAL_BIT | ((uint32_t)(buffer) << ECS_COMMAND_CREATE_BITS) | (uint32_t)(create), 0)
+#define PROVISIONAL_BUFFER(entity) ((ENTITY_INDEX(entity) >> ECS_COMMAND_CREATE_BITS) & ECS_COMMAND_BUFFER_MASK)
+#define PROVISIONAL_CREATE(entity) (ENTITY_INDEX(entity) & ECS_COMMAND_CREATE_MASK)
+
+// Flush sort key: entity slot | buffer | record sequence
+#define ORDER_SEQUENCE_BITS 27
+#define ORDER_MAKE(index, buffer, sequence) \
+    (((uint64_t)(index) << 32) | ((uint64_t)(buffer) << ORDER_SEQUENCE_BITS) | (uint64_t)(sequence))
+#define ORDER_INDEX(key) ((uint32_t)((key) >> 32))
+#define ORDER_BUFFER(key) ((uint32_t)((key) >> ORDER_SEQUENCE_BITS) & ECS_COMMAND_BUFFER_MASK)
+#define ORDER_SEQUENCE(key) ((uint32_t)(key) & ((1u << ORDER_SEQUENCE_BITS) - 1))
+
+#define INITIAL_COMMAND_CAPACITY 64
+#define INITIAL_DATA_CAPACITY 1024
+
+bool ecs_commands_init(struct AppState *app_state, uint32_t buffer_count) {
+    if (!app_state || buffer_count == 0 || buffer_count > ECS_COMMAND_MAX_BUFFERS) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INVALID_PARAMETER, "Command buffer count %u out of range [1, %d]", buffer_count, ECS_COMMAND_MAX_BUFFERS);
+    }
+
+    app_state->ecs.command_buffers = calloc(buffer_count, sizeof(ECSCommandBuffer));
+    if (!app_state->ecs.command_buffers) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate %u command buffers", buffer_count);
+    }
+    app_state->ecs.command_buffer_count = buffer_count;
+    app_state->ecs.command_order = NULL;
+    app_state->ecs.command_order_capacity = 0;
+    return true;
+}
+
+void ecs_commands_cleanup(struct AppState *app_state) {
+    if (!app_state || !app_state->ecs.command_buffers) return;
+
+    if (ecs_commands_pending(app_state) > 0) {
+        LOG_WARN("Discarding %u unflushed ECS commands", ecs_commands_pending(app_state));
+    }
+
+    for (uint32_t b = 0; b < app_state->ecs.command_buffer_count; b++) {
+        free(app_state->ecs.command_buffers[b].commands);
+        free(app_state->ecs.command_buffers[b].data);
+    }
+    free(app_state->ecs.command_buffers);
+    free(app_state->ecs.command_order);
+    app_state->ecs.command_buffers = NULL;
+    app_state->ecs.command_buffer_count = 0;
+    app_state->ecs.command_order = NULL;
+    app_state->ecs.command_order_capacity = 0;
+}
+
+// ===== RECORDING =====
+
+// The calling thread's buffer: workers get their own, everything else records into buffer 0
+static ECSCommandBuffer *command_buffer_current(struct AppState *app_state, uint32_t *buffer_index) {
+    if (!app_state || !app_state->ecs.command_buffers) return NULL;
+
+    uint32_t worker = thread_pool_current_worker(app_state->ecs.workers);
+    uint32_t index = worker == THREAD_POOL_NOT_WORKER ? 0 : worker + 1;
+    if (index >= app_state->ecs.command_buffer_count) {
+        index = 0;
+    }
+
+    if (buffer_index) *buffer_index = index;
+    return &app_state->ecs.command_buffers[index];
+}
+
+static ECSCommand *command_push(ECSCommandBuffer *buffer, ECSCommandType type, Entity entity, uint32_t component_id) {
+    if (buffer->count >= (1u << ORDER_SEQUENCE_BITS)) {
+        return NULL;
+    }
+
+    if (buffer->count >= buffer->capacity) {
+        uint32_t new_capacity = buffer->capacity ? buffer->capacity * 2 : INITIAL_COMMAND_CAPACITY;
+        ECSCommand *new_commands = realloc(buffer->commands, new_capacity * sizeof(ECSCommand));
+        if (!new_commands) {
+            return NULL;
+        }
+        buffer->commands = new_commands;
+        buffer->capacity = new_capacity;
+    }
+
+    ECSCommand *command = &buffer->commands[buffer->count++];
+    command->type = type;
+    command->entity = entity;
+    command->component_id = component_id;
+    command->data_offset = 0;
+    return command;
+}
+
+// Copy a component payload into the buffer's arena, returning its offset
+static bool command_store_data(ECSCommandBuffer *buffer, const void *data, size_t size, uint32_t *offset) {
+    if ((uint64_t)buffer->data_size + size > UINT32_MAX) {
+        return false;
+    }
+
+    if (buffer->data_size + size > buffer->data_capacity) {
+        uint32_t new_capacity = buffer->data_capacity ? buffer->data_capacity : INITIAL_DATA_CAPACITY;
+        while (new_capacity < buffer->data_size + size) {
+            new_capacity *= 2;
+        }
+        uint8_t *new_data = realloc(buffer->data, new_capacity);
+        if (!new_data) {
+            return false;
+        }
+        buffer->data = new_data;
+        buffer->data_capacity = new_capacity;
+    }
+
+    *offset = buffer->data_size;
+    memcpy(buffer->data + buffer->data_size, data, size);
+    buffer->data_size += (uint32_t)size;
+    return true;
+}
+
+// A command target is either a live entity or a provisional handle from a create that
+// is still waiting in its buffer. Stale handles are rejected here rather than dropped
+// silently at the flush.
+static bool command_target_valid(struct AppState *app_state, const ECSCommandBuffer *buffer,
+                                 uint32_t buffer_index, Entity entity) {
+    if (entity == INVALID_ENTITY) return false;
+    if (!ECS_ENTITY_IS_PROVISIONAL(entity)) {
+        return entity_exists(app_state, entity);
+    }
+
+    // Other threads' create counts can't be read safely while they record, so only
+    // handles from this thread's own buffer are range checked
+    uint32_t owner = PROVISIONAL_BUFFER(entity);
+    if (owner >= app_state->ecs.command_buffer_count) return false;
+    return owner != buffer_index || (!buffer->created_resolved && PROVISIONAL_CREATE(entity) < buffer->create_count);
+}
+
+static bool command_record_data(struct AppState *app_state, ECSCommandType type, Entity entity,
+                                uint32_t component_id, const void *data) {
+    uint32_t buffer_index;
+    ECSCommandBuffer *buffer = command_buffer_current(app_state, &buffer_index);
+    if (!buffer) return false;
+
+    if (!data || component_id >= app_state->ecs.components.component_count ||
+        !command_target_valid(app_state, buffer, buffer_index, entity)) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INVALID_PARAMETER, "Invalid deferred component command (entity %u, component %u)", entity, component_id);
+    }
+
+    uint32_t offset;
+    if (!command_store_data(buffer, data, app_state->ecs.components.component_info[component_id].data_size, &offset)) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Command buffer data arena full");
+    }
+
+    ECSCommand *command = command_push(buffer, type, entity, component_id);
+    if (!command) {
+        buffer->data_size = offset;
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Command buffer full");
+    }
+    command->data_offset = offset;
+    return true;
+}
+
+Entity ecs_cmd_create(struct AppState *app_state) {
+    uint32_t buffer_index;
+    ECSCommandBuffer *buffer = command_buffer_current(app_state, &buffer_index);
+    if (!buffer) return INVALID_ENTITY;
+
+    // The previous flush's results are dropped once this buffer starts creating again
+    if (buffer->created_resolved) {
+        buffer->create_count = 0;
+        buffer->created_resolved = false;
+    }
+
+    if (buffer->create_count >= ECS_COMMAND_MAX_CREATES) {
+        ERROR_SET(RESULT_ERROR_SYSTEM_LIMIT, "Too many deferred creates in one buffer (%d)", ECS_COMMAND_MAX_CREATES);
+        return INVALID_ENTITY;
+    }
+
+    Entity entity = PROVISIONAL_MAKE(buffer_index, buffer->create_count);
+    if (!command_push(buffer, ECS_COMMAND_CREATE, entity, 0)) {
+        ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Command buffer full");
+        return INVALID_ENTITY;
+    }
+    buffer->created[buffer->create_count++] = INVALID_ENTITY;
+    return entity;
+}
+
+bool ecs_cmd_destroy(struct AppState *app_state, Entity entity) {
+    uint32_t buffer_index;
+    ECSCommandBuffer *buffer = command_buffer_current(app_state, &buffer_index);
+    if (!buffer) return false;
+
+    if (!command_target_valid(app_state, buffer, buffer_index, entity)) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INVALID_PARAMETER, "Invalid deferred destroy (entity %u)", entity);
+    }
+    if (!command_push(buffer, ECS_COMMAND_DESTROY, entity, 0)) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Command buffer full");
+    }
+    return true;
+}
+
+bool ecs_cmd_add(struct AppState *app_state, Entity entity, uint32_t component_id, const void *data) {
+    if (!app_state) return false;
+    return command_record_data(app_state, ECS_COMMAND_ADD, entity, component_id, data);
+}
+
+bool ecs_cmd_remove(struct AppState *app_state, Entity entity, uint32_t component_id) {
+    uint32_t buffer_index;
+    ECSCommandBuffer *buffer = command_buffer_current(app_state, &buffer_index);
+    if (!buffer) return false;
+
+    if (component_id >= app_state->ecs.components.component_count ||
+        !command_target_valid(app_state, buffer, buffer_index, entity)) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INVALID_PARAMETER, "Invalid deferred remove (entity %u, component %u)", entity, component_id);
+    }
+    if (!command_push(buffer, ECS_COMMAND_REMOVE, entity, component_id)) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Command buffer full");
+    }
+    return true;
+}
+
+bool ecs_cmd_set(struct AppState *app_state, Entity entity, uint32_t component_id, const void *data) {
+    if (!app_state) return false;
+    return command_record_data(app_state, ECS_COMMAND_SET, entity, component_id, data);
+}
+
+// ===== FLUSH =====
+
+// Map a provisional handle to the entity its create produced
+static Entity command_resolve_entity(struct AppState *app_state, Entity entity) {
+    if (!ECS_ENTITY_IS_PROVISIONAL(entity)) {
+        return entity;
+    }
+
+    uint32_t buffer_index = PROVISIONAL_BUFFER(entity);
+    uint32_t create = PROVISIONAL_CREATE(entity);
+    if (buffer_index >= app_state->ecs.command_buffer_count) {
+        return INVALID_ENTITY;
+    }
+
+    ECSCommandBuffer *buffer = &app_state->ecs.command_buffers[buffer_index];
+    return create < buffer->create_count ? buffer->created[create] : INVALID_ENTITY;
+}
+
+static int command_order_compare(const void *a, const void *b) {
+    uint64_t ka = *(const uint64_t *)a;
+    uint64_t kb = *(const uint64_t *)b;
+    return (ka > kb) - (ka < kb);
+}
+
+// Fold one entity's commands, in order, into a single destroy or component batch
+static void command_apply_entity(struct AppState *app_state, const uint64_t *order, uint32_t count) {
+    uint32_t index = ORDER_INDEX(order[0]);
+    Entity target = ENTITY_MAKE(index, app_state->ecs.generations[index]);
+    if (!entity_exists(app_state, target)) {
+        return;
+    }
+
+    uint32_t mask = app_state->ecs.components.component_active[index];
+    uint32_t data_mask = 0;
+    uint32_t remove_mask = 0;
+    const void *data[MAX_COMPONENTS];       // Only entries in data_mask are read
+    bool destroyed = false;
+
+    for (uint32_t i = 0; i < count && !destroyed; i++) {
+        ECSCommandBuffer *buffer = &app_state->ecs.command_buffers[ORDER_BUFFER(order[i])];
+        const ECSCommand *command = &buffer->commands[ORDER_SEQUENCE(order[i])];
+
+        // Commands against an older generation of this slot are stale
+        if (command_resolve_entity(app_state, command->entity) != target) {
+            continue;
+        }
+
+        uint32_t bit = 1u << command->component_id;
+        switch (command->type) {
+            case ECS_COMMAND_DESTROY:
+                destroyed = true;
+                break;
+            case ECS_COMMAND_ADD:
+                data[command->component_id] = buffer->data + command->data_offset;
+                data_mask |= bit;
+                remove_mask &= ~bit;
+                mask |= bit;
+                break;
+            case ECS_COMMAND_REMOVE:
+                if (mask & bit) {
+                    mask &= ~bit;
+                    data_mask &= ~bit;
+                    remove_mask |= bit;
+                }
+                break;
+            case ECS_COMMAND_SET:
+                if (mask & bit) {
+                    data[command->component_id] = buffer->data + command->data_offset;
+                    data_mask |= bit;
+                }
+                break;
+            case ECS_COMMAND_CREATE:
+                break;
+        }
+    }
+
+    if (destroyed) {
+        entity_destroy(app_state, target);
+    } else if (data_mask | remove_mask) {
+        if (!component_apply_batch(app_state, target, remove_mask, data_mask, data)) {
+            LOG_WARN("Deferred component changes for entity %u were not fully applied", target);
+        }
+    }
+}
+
+void ecs_commands_flush(struct AppState *app_state) {
+    uint32_t total = ecs_commands_pending(app_state);
+    if (total == 0) return;
+
+    ECSCommandBuffer *buffers = app_state->ecs.command_buffers;
+    uint32_t buffer_count = app_state->ecs.command_buffer_count;
+
+    // Grow the order buffer before anything is applied; if that fails the batch stays
+    // recorded and is retried whole at the next sync point
+    if (total > app_state->ecs.command_order_capacity) {
+        uint64_t *new_order = realloc(app_state->ecs.command_order, total * sizeof(uint64_t));
+        if (!new_order) {
+            LOG_ERROR("Failed to allocate command flush order for %u commands, deferring the flush", total);
+            return;
+        }
+        app_state->ecs.command_order = new_order;
+        app_state->ecs.command_order_capacity = total;
+    }
+
+    // Creates first, in buffer then record order, so later commands can target them
+    for (uint32_t b = 0; b < buffer_count; b++) {
+        ECSCommandBuffer *buffer = &buffers[b];
+        for (uint32_t i = 0; i < buffer->count; i++) {
+            if (buffer->commands[i].type == ECS_COMMAND_CREATE) {
+                buffer->created[PROVISIONAL_CREATE(buffer->commands[i].entity)] = entity_create(app_state);
+            }
+        }
+        buffer->created_resolved = true;
+    }
+
+    // Sort everything else by target slot so each entity's commands apply together
+    uint32_t order_count = 0;
+    uint32_t dropped = 0;
+    bool sorted = true;
+    for (uint32_t b = 0; b < buffer_count; b++) {
+        ECSCommandBuffer *buffer = &buffers[b];
+        for (uint32_t i = 0; i < buffer->count; i++) {
+            if (buffer->commands[i].type == ECS_COMMAND_CREATE) continue;
+
+            Entity entity = command_resolve_entity(app_state, buffer->commands[i].entity);
+            if (ENTITY_INDEX(entity) >= MAX_ENTITIES) {
+                dropped++;
+                continue;
+            }
+            uint64_t key = ORDER_MAKE(ENTITY_INDEX(entity), b, i);
+            if (order_count > 0 && key < app_state->ecs.command_order[order_count - 1]) {
+                sorted = false;
+            }
+            app_state->ecs.command_order[order_count++] = key;
+        }
+    }
+    
+    // Bulk spawns record in slot order already, so the sort is usually skipped
+    if (!sorted) {
+        qsort(app_state->ecs.command_order, order_count, sizeof(uint64_t), command_order_compare);
+    }
+
+    uint32_t start = 0;
+    while (start < order_count) {
+        uint32_t end = start + 1;
+        while (end < order_count && ORDER_INDEX(app_state->ecs.command_order[end]) == ORDER_INDEX(app_state->ecs.command_order[start])) {
+            end++;
+        }
+        command_apply_entity(app_state, &app_state->ecs.command_order[start], end - start);
+        start = end;
+    }
+
+    if (dropped > 0) {
+        LOG_WARN("Dropped %u deferred commands targeting invalid entities", dropped);
+    }
+
+    for (uint32_t b = 0; b < buffer_count; b++) {
+        buffers[b].count = 0;
+        buffers[b].data_size = 0;
+    }
+}
+
+Entity ecs_commands_resolve(struct AppState *app_state, Entity entity) {
+    if (!app_state || !app_state->ecs.command_buffers) return INVALID_ENTITY;
+    return command_resolve_entity(app_state, entity);
+}
+
+uint32_t ecs_commands_pending(struct AppState *app_state) {
+    if (!app_state || !app_state->ecs.command_buffers) return 0;
+
+    uint32_t total = 0;
+    for (uint32_t b = 0; b < app_state->ecs.command_buffer_count; b++) {
+        total += app_state->ecs.command_buffers[b].count;
+    }
+    return total;
+}
@@ -0,0 +1,85 @@
+#ifndef ECS_COMMANDS_H
+#define ECS_COMMANDS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "types.h"
+#include "components.h"
+
+struct AppState;
+
+// Command buffer configuration
+#define ECS_COMMAND_MAX_BUFFERS 32                 // Main thread plus up to 31 workers
+#define ECS_COMMAND_CREATE_BITS 14
+#define ECS_COMMAND_MAX_CREATES (1u << ECS_COMMAND_CREATE_BITS) // Creates per buffer between flushes
+
+// Provisional handles returned by ecs_cmd_create live in the top half of the index
+// space, far above MAX_ENTITIES, so entity_exists() rejects them until they are resolved.
+// Index layout: provisional bit | buffer (5 bits) | create number (14 bits)
+#define ECS_COMMAND_PROVISIONAL_BIT (1u << (ENTITY_INDEX_BITS - 1))
+#define ECS_ENTITY_IS_PROVISIONAL(entity) \
+    ((entity) != INVALID_ENTITY && (ENTITY_INDEX(entity) & ECS_COMMAND_PROVISIONAL_BIT) != 0)
+
+typedef enum {
+    ECS_COMMAND_CREATE,
+    ECS_COMMAND_DESTROY,
+    ECS_COMMAND_ADD,        // Attach a component, overwriting it if present
+    ECS_COMMAND_REMOVE,
+    ECS_COMMAND_SET         // Overwrite a component only if the entity has it
+} ECSCommandType;
+
+typedef struct {
+    ECSCommandType type;
+    Entity entity;              // Real or provisional handle
+    uint32_t component_id;
+    uint32_t data_offset;       // Payload offset in the buffer's data arena
+} ECSCommand;
+
+// Commands recorded by one thread, in record order
+typedef struct ECSCommandBuffer {
+    ECSCommand *commands;
+    uint32_t count;
+    uint32_t capacity;
+
+    uint8_t *data;              // Arena holding copies of component payloads
+    uint32_t data_size;
+    uint32_t data_capacity;
+
+    Entity created[ECS_COMMAND_MAX_CREATES]; // Real handles for this buffer's creates, filled in by the flush
+    uint32_t create_count;
+    bool created_resolved;      // created[] holds the last flush's results
+} ECSCommandBuffer;
+
+// Buffer lifetime, called from ecs_init/ecs_shutdown
+bool ecs_commands_init(struct AppState *app_state, uint32_t buffer_count);
+void ecs_commands_cleanup(struct AppState *app_state);
+
+// Recording. Each thread records into its own buffer (main thread or pool worker),
+// so these never lock. Nothing touches the world until ecs_commands_flush().
+// Targets must be live entities or provisional handles from a pending create.
+Entity ecs_cmd_create(struct AppState *app_state);
+bool ecs_cmd_destroy(struct AppState *app_state, Entity entity);
+bool ecs_cmd_add(struct AppState *app_state, Entity entity, uint32_t component_id, const void *data);
+bool ecs_cmd_remove(struct AppState *app_state, Entity entity, uint32_t component_id);
+bool ecs_cmd_set(struct AppState *app_state, Entity entity, uint32_t component_id, const void *data);
+
+// Typed forms, e.g. ECS_CMD_ADD(app_state, entity, Position, &position)
+#define ECS_CMD_ADD(app_state, entity, name, data) ecs_cmd_add((app_state), (entity), COMPONENT_ID_##name, (data))
+#define ECS_CMD_SET(app_state, entity, name, data) ecs_cmd_set((app_state), (entity), COMPONENT_ID_##name, (data))
+#define ECS_CMD_REMOVE(app_state, entity, name) ecs_cmd_remove((app_state), (entity), COMPONENT_ID_##name)
+
+// Apply every buffer as one batch sorted by (entity, buffer, record order).
+// Creates resolve first; each entity's commands then fold into a single storage change.
+// Called by system_run_all at sync points, or by main-thread setup code that recorded
+// commands outside a system run; main thread only.
+void ecs_commands_flush(struct AppState *app_state);
+
+// Real handle for a provisional one after the flush that created it (INVALID_ENTITY if the
+// create failed). Valid until the recording thread's next ecs_cmd_create.
+Entity ecs_commands_resolve(struct AppState *app_state, Entity entity);
+
+// Number of commands waiting to be flushed
+uint32_t ecs_commands_pending(struct AppState *app_state);
+
+#endif // ECS_COMMANDS_H
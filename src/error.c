@@ -1,30 +1,57 @@
 #include "error.h"
 #include "appstate.h"
 #include "log.h"
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
 
+// The calling thread's error context. Threads other than the one that created the
+// AppState get their own, so a failure on a worker never touches the main thread's.
+static ErrorContext *error_context(AppState *app_state) {
+    if (SDL_ThreadID() == app_state->main_thread || app_state->error_tls == 0) {
+        return &app_state->error;
+    }
+    
+    ErrorContext *context = SDL_TLSGet(app_state->error_tls);
+    if (!context) {
+        context = calloc(1, sizeof(ErrorContext));
+        if (!context || SDL_TLSSet(app_state->error_tls, context, free) != 0) {
+            free(context);
+            return NULL;
+        }
+    }
+    return context;
+}
+
 void error_set(Result result, const char *message, const char *file, int line, const char *function, AppState *app_state) {
     if (!app_state) {
         LOG_ERROR("AppState is NULL in error_set - cannot store error");
         return;
     }
     
-    app_state->error.result = result;
-    app_state->error_counter++;
+    ErrorContext *context = error_context(app_state);
+    if (!context) {
+        LOG_ERROR("No error context for this thread: %s", message ? message : "");
+        return;
+    }
+    
+    context->result = result;
+    if (context == &app_state->error) {
+        app_state->error_counter++;
+    }
     
     // Store error context
-    app_state->error.file = file;
-    app_state->error.line = line;
-    app_state->error.function = function;
+    context->file = file;
+    context->line = line;
+    context->function = function;
     
     // Copy message
     if (message) {
-        strncpy(app_state->error.message, message, sizeof(app_state->error.message) - 1);
-        app_state->error.message[sizeof(app_state->error.message) - 1] = '\0';
+        strncpy(context->message, message, sizeof(context->message) - 1);
+        context->message[sizeof(context->message) - 1] = '\0';
     } else {
-        app_state->error.message[0] = '\0';
+        context->message[0] = '\0';
     }
 }
 
@@ -34,8 +61,10 @@ void error_clear(AppState *app_state) {
         return;
     }
     
-    memset(&app_state->error, 0, sizeof(ErrorContext));
-    app_state->error.result = RESULT_OK;
+    ErrorContext *context = error_context(app_state);
+    if (!context) return;
+    memset(context, 0, sizeof(ErrorContext));
+    context->result = RESULT_OK;
 }
 
 Result error_get_last(AppState *app_state) {
@@ -44,7 +73,8 @@ Result error_get_last(AppState *app_state) {
         return RESULT_ERROR_NULL_POINTER;
     }
     
-    return app_state->error.result;
+    ErrorContext *context = error_context(app_state);
+    return context ? context->result : RESULT_ERROR_UNKNOWN;
 }
 
 bool error_has_error(AppState *app_state) {
@@ -53,7 +83,8 @@ bool error_has_error(AppState *app_state) {
         return true; // Assume error if AppState is NULL
     }
     
-    return app_state->error.result != RESULT_OK;
+    ErrorContext *context = error_context(app_state);
+    return !context || context->result != RESULT_OK;
 }
 
 const char* error_code_to_string(Result code) {
@@ -11,28 +11,26 @@ void field_init(FieldOfView *fov, int radius) {
     fov->radius = radius;
     
     // Initialize all tiles as not visible and not explored
-    for (int y = 0; y < DUNGEON_HEIGHT; y++) {
-        for (int x = 0; x < DUNGEON_WIDTH; x++) {
-            fov->visible[x][y] = false;
-            fov->explored[x][y] = false;
-        }
-    }
+    memset(fov->visible, 0, sizeof(fov->visible));
+    memset(fov->explored, 0, sizeof(fov->explored));
 }
 
 // Initialize compact field of view component
 void field_init_compact(CompactFieldOfView *fov, int radius) {
     if (!fov) return;
     
+    // The visible grid is sized for FOV_MAX_RADIUS
+    if (radius < 0) radius = 0;
+    if (radius > FOV_MAX_RADIUS) radius = FOV_MAX_RADIUS;
+    
     fov->radius = radius;
     fov->center_x = 0;
     fov->center_y = 0;
+    fov->algorithm = FOV_ALGORITHM_SHADOWCAST;
+    fov->cache_valid = false;
     
     // Initialize compact visible grid
-    for (int y = 0; y < FOV_GRID_SIZE; y++) {
-        for (int x = 0; x < FOV_GRID_SIZE; x++) {
-            fov->visible[x][y] = false;
-        }
-    }
+    memset(fov->visible, 0, sizeof(fov->visible));
 }
 
 // Initialize compact field of view component (allocates memory)
@@ -71,8 +69,7 @@ static bool blocks_sight(Dungeon *dungeon, int x, int y) {
     Tile *tile = dungeon_get_tile(dungeon, x, y);
     if (!tile) return true;
     
-    // Walls block sight, floors don't
-    return tile->type == TILE_TYPE_WALL;
+    return dungeon_tile_blocks_sight(tile->type);
 }
 
 // Cast a ray from start to end and mark visible tiles
@@ -100,8 +97,8 @@ static void cast_ray(FieldOfView *fov, Dungeon *dungeon, int start_x, int start_
         }
         
         // Mark as visible and explored
-        fov->visible[x][y] = true;
-        fov->explored[x][y] = true;
+        bitrow_set(fov->visible[x], y);
+        bitrow_set(fov->explored[x], y);
         
         // Check if we've reached the end point
         if (x == end_x && y == end_y) {
@@ -154,14 +151,11 @@ static void cast_ray_compact(CompactFieldOfView *fov, Dungeon *dungeon, int star
         int compact_x, compact_y;
         world_to_compact_coords(fov, x, y, &compact_x, &compact_y);
         
-        // Mark as visible in compact grid if within bounds
+        // Mark as visible in compact grid if within bounds; explored is merged afterwards
         if (is_in_compact_bounds(compact_x, compact_y)) {
-            fov->visible[compact_x][compact_y] = true;
+            bitrow_set(fov->visible[compact_x], compact_y);
         }
         
-        // Mark as explored in dungeon tile
-        dungeon_mark_explored(dungeon, x, y);
-        
         // Check if we've reached the end point
         if (x == end_x && y == end_y) {
             break;
@@ -215,8 +209,322 @@ void field_calculate_fov(FieldOfView *fov, Dungeon *dungeon, int start_x, int st
     }
 }
 
-// Calculate compact field of view using raycasting
+// Octant transforms: world = origin + col * (xx, yx) + depth * (xy, yy)
+static const int OCTANT_TRANSFORMS[8][4] = {
+    { 1,  0,  0,  1}, { 0,  1,  1,  0}, { 0, -1,  1,  0}, {-1,  0,  0,  1},
+    {-1,  0,  0, -1}, { 0, -1, -1,  0}, { 0,  1, -1,  0}, { 1,  0,  0, -1}
+};
+
+// State shared by every row of one shadowcast
+typedef struct {
+    uint64_t *grid;               // (2r+1) bit rows of row_words words, origin at (r, r)
+    size_t row_words;
+    const Tile (*tiles)[DUNGEON_HEIGHT];
+    const FovOpacityMap *opacity; // Read instead of tiles when set
+    int width, height;            // Runtime dungeon size; anything outside blocks sight
+    int origin_x, origin_y;
+    int radius;
+    int radius_sq;                // Inclusion limit for dx*dx + dy*dy
+} ShadowcastContext;
+
+static bool shadowcast_blocks(const ShadowcastContext *ctx, int x, int y) {
+    return ctx->opacity ? bitrow_test(ctx->opacity->blocks[x], y) : dungeon_tile_blocks_sight(ctx->tiles[x][y].type);
+}
+
+// Floor division for a positive divisor
+static int floor_div(int numerator, int denominator) {
+    return numerator >= 0 ? numerator / denominator : -((-numerator + denominator - 1) / denominator);
+}
+
+// Scan one row of an octant between two slopes, recursing into the next row for every
+// lit span. Slopes are fractions with positive denominators; a tile's edge slope is
+// (2 * col - 1) / (2 * depth), so all tests are integer cross-multiplications.
+static void shadowcast_row(const ShadowcastContext *ctx, const int *transform, int depth,
+                           int start_num, int start_den, int end_num, int end_den) {
+    if (depth > ctx->radius) return;
+
+    // Tiles whose centers fall in [start, end], rounding ties toward the inside
+    int min_col = floor_div(2 * depth * start_num + start_den, 2 * start_den);
+    int max_col = -floor_div(-(2 * depth * end_num - end_den), 2 * end_den);
+    if (max_col > depth) max_col = depth;
+
+    bool previous_set = false;
+    bool previous_wall = false;
+    for (int col = min_col; col <= max_col; col++) {
+        int x = ctx->origin_x + col * transform[0] + depth * transform[1];
+        int y = ctx->origin_y + col * transform[2] + depth * transform[3];
+        bool in_bounds = x >= 0 && x < ctx->width && y >= 0 && y < ctx->height;
+        bool wall = !in_bounds || shadowcast_blocks(ctx, x, y);
+
+        // Walls are lit when any part is in view; floors only when their center is, which
+        // keeps visibility symmetric between any two floor tiles
+        if (in_bounds && col * col + depth * depth <= ctx->radius_sq &&
+            (wall || (col * start_den >= depth * start_num && col * end_den <= depth * end_num))) {
+            uint64_t *row = ctx->grid + (size_t)(x - ctx->origin_x + ctx->radius) * ctx->row_words;
+            bitrow_set(row, y - ctx->origin_y + ctx->radius);
+        }
+
+        if (previous_set && previous_wall && !wall) {
+            start_num = 2 * col - 1;
+            start_den = 2 * depth;
+        } else if (previous_set && !previous_wall && wall) {
+            shadowcast_row(ctx, transform, depth + 1, start_num, start_den, 2 * col - 1, 2 * depth);
+        }
+        previous_set = true;
+        previous_wall = wall;
+    }
+
+    if (previous_set && !previous_wall) {
+        shadowcast_row(ctx, transform, depth + 1, start_num, start_den, end_num, end_den);
+    }
+}
+
+// Light the origin and scan all eight octants into ctx->grid
+static void shadowcast(ShadowcastContext *ctx, int start_x, int start_y, int radius) {
+    ctx->origin_x = start_x;
+    ctx->origin_y = start_y;
+    ctx->radius = radius;
+    ctx->radius_sq = radius * radius + radius;  // round circle at radius + 0.5
+    if (start_x < 0 || start_x >= ctx->width || start_y < 0 || start_y >= ctx->height) return;
+    
+    bitrow_set(ctx->grid + (size_t)radius * ctx->row_words, radius);
+    
+    // Each octant covers slopes 0..1 from its axis to its diagonal
+    for (int octant = 0; octant < 8; octant++) {
+        shadowcast_row(ctx, OCTANT_TRANSFORMS[octant], 1, 0, 1, 1, 1);
+    }
+}
+
+// Calculate compact field of view using symmetric recursive shadowcasting
+void field_calculate_fov_shadowcast(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y) {
+    if (!fov || !dungeon) return;
+    
+    fov->center_x = start_x;
+    fov->center_y = start_y;
+    field_clear_visibility_compact(fov);
+    
+    ShadowcastContext ctx = {
+        .grid = &fov->visible[0][0],
+        .row_words = FOV_GRID_WORDS,
+        .tiles = (const Tile (*)[DUNGEON_HEIGHT])dungeon->tiles,
+        .opacity = NULL,
+        .width = dungeon->width < DUNGEON_WIDTH ? dungeon->width : DUNGEON_WIDTH,
+        .height = dungeon->height < DUNGEON_HEIGHT ? dungeon->height : DUNGEON_HEIGHT
+    };
+    shadowcast(&ctx, start_x, start_y, fov->radius);
+    
+    field_merge_explored_compact(fov, dungeon);
+}
+
+void field_opacity_map_update(FovOpacityMap *map, const Dungeon *dungeon) {
+    if (!map || !dungeon) return;
+    
+    map->width = dungeon->width < DUNGEON_WIDTH ? dungeon->width : DUNGEON_WIDTH;
+    map->height = dungeon->height < DUNGEON_HEIGHT ? dungeon->height : DUNGEON_HEIGHT;
+    if (map->valid && map->opacity_version == dungeon->opacity_version) return;
+    
+    // A few logged edits behind: flip just those tiles
+    uint32_t behind = dungeon->opacity_version - map->opacity_version;
+    if (map->valid && map->opacity_version >= dungeon->edit_log_floor && behind <= DUNGEON_EDIT_LOG_SIZE) {
+        for (uint32_t version = map->opacity_version + 1; version != dungeon->opacity_version + 1; version++) {
+            const DungeonEdit *edit = &dungeon->edit_log[version % DUNGEON_EDIT_LOG_SIZE];
+            uint64_t bit = (uint64_t)1 << (edit->y & 63);
+            if (dungeon_tile_blocks_sight(dungeon->tiles[edit->x][edit->y].type)) {
+                map->blocks[edit->x][edit->y >> 6] |= bit;
+            } else {
+                map->blocks[edit->x][edit->y >> 6] &= ~bit;
+            }
+        }
+        map->opacity_version = dungeon->opacity_version;
+        return;
+    }
+    
+    memset(map->blocks, 0, sizeof(map->blocks));
+    for (int x = 0; x < DUNGEON_WIDTH; x++) {
+        for (int y = 0; y < DUNGEON_HEIGHT; y++) {
+            if (dungeon_tile_blocks_sight(dungeon->tiles[x][y].type)) {
+                bitrow_set(map->blocks[x], y);
+            }
+        }
+    }
+    map->opacity_version = dungeon->opacity_version;
+    map->valid = true;
+}
+
+void field_shadowcast_grid(const FovOpacityMap *map, int start_x, int start_y, int radius,
+                           uint64_t *grid, size_t row_words) {
+    if (!map || !grid || radius < 0) return;
+    
+    memset(grid, 0, (size_t)(radius * 2 + 1) * row_words * sizeof(uint64_t));
+    ShadowcastContext ctx = {
+        .grid = grid,
+        .row_words = row_words,
+        .tiles = NULL,
+        .opacity = map,
+        .width = map->width,
+        .height = map->height
+    };
+    shadowcast(&ctx, start_x, start_y, radius);
+}
+
+// Line of sight tables: for every (dx, dy) within LOS_MAX_RANGE, the Bresenham
+// steps strictly between (0, 0) and (dx, dy). A line of Chebyshev length n has n - 1
+// of them, so the 8n lines at length n need 8n(n - 1) steps in total.
+#define LOS_TABLE_SIZE (LOS_MAX_RANGE * 2 + 1)
+#define LOS_STEP_CAPACITY (8 * LOS_MAX_RANGE * (LOS_MAX_RANGE + 1) * (LOS_MAX_RANGE - 1) / 3)
+
+typedef struct {
+    int8_t dx, dy;
+} LosStep;
+
+static LosStep los_steps[LOS_STEP_CAPACITY];
+static uint32_t los_first[LOS_TABLE_SIZE][LOS_TABLE_SIZE]; // [dx + range][dy + range]
+static uint8_t los_count[LOS_TABLE_SIZE][LOS_TABLE_SIZE];
+static bool los_built = false;
+
+void field_los_init(void) {
+    if (los_built) return;
+    
+    uint32_t used = 0;
+    for (int dx = -LOS_MAX_RANGE; dx <= LOS_MAX_RANGE; dx++) {
+        for (int dy = -LOS_MAX_RANGE; dy <= LOS_MAX_RANGE; dy++) {
+            los_first[dx + LOS_MAX_RANGE][dy + LOS_MAX_RANGE] = used;
+            
+            // Same stepping as cast_ray, stopping short of the target
+            int adx = abs(dx), ady = abs(dy);
+            int sx = dx > 0 ? 1 : -1, sy = dy > 0 ? 1 : -1;
+            int err = adx - ady;
+            int x = 0, y = 0;
+            uint8_t count = 0;
+            for (;;) {
+                int e2 = 2 * err;
+                if (e2 > -ady) {
+                    err -= ady;
+                    x += sx;
+                }
+                if (e2 < adx) {
+                    err += adx;
+                    y += sy;
+                }
+                if (x == dx && y == dy) break;
+                los_steps[used++] = (LosStep){(int8_t)x, (int8_t)y};
+                count++;
+            }
+            los_count[dx + LOS_MAX_RANGE][dy + LOS_MAX_RANGE] = count;
+        }
+    }
+    los_built = true;
+}
+
+// Walk a precomputed line, stopping at the first blocking tile. Without check_bounds
+// every step must lie on the map (the caller checked the origin's whole range).
+static bool los_walk(const FovOpacityMap *map, int from_x, int from_y, int dx, int dy, bool check_bounds) {
+    const LosStep *step = &los_steps[los_first[dx + LOS_MAX_RANGE][dy + LOS_MAX_RANGE]];
+    const LosStep *end = step + los_count[dx + LOS_MAX_RANGE][dy + LOS_MAX_RANGE];
+    for (; step < end; step++) {
+        int x = from_x + step->dx;
+        int y = from_y + step->dy;
+        if (check_bounds && (x < 0 || x >= map->width || y < 0 || y >= map->height)) return false;
+        if (bitrow_test(map->blocks[x], y)) return false;
+    }
+    return true;
+}
+
+static bool los_on_map(const FovOpacityMap *map, int x, int y) {
+    return x >= 0 && x < map->width && y >= 0 && y < map->height;
+}
+
+bool field_has_los(const FovOpacityMap *map, int from_x, int from_y, int to_x, int to_y) {
+    if (!map || !map->valid) return false;
+    
+    int dx = to_x - from_x;
+    int dy = to_y - from_y;
+    if (abs(dx) > LOS_MAX_RANGE || abs(dy) > LOS_MAX_RANGE) return false;
+    if (!los_on_map(map, from_x, from_y) || !los_on_map(map, to_x, to_y)) return false;
+    
+    field_los_init();
+    return los_walk(map, from_x, from_y, dx, dy, true);
+}
+
+uint32_t field_has_los_batch(const FovOpacityMap *map, int from_x, int from_y,
+                             const LosTarget *targets, uint32_t count, bool *visible) {
+    if (!targets || !visible) return 0;
+    if (!map || !map->valid || !los_on_map(map, from_x, from_y)) {
+        memset(visible, 0, count * sizeof(bool));
+        return 0;
+    }
+    
+    field_los_init();
+    
+    // Lines stay inside the box spanned by their ends, so when the origin's whole range
+    // is on the map no step needs a bounds check
+    bool check_bounds = !(from_x - LOS_MAX_RANGE >= 0 && from_x + LOS_MAX_RANGE < map->width &&
+                          from_y - LOS_MAX_RANGE >= 0 && from_y + LOS_MAX_RANGE < map->height);
+    
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        int dx = targets[i].x - from_x;
+        int dy = targets[i].y - from_y;
+        visible[i] = abs(dx) <= LOS_MAX_RANGE && abs(dy) <= LOS_MAX_RANGE &&
+                     los_on_map(map, targets[i].x, targets[i].y) &&
+                     los_walk(map, from_x, from_y, dx, dy, check_bounds);
+        seen += visible[i];
+    }
+    return seen;
+}
+
+// Calculate compact field of view with the component's algorithm
 void field_calculate_fov_compact(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y) {
+    if (!fov) return;
+    
+    if (fov->algorithm == FOV_ALGORITHM_RAYCAST) {
+        field_calculate_fov_raycast(fov, dungeon, start_x, start_y);
+    } else {
+        field_calculate_fov_shadowcast(fov, dungeon, start_x, start_y);
+    }
+    
+    fov->cache_valid = dungeon != NULL;
+    fov->cached_radius = fov->radius;
+    fov->cached_algorithm = fov->algorithm;
+    fov->opacity_version = dungeon ? dungeon->opacity_version : 0;
+}
+
+// Whether the grid still matches the dungeon; catches up opacity_version past edits
+// that fall outside the FOV's square
+static bool fov_cache_is_current(CompactFieldOfView *fov, const Dungeon *dungeon, int start_x, int start_y) {
+    if (!fov->cache_valid || fov->center_x != start_x || fov->center_y != start_y ||
+        fov->cached_radius != fov->radius || fov->cached_algorithm != fov->algorithm) {
+        return false;
+    }
+    if (fov->opacity_version == dungeon->opacity_version) return true;
+    
+    // Whole-map changes since, or more edits than the log remembers
+    uint32_t behind = dungeon->opacity_version - fov->opacity_version;
+    if (fov->opacity_version < dungeon->edit_log_floor || behind > DUNGEON_EDIT_LOG_SIZE) {
+        return false;
+    }
+    
+    for (uint32_t version = fov->opacity_version + 1; version != dungeon->opacity_version + 1; version++) {
+        const DungeonEdit *edit = &dungeon->edit_log[version % DUNGEON_EDIT_LOG_SIZE];
+        if (abs(edit->x - start_x) <= fov->radius && abs(edit->y - start_y) <= fov->radius) {
+            return false;
+        }
+    }
+    fov->opacity_version = dungeon->opacity_version;
+    return true;
+}
+
+bool field_update_fov_compact(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y) {
+    if (!fov || !dungeon) return false;
+    
+    if (fov_cache_is_current(fov, dungeon, start_x, start_y)) return false;
+    
+    field_calculate_fov_compact(fov, dungeon, start_x, start_y);
+    return true;
+}
+
+// Calculate compact field of view using raycasting
+void field_calculate_fov_raycast(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y) {
     if (!fov || !dungeon) return;
     
     // Update center position
@@ -247,6 +555,8 @@ void field_calculate_fov_compact(CompactFieldOfView *fov, Dungeon *dungeon, int
         int end_y = start_y + directions[i][1] * fov->radius;
         cast_ray_compact(fov, dungeon, start_x, start_y, end_x, end_y);
     }
+    
+    field_merge_explored_compact(fov, dungeon);
 }
 
 // Check if a position is visible
@@ -254,7 +564,7 @@ bool field_is_visible(FieldOfView *fov, int x, int y) {
     if (!fov || !is_in_bounds(x, y)) {
         return false;
     }
-    return fov->visible[x][y];
+    return bitrow_test(fov->visible[x], y);
 }
 
 // Check if a position is visible (compact version)
@@ -272,7 +582,7 @@ bool field_is_visible_compact(CompactFieldOfView *fov, int x, int y) {
         return false;
     }
     
-    return fov->visible[compact_x][compact_y];
+    return bitrow_test(fov->visible[compact_x], compact_y);
 }
 
 // Check if a position has been explored
@@ -280,7 +590,7 @@ bool field_is_explored(FieldOfView *fov, int x, int y) {
     if (!fov || !is_in_bounds(x, y)) {
         return false;
     }
-    return fov->explored[x][y];
+    return bitrow_test(fov->explored[x], y);
 }
 
 // Check if a position has been explored (compact version)
@@ -298,7 +608,7 @@ void field_mark_explored(FieldOfView *fov, int x, int y) {
     if (!fov || !is_in_bounds(x, y)) {
         return;
     }
-    fov->explored[x][y] = true;
+    bitrow_set(fov->explored[x], y);
 }
 
 // Mark a position as explored (compact version)
@@ -314,21 +624,34 @@ void field_mark_explored_compact(CompactFieldOfView *fov, int x, int y) {
 void field_clear_visibility(FieldOfView *fov) {
     if (!fov) return;
     
-    for (int y = 0; y < DUNGEON_HEIGHT; y++) {
-        for (int x = 0; x < DUNGEON_WIDTH; x++) {
-            fov->visible[x][y] = false;
-        }
-    }
+    memset(fov->visible, 0, sizeof(fov->visible));
 }
 
 // Clear all visibility (compact version)
 void field_clear_visibility_compact(CompactFieldOfView *fov) {
     if (!fov) return;
     
-    for (int y = 0; y < FOV_GRID_SIZE; y++) {
-        for (int x = 0; x < FOV_GRID_SIZE; x++) {
-            fov->visible[x][y] = false;
-        }
+    // Only the rows of the (2r+1) square in use can have been set
+    memset(fov->visible, 0, (size_t)(fov->radius * 2 + 1) * sizeof(fov->visible[0]));
+}
+
+uint32_t field_count_visible_compact(const CompactFieldOfView *fov) {
+    if (!fov) return 0;
+    
+    return bitrow_popcount(&fov->visible[0][0], (size_t)(fov->radius * 2 + 1) * FOV_GRID_WORDS);
+}
+
+void field_merge_explored_compact(const CompactFieldOfView *fov, Dungeon *dungeon) {
+    if (!fov || !dungeon) return;
+    
+    // Row x of the grid is dungeon column center_x - radius + x, with bit 0 at center_y - radius
+    int size = fov->radius * 2 + 1;
+    int first_x = fov->center_x - fov->radius;
+    for (int x = 0; x < size; x++) {
+        int dungeon_x = first_x + x;
+        if (dungeon_x < 0 || dungeon_x >= DUNGEON_WIDTH) continue;
+        bitrow_or_shifted(dungeon->explored[dungeon_x], DUNGEON_COLUMN_WORDS, fov->visible[x], FOV_GRID_WORDS,
+                          fov->center_y - fov->radius);
     }
 }
 
@@ -339,9 +662,9 @@ uint8_t field_get_visibility_status(FieldOfView *fov, int x, int y) {
         return 0;
     }
     
-    if (fov->visible[x][y]) {
+    if (bitrow_test(fov->visible[x], y)) {
         return 1; // Currently visible
-    } else if (fov->explored[x][y]) {
+    } else if (bitrow_test(fov->explored[x], y)) {
         return 2; // Explored but not currently visible
     } else {
         return 0; // Not visible and not explored
@@ -4,34 +4,65 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "dungeon.h"
+#include "config.h"
 
 // Forward declaration removed - using dungeon.h definitions
 // DUNGEON_WIDTH and DUNGEON_HEIGHT are defined in dungeon.h
 
 // Field of view radius
-#define FOV_RADIUS 8
+#define FOV_RADIUS 8        // Default; fov.radius in the config overrides it
+#define FOV_MAX_RADIUS 32
 
-// Compact FOV representation - only store visible area around entity
-#define FOV_GRID_SIZE (FOV_RADIUS * 2 + 1)  // 17x17 grid for radius 8
+// Compact FOV representation - only store visible area around entity. The grid is
+// sized for the largest radius; a smaller radius uses its top-left corner.
+#define FOV_GRID_SIZE (FOV_MAX_RADIUS * 2 + 1)  // 65x65 grid for radius 32
+#define FOV_GRID_WORDS BITGRID_WORDS(FOV_GRID_SIZE)
+
+// Visibility grids are bitsets laid out like the dungeon's tiles: one bit row per x,
+// bit y of it for tile (x, y). Test with bitrow_test(grid[x], y).
 
 // Field of view component structure
 typedef struct {
-    bool visible[DUNGEON_WIDTH][DUNGEON_HEIGHT];
-    bool explored[DUNGEON_WIDTH][DUNGEON_HEIGHT];
+    uint64_t visible[DUNGEON_WIDTH][DUNGEON_COLUMN_WORDS];
+    uint64_t explored[DUNGEON_WIDTH][DUNGEON_COLUMN_WORDS];
     int radius;
 } FieldOfView;
 
 // Compact field of view component structure (alternative)
 typedef struct {
-    bool visible[FOV_GRID_SIZE][FOV_GRID_SIZE];
+    uint64_t visible[FOV_GRID_SIZE][FOV_GRID_WORDS];  // Bit (x, y) relative to center - radius
     int radius;
     int center_x, center_y;  // Center of the FOV grid
+    FovAlgorithm algorithm;  // Used by field_calculate_fov_compact
+    
+    // What visible was last calculated from; see field_update_fov_compact
+    bool cache_valid;
+    int cached_radius;
+    FovAlgorithm cached_algorithm;
+    uint32_t opacity_version; // Dungeon opacity_version the grid reflects
 } CompactFieldOfView;
 
+// Sight blocking of every dungeon tile as bits (set = blocks), laid out like the
+// tiles. Read-only while FOVs are calculated from it, so any number can run at once.
+typedef struct {
+    uint64_t blocks[DUNGEON_WIDTH][DUNGEON_COLUMN_WORDS];
+    int width, height;            // Runtime dungeon size
+    uint32_t opacity_version;     // Dungeon opacity_version the bits reflect
+    bool valid;
+} FovOpacityMap;
+
+// Line of sight queries reach this far along either axis
+#define LOS_MAX_RANGE FOV_MAX_RADIUS
+
+// A target for batched line of sight queries
+typedef struct {
+    int x, y;
+} LosTarget;
+
 // Shared FOV system - single global instance
 typedef struct {
-    bool visible[DUNGEON_WIDTH][DUNGEON_HEIGHT];
-    bool explored[DUNGEON_WIDTH][DUNGEON_HEIGHT];
+    uint64_t visible[DUNGEON_WIDTH][DUNGEON_COLUMN_WORDS];
+    uint64_t explored[DUNGEON_WIDTH][DUNGEON_COLUMN_WORDS];
     int radius;
     int owner_entity;  // Which entity owns this FOV
 } SharedFieldOfView;
@@ -54,15 +85,53 @@ CompactFieldOfView *init_compact_field_of_view(int radius);
 // Calculate field of view from a given position
 void field_calculate_fov(FieldOfView *fov, Dungeon *dungeon, int start_x, int start_y);
 
-// Calculate compact field of view from a given position
+// Calculate compact field of view from a given position with the component's algorithm
 void field_calculate_fov_compact(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y);
 
+// Recalculate only if the viewer moved, its radius or algorithm changed, or a tile
+// inside its (2r+1) square changed sight blocking since the last calculation.
+// Returns true if it recalculated, false if the cached grid was still current.
+bool field_update_fov_compact(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y);
+
+// Bring map up to the dungeon's opacity_version, replaying logged edits when it can
+void field_opacity_map_update(FovOpacityMap *map, const Dungeon *dungeon);
+
+// Shadowcast from (start_x, start_y) into grid: 2 * radius + 1 bit rows of row_words
+// words, bit (x, y) relative to start - radius. Reads only map and writes only grid
+// (nothing is marked explored), so it is safe to run from several threads.
+void field_shadowcast_grid(const FovOpacityMap *map, int start_x, int start_y, int radius,
+                           uint64_t *grid, size_t row_words);
+
+// Build the line of sight offset tables. Queries build them on first use; call this
+// first if queries will run on several threads.
+void field_los_init(void);
+
+// Whether to is visible from from: no tile strictly between them on the Bresenham line
+// blocks sight. Stops at the first blocking tile. False if either end is off the map
+// or they are more than LOS_MAX_RANGE apart on either axis.
+bool field_has_los(const FovOpacityMap *map, int from_x, int from_y, int to_x, int to_y);
+
+// field_has_los from one origin to many targets; visible[i] answers targets[i].
+// Returns how many are visible.
+uint32_t field_has_los_batch(const FovOpacityMap *map, int from_x, int from_y,
+                             const LosTarget *targets, uint32_t count, bool *visible);
+
+// The two compact FOV algorithms, callable directly for comparison
+void field_calculate_fov_shadowcast(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y);
+void field_calculate_fov_raycast(CompactFieldOfView *fov, Dungeon *dungeon, int start_x, int start_y);
+
 // Check if a position is visible
 bool field_is_visible(FieldOfView *fov, int x, int y);
 
 // Check if a position is visible (compact version)
 bool field_is_visible_compact(CompactFieldOfView *fov, int x, int y);
 
+// Visible tiles in the compact grid
+uint32_t field_count_visible_compact(const CompactFieldOfView *fov);
+
+// dungeon explored |= visible, a word at a time
+void field_merge_explored_compact(const CompactFieldOfView *fov, Dungeon *dungeon);
+
 // Check if a position has been explored
 bool field_is_explored(FieldOfView *fov, int x, int y);
 
@@ -0,0 +1,189 @@
+#include "fov_batch.h"
+#include "log.h"
+#include "error.h"
+#include "appstate.h"
+#include "components.h"
+#include "ecs.h"
+#include <stdlib.h>
+#include <string.h>
+
+// A contiguous run of viewers for one worker
+typedef struct {
+    FovBatch *batch;
+    uint32_t first;
+    uint32_t count;
+    FovBatchMode mode;
+    uint32_t cast;
+} FovBatchJob;
+
+bool fov_batch_init(FovBatch *batch, uint32_t viewer_capacity) {
+    if (!batch) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_NULL_POINTER, "FovBatch cannot be NULL");
+    }
+
+    memset(batch, 0, sizeof(FovBatch));
+    if (viewer_capacity == 0) viewer_capacity = 16;
+    batch->viewers = malloc(viewer_capacity * sizeof(FovViewer));
+    if (!batch->viewers) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate %u FOV viewers", viewer_capacity);
+    }
+    batch->viewer_capacity = viewer_capacity;
+    return true;
+}
+
+void fov_batch_cleanup(FovBatch *batch) {
+    if (!batch) return;
+
+    free(batch->viewers);
+    free(batch->bits);
+    memset(batch, 0, sizeof(FovBatch));
+}
+
+void fov_batch_clear(FovBatch *batch) {
+    if (!batch) return;
+
+    batch->viewer_count = 0;
+    batch->bit_words = 0;
+    batch->cast_count = 0;
+}
+
+uint32_t fov_batch_add(FovBatch *batch, Entity entity, int x, int y, int radius) {
+    if (!batch || !batch->viewers) return UINT32_MAX;
+
+    if (radius < 0) radius = 0;
+    if (radius > FOV_MAX_RADIUS) radius = FOV_MAX_RADIUS;
+    size_t row_words = BITGRID_WORDS(radius * 2 + 1);
+    size_t words = (size_t)(radius * 2 + 1) * row_words;
+
+    if (batch->viewer_count == batch->viewer_capacity) {
+        FovViewer *viewers = realloc(batch->viewers, batch->viewer_capacity * 2 * sizeof(FovViewer));
+        if (!viewers) {
+            ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Failed to grow FOV batch to %u viewers", batch->viewer_capacity * 2);
+            return UINT32_MAX;
+        }
+        batch->viewers = viewers;
+        batch->viewer_capacity *= 2;
+    }
+    if (batch->bit_words + words > batch->bit_capacity) {
+        size_t capacity = batch->bit_capacity ? batch->bit_capacity : 1024;
+        while (capacity < batch->bit_words + words) capacity *= 2;
+        uint64_t *bits = realloc(batch->bits, capacity * sizeof(uint64_t));
+        if (!bits) {
+            ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Failed to grow FOV batch grids to %zu words", capacity);
+            return UINT32_MAX;
+        }
+        batch->bits = bits;
+        batch->bit_capacity = capacity;
+    }
+
+    FovViewer *viewer = &batch->viewers[batch->viewer_count];
+    viewer->entity = entity;
+    viewer->x = x;
+    viewer->y = y;
+    viewer->radius = radius;
+    viewer->offset = batch->bit_words;
+    viewer->row_words = row_words;
+    viewer->cast = false;
+    viewer->sees_player = false;
+    batch->bit_words += words;
+    return batch->viewer_count++;
+}
+
+uint32_t fov_batch_add_entity(struct AppState *app_state, FovBatch *batch, Entity entity, int radius) {
+    Position *pos = app_state ? ECS_GET(app_state, entity, Position) : NULL;
+    if (!pos) return UINT32_MAX;
+
+    return fov_batch_add(batch, entity, (int)pos->x, (int)pos->y, radius);
+}
+
+// The player is inside the viewer's radius circle (the same test the shadowcaster uses)
+static bool player_in_reach(const FovBatch *batch, const FovViewer *viewer) {
+    int dx = batch->player_x - viewer->x;
+    int dy = batch->player_y - viewer->y;
+    return dx * dx + dy * dy <= viewer->radius * viewer->radius + viewer->radius;
+}
+
+static void fov_batch_job_run(void *data, uint32_t worker_index) {
+    (void)worker_index;
+    FovBatchJob *job = (FovBatchJob *)data;
+    FovBatch *batch = job->batch;
+
+    for (uint32_t i = job->first; i < job->first + job->count; i++) {
+        FovViewer *viewer = &batch->viewers[i];
+        bool in_reach = player_in_reach(batch, viewer);
+        viewer->cast = job->mode == FOV_BATCH_FULL || in_reach;
+        viewer->sees_player = false;
+        if (!viewer->cast) continue;
+
+        uint64_t *grid = batch->bits + viewer->offset;
+        field_shadowcast_grid(&batch->opacity, viewer->x, viewer->y, viewer->radius, grid, viewer->row_words);
+        job->cast++;
+        if (in_reach) {
+            int cx = batch->player_x - viewer->x + viewer->radius;
+            int cy = batch->player_y - viewer->y + viewer->radius;
+            viewer->sees_player = bitrow_test(grid + (size_t)cx * viewer->row_words, cy);
+        }
+    }
+}
+
+void fov_batch_run(FovBatch *batch, const Dungeon *dungeon, ThreadPool *workers,
+                   int player_x, int player_y, FovBatchMode mode) {
+    if (!batch || !dungeon) return;
+
+    field_opacity_map_update(&batch->opacity, dungeon);
+    batch->player_x = player_x;
+    batch->player_y = player_y;
+    batch->cast_count = 0;
+    if (batch->viewer_count == 0) return;
+
+    // From inside a pool job, waiting on the pool would deadlock
+    uint32_t worker_count = thread_pool_worker_count(workers);
+    if (thread_pool_current_worker(workers) != THREAD_POOL_NOT_WORKER) worker_count = 0;
+    uint32_t job_count = worker_count < batch->viewer_count ? worker_count : batch->viewer_count;
+
+    FovBatchJob jobs[THREAD_POOL_MAX_WORKERS];
+    if (job_count <= 1) {
+        jobs[0] = (FovBatchJob){batch, 0, batch->viewer_count, mode, 0};
+        fov_batch_job_run(&jobs[0], 0);
+        batch->cast_count = jobs[0].cast;
+        return;
+    }
+
+    // Contiguous shares; each job writes only its own viewers and their grids
+    uint32_t first = 0;
+    for (uint32_t j = 0; j < job_count; j++) {
+        uint32_t count = batch->viewer_count / job_count + (j < batch->viewer_count % job_count ? 1 : 0);
+        jobs[j] = (FovBatchJob){batch, first, count, mode, 0};
+        first += count;
+        if (!thread_pool_submit(workers, j, fov_batch_job_run, &jobs[j])) {
+            fov_batch_job_run(&jobs[j], j);
+        }
+    }
+    thread_pool_wait(workers);
+
+    for (uint32_t j = 0; j < job_count; j++) {
+        batch->cast_count += jobs[j].cast;
+    }
+}
+
+bool fov_batch_is_visible(const FovBatch *batch, uint32_t viewer, int x, int y) {
+    if (!batch || viewer >= batch->viewer_count) return false;
+
+    const FovViewer *v = &batch->viewers[viewer];
+    int cx = x - v->x + v->radius;
+    int cy = y - v->y + v->radius;
+    int size = v->radius * 2 + 1;
+    if (!v->cast || cx < 0 || cx >= size || cy < 0 || cy >= size) return false;
+    return bitrow_test(batch->bits + v->offset + (size_t)cx * v->row_words, cy);
+}
+
+bool fov_batch_can_see_player(const FovBatch *batch, uint32_t viewer) {
+    return batch && viewer < batch->viewer_count && batch->viewers[viewer].sees_player;
+}
+
+uint32_t fov_batch_count_visible(const FovBatch *batch, uint32_t viewer) {
+    if (!batch || viewer >= batch->viewer_count || !batch->viewers[viewer].cast) return 0;
+
+    const FovViewer *v = &batch->viewers[viewer];
+    return bitrow_popcount(batch->bits + v->offset, (size_t)(v->radius * 2 + 1) * v->row_words);
+}
@@ -0,0 +1,68 @@
+#ifndef FOV_BATCH_H
+#define FOV_BATCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "types.h"
+#include "field.h"
+#include "thread_pool.h"
+
+struct AppState;
+
+typedef enum {
+    FOV_BATCH_FULL,               // Every viewer gets its visibility set
+    FOV_BATCH_PLAYER_ONLY         // Only viewers within reach of the player are cast
+} FovBatchMode;
+
+typedef struct {
+    Entity entity;
+    int x, y;
+    int radius;
+    size_t offset;                // First word of its grid in FovBatch.bits
+    size_t row_words;             // Words per grid row: BITGRID_WORDS(2 * radius + 1)
+    bool cast;                    // Grid holds this run's result
+    bool sees_player;
+} FovViewer;
+
+// Many viewers' FOVs from one shared opacity bitmap. Each viewer's result is a
+// (2r+1)-row bit grid sized to its own radius, packed back to back in bits.
+typedef struct {
+    FovOpacityMap opacity;
+    
+    FovViewer *viewers;
+    uint32_t viewer_count;
+    uint32_t viewer_capacity;
+    
+    uint64_t *bits;
+    size_t bit_words;
+    size_t bit_capacity;
+    
+    int player_x, player_y;
+    uint32_t cast_count;          // Viewers shadowcast by the last run
+} FovBatch;
+
+bool fov_batch_init(FovBatch *batch, uint32_t viewer_capacity);
+void fov_batch_cleanup(FovBatch *batch);
+
+// Forget the viewers (keeps the opacity map and allocations)
+void fov_batch_clear(FovBatch *batch);
+
+// Add a viewer at a position, or at the entity's Position component; returns its index
+// or UINT32_MAX on failure
+uint32_t fov_batch_add(FovBatch *batch, Entity entity, int x, int y, int radius);
+uint32_t fov_batch_add_entity(struct AppState *app_state, FovBatch *batch, Entity entity, int radius);
+
+// Compute every viewer's visibility against the dungeon, split across workers (NULL or
+// a call from inside the pool runs on the calling thread). The opacity map is only
+// rebuilt where the dungeon changed since the last run.
+void fov_batch_run(FovBatch *batch, const Dungeon *dungeon, ThreadPool *workers,
+                   int player_x, int player_y, FovBatchMode mode);
+
+bool fov_batch_is_visible(const FovBatch *batch, uint32_t viewer, int x, int y);
+bool fov_batch_can_see_player(const FovBatch *batch, uint32_t viewer);
+
+// Visible tiles of one viewer
+uint32_t fov_batch_count_visible(const FovBatch *batch, uint32_t viewer);
+
+#endif // FOV_BATCH_H
@@ -0,0 +1,157 @@
+#include "frame_scheduler.h"
+#include "appstate.h"
+#include "profiler.h"
+#include "log.h"
+#include <string.h>
+
+// Block without a timeout (idle_timeout_ms == 0)
+#define FRAME_WAIT_FOREVER UINT32_MAX
+
+static const char *FRAME_MODE_NAMES[] = {"fixed", "event", "adaptive"};
+
+void frame_scheduler_init(struct AppState *app_state) {
+    if (!app_state) return;
+
+    FrameScheduler *scheduler = &app_state->frame_scheduler;
+    memset(scheduler, 0, sizeof(FrameScheduler));
+    scheduler->mode = app_state->config.frame.mode;
+    scheduler->frame_ms = app_state->config.frame.frame_ms ? app_state->config.frame.frame_ms : 16;
+    scheduler->idle_timeout_ms = app_state->config.frame.idle_timeout_ms;
+    scheduler->frequency = SDL_GetPerformanceFrequency();
+    scheduler->window_start = SDL_GetPerformanceCounter();
+    scheduler->window_cpu_start = clock();
+    scheduler->last_frame_start = SDL_GetTicks();
+
+    // Adaptive mode starts idle, so input-driven presents don't wait for a vblank
+    if (scheduler->mode == FRAME_MODE_ADAPTIVE && app_state->render.renderer) {
+        SDL_RenderSetVSync(app_state->render.renderer, 0);
+    }
+
+    LOG_INFO("Frame scheduler: %s mode, %u ms frames%s", FRAME_MODE_NAMES[scheduler->mode],
+             scheduler->frame_ms, scheduler->mode == FRAME_MODE_ADAPTIVE ? ", vsync while animating" : "");
+}
+
+// Adaptive mode: vsync on while frames are requested back to back, off once idle
+static void frame_scheduler_set_vsync(struct AppState *app_state, bool enabled) {
+    FrameScheduler *scheduler = &app_state->frame_scheduler;
+    if (scheduler->mode != FRAME_MODE_ADAPTIVE || scheduler->vsync == enabled || !app_state->render.renderer) return;
+    if (enabled && scheduler->vsync_unavailable) return;
+
+    if (SDL_RenderSetVSync(app_state->render.renderer, enabled ? 1 : 0) != 0) {
+        if (enabled) {
+            LOG_WARN("VSync unavailable (%s), pacing animation frames with sleeps", SDL_GetError());
+            scheduler->vsync_unavailable = true;
+        }
+        return;
+    }
+    scheduler->vsync = enabled;
+}
+
+void frame_scheduler_cleanup(struct AppState *app_state) {
+    if (!app_state) return;
+
+    FrameScheduler *scheduler = &app_state->frame_scheduler;
+    LOG_INFO("Frame scheduler: %llu frames, %llu idle wakeups, last window %.1f%% idle, %.1f%% CPU (idle CPU %.1f%%)",
+             (unsigned long long)scheduler->frames, (unsigned long long)scheduler->idle_wakeups,
+             scheduler->idle_percent, scheduler->cpu_percent, scheduler->idle_cpu_percent);
+}
+
+// Close the metrics window once a second has passed
+static void frame_scheduler_roll_window(struct AppState *app_state) {
+    FrameScheduler *scheduler = &app_state->frame_scheduler;
+    uint64_t now = SDL_GetPerformanceCounter();
+    uint64_t elapsed = now - scheduler->window_start;
+    if (scheduler->frequency == 0 || elapsed < scheduler->frequency) return;
+
+    double wall_seconds = (double)elapsed / (double)scheduler->frequency;
+    clock_t cpu_now = clock();
+    double cpu_seconds = (double)(cpu_now - scheduler->window_cpu_start) / CLOCKS_PER_SEC;
+
+    scheduler->idle_percent = (float)(100.0 * (double)scheduler->window_idle_ticks / (double)elapsed);
+    scheduler->cpu_percent = (float)(100.0 * cpu_seconds / wall_seconds);
+    if (scheduler->window_frames == 0) {
+        scheduler->idle_cpu_percent = scheduler->cpu_percent;
+    }
+    scheduler->frames_per_second = (uint32_t)(scheduler->window_frames / wall_seconds + 0.5);
+
+    profiler_count(app_state, "Idle %", (uint32_t)(scheduler->idle_percent + 0.5f));
+    profiler_count(app_state, "CPU %", (uint32_t)(scheduler->cpu_percent + 0.5f));
+    profiler_count(app_state, "Frames/s", scheduler->frames_per_second);
+
+    scheduler->window_start = now;
+    scheduler->window_idle_ticks = 0;
+    scheduler->window_cpu_start = cpu_now;
+    scheduler->window_frames = 0;
+}
+
+// Wait up to timeout_ms for an event, counting the time as idle
+static bool frame_scheduler_block(FrameScheduler *scheduler, SDL_Event *event, uint32_t timeout_ms) {
+    uint64_t start = SDL_GetPerformanceCounter();
+    int received;
+    if (timeout_ms == FRAME_WAIT_FOREVER) {
+        received = SDL_WaitEvent(event);
+    } else {
+        received = SDL_WaitEventTimeout(event, (int)timeout_ms);
+    }
+    scheduler->window_idle_ticks += SDL_GetPerformanceCounter() - start;
+    return received != 0;
+}
+
+FrameWake frame_scheduler_wait(struct AppState *app_state, SDL_Event *event) {
+    if (!app_state || !event) return FRAME_WAKE_NONE;
+
+    FrameScheduler *scheduler = &app_state->frame_scheduler;
+    uint32_t now = SDL_GetTicks();
+    uint32_t since_frame = now - scheduler->last_frame_start;
+    uint32_t pacing = since_frame < scheduler->frame_ms ? scheduler->frame_ms - since_frame : 0;
+    FrameWake wake = FRAME_WAKE_NONE;
+
+    if (scheduler->mode == FRAME_MODE_FIXED) {
+        // Legacy cadence: sleep out the rest of the frame and run regardless
+        if (pacing > 0) {
+            uint64_t start = SDL_GetPerformanceCounter();
+            SDL_Delay(pacing);
+            scheduler->window_idle_ticks += SDL_GetPerformanceCounter() - start;
+        }
+        wake = FRAME_WAKE_TICK;
+    } else if (scheduler->requested_frames > 0) {
+        // Animating: keep to frame_ms unless vsync paces us at present; input still wakes early
+        frame_scheduler_set_vsync(app_state, true);
+        if (!scheduler->vsync && pacing > 0 && frame_scheduler_block(scheduler, event, pacing)) {
+            wake = FRAME_WAKE_EVENT;
+        } else {
+            wake = FRAME_WAKE_REQUESTED;
+        }
+    } else {
+        // Idle: block until input or the idle timeout
+        frame_scheduler_set_vsync(app_state, false);
+        uint32_t timeout = scheduler->idle_timeout_ms ? scheduler->idle_timeout_ms : FRAME_WAIT_FOREVER;
+        if (frame_scheduler_block(scheduler, event, timeout)) {
+            wake = FRAME_WAKE_EVENT;
+        }
+    }
+
+    // Whatever woke us, the coming frame satisfies one request
+    if (wake != FRAME_WAKE_NONE) {
+        if (scheduler->requested_frames > 0) scheduler->requested_frames--;
+    } else {
+        scheduler->idle_wakeups++;
+    }
+
+    frame_scheduler_roll_window(app_state);
+    return wake;
+}
+
+void frame_scheduler_frame_begin(struct AppState *app_state) {
+    if (!app_state) return;
+
+    FrameScheduler *scheduler = &app_state->frame_scheduler;
+    scheduler->last_frame_start = SDL_GetTicks();
+    scheduler->frames++;
+    scheduler->window_frames++;
+}
+
+void frame_scheduler_request_frame(struct AppState *app_state) {
+    if (!app_state) return;
+    app_state->frame_scheduler.requested_frames++;
+}
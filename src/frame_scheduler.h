@@ -0,0 +1,65 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "config.h"
+
+// Why frame_scheduler_wait returned
+typedef enum {
+    FRAME_WAKE_NONE = 0,          // Idle timeout expired with nothing to do; skip the frame
+    FRAME_WAKE_EVENT,             // An SDL event arrived and was returned to the caller
+    FRAME_WAKE_REQUESTED,         // A frame was requested (animation, follow-up work)
+    FRAME_WAKE_TICK               // Fixed mode cadence
+} FrameWake;
+
+typedef struct {
+    FrameMode mode;
+    uint32_t frame_ms;
+    uint32_t idle_timeout_ms;
+    bool vsync;                       // Adaptive mode: vsync is on while animating, so present paces frames
+    bool vsync_unavailable;           // The renderer refused vsync; animation is paced with sleeps
+
+    uint32_t requested_frames;        // Frames still owed to frame_scheduler_request_frame
+    uint32_t last_frame_start;        // SDL_GetTicks when the last frame began
+
+    // Idle accounting, rolled over once per second
+    uint64_t frequency;               // Performance counter ticks per second
+    uint64_t window_start;
+    uint64_t window_idle_ticks;       // Time spent blocked waiting this window
+    clock_t window_cpu_start;         // Process CPU time at window start
+    uint32_t window_frames;
+
+    // Last completed window
+    float idle_percent;               // Share of wall time spent blocked
+    float cpu_percent;                // Process CPU time over wall time
+    float idle_cpu_percent;           // cpu_percent of the last window that ran no frames
+    uint32_t frames_per_second;
+
+    // Lifetime totals
+    uint64_t frames;
+    uint64_t idle_wakeups;            // Timeouts that ran no frame
+} FrameScheduler;
+
+// Forward declarations
+struct AppState;
+
+// Reads config.frame; call after render_system_init so adaptive mode can toggle vsync
+void frame_scheduler_init(struct AppState *app_state);
+void frame_scheduler_cleanup(struct AppState *app_state);
+
+// Block until the next frame should run. FRAME_WAKE_EVENT fills event; FRAME_WAKE_NONE
+// means nothing happened and the caller should skip update/render.
+FrameWake frame_scheduler_wait(struct AppState *app_state, SDL_Event *event);
+
+// Mark the start of a frame that is about to run
+void frame_scheduler_frame_begin(struct AppState *app_state);
+
+// Keep frames coming without input. Work that continues past the current frame
+// (scripted input, the live profiler overlay) asks for its next frame here; event
+// and adaptive modes otherwise wait for input or the idle timeout.
+void frame_scheduler_request_frame(struct AppState *app_state);
+
+#endif // FRAME_SCHEDULER_H
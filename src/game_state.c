@@ -3,9 +3,11 @@
 #include "ecs.h"
 #include "components.h"
 #include "template_system.h"
+#include "ecs_commands.h"
 #include "dungeon.h"
 #include "field.h"
 #include "messages.h"
+#include "render_system.h"
 #include "error.h"
 #include <stdlib.h>
 
@@ -100,7 +102,7 @@ static void char_creation_state_input(GameStateManager *manager, SDL_Event *even
             // First, remove the old template player entity
             if (app_state->player != INVALID_ENTITY) {
                 // Remove from dungeon tile system
-                Position *old_pos = (Position *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "Position"));
+                Position *old_pos = ECS_GET(app_state, app_state->player, Position);
                 if (old_pos) {
                     dungeon_remove_entity_from_position(&app_state->dungeon, app_state->player, old_pos->x, old_pos->y);
                     LOG_INFO("Removed template player from dungeon at (%d, %d)", (int)old_pos->x, (int)old_pos->y);
@@ -117,7 +119,7 @@ static void char_creation_state_input(GameStateManager *manager, SDL_Event *even
                 app_state->player = created_player;
                 
                 // Position the custom player at the stairs up location
-                Position *player_pos = (Position *)entity_get_component(app_state, created_player, component_get_id(app_state, "Position"));
+                Position *player_pos = ECS_GET(app_state, created_player, Position);
                 if (player_pos) {
                     player_pos->x = (float)app_state->dungeon.stairs_up_x;
                     player_pos->y = (float)app_state->dungeon.stairs_up_y;
@@ -156,12 +158,17 @@ static void char_creation_state_render(GameStateManager *manager, SDL_Renderer *
 static void gameplay_state_enter(GameStateManager *manager) {
     LOG_INFO("Entering gameplay state");
     manager->gameplay_data.gameplay_timer = 0.0f;
+    
+    // Gameplay frames may build their map cells on the map build thread
+    if (!render_system_start_map_build(appstate_get())) {
+        LOG_WARN("Map build thread unavailable, building map cells on the main thread");
+    }
 }
 
 static void gameplay_state_exit(GameStateManager *manager) {
     (void)manager;  // Suppress unused parameter warning
     LOG_INFO("Exiting gameplay state");
-    // Cleanup any gameplay-specific resources if needed
+    render_system_stop_map_build(appstate_get());
 }
 
 static void gameplay_state_input(GameStateManager *manager, SDL_Event *event) {
@@ -197,7 +204,11 @@ static int create_entities_and_world(void) {
     }
     // Initialize dungeon
     dungeon_init(&app_state->dungeon);
-    dungeon_generate(&app_state->dungeon);
+    if (app_state->config.dungeon.seed != 0) {
+        dungeon_generate_seeded(&app_state->dungeon, app_state->config.dungeon.seed);
+    } else {
+        dungeon_generate(&app_state->dungeon);
+    }
     LOG_INFO("Generated dungeon with %d rooms", app_state->dungeon.room_count);
     
     // Create player entity from template
@@ -209,20 +220,29 @@ static int create_entities_and_world(void) {
     
     // Add field of view component to player
     CompactFieldOfView player_fov;
-    field_init_compact(&player_fov, FOV_RADIUS);
-    if (!component_add(app_state, app_state->player, component_get_id(app_state, "FieldOfView"), &player_fov)) {
+    field_init_compact(&player_fov, (int)app_state->config.fov.radius);
+    player_fov.algorithm = app_state->config.fov.algorithm;
+    if (!ECS_ADD(app_state, app_state->player, FieldOfView, &player_fov)) {
         LOG_ERROR("Failed to add FieldOfView component to player");
         return 0;
     }
     LOG_INFO("Added compact field of view component to player");
     
     // Place player at stairs up position
-    Position *player_pos = (Position *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "Position"));
+    // Component pointers are invalidated when more components of the same type are added,
+    // so keep the player's coordinates by value while the other entities are created.
+    bool player_placed = false;
+    int player_x = 0;
+    int player_y = 0;
+    Position *player_pos = ECS_GET(app_state, app_state->player, Position);
     if (player_pos) {
         player_pos->x = (float)app_state->dungeon.stairs_up_x;
         player_pos->y = (float)app_state->dungeon.stairs_up_y;
+        player_x = player_pos->x;
+        player_y = player_pos->y;
+        player_placed = true;
         // Store player in tile
-        dungeon_place_entity_at_position(&app_state->dungeon, app_state->player, player_pos->x, player_pos->y);
+        dungeon_place_entity_at_position(&app_state->dungeon, app_state->player, player_x, player_y);
         LOG_INFO("Placed player at (%d, %d)", app_state->dungeon.stairs_up_x, app_state->dungeon.stairs_up_y);
     }
     
@@ -234,47 +254,51 @@ static int create_entities_and_world(void) {
     }
     
     // Place enemy very close to player for debugging
-    Position *enemy_pos = (Position *)entity_get_component(app_state, enemy, component_get_id(app_state, "Position"));
-    if (enemy_pos && player_pos) {
-        enemy_pos->x = player_pos->x + 1; // Right next to player
-        enemy_pos->y = player_pos->y;
+    Position *enemy_pos = ECS_GET(app_state, enemy, Position);
+    if (enemy_pos && player_placed) {
+        enemy_pos->x = player_x + 1; // Right next to player
+        enemy_pos->y = player_y;
         // Store enemy in tile
         dungeon_place_entity_at_position(&app_state->dungeon, enemy, enemy_pos->x, enemy_pos->y);
         LOG_INFO("Placed enemy (orc) at (%d, %d) - right next to player", (int)enemy_pos->x, (int)enemy_pos->y);
     }
     
-    // Create gold entity from template (treasure)
-    Entity gold = create_entity_from_template("gold");
-    if (gold == INVALID_ENTITY) {
-        LOG_ERROR("Failed to create gold entity from template");
-        return 0;
-    }
-    
-    // Place gold below the player
-    Position *gold_pos = (Position *)entity_get_component(app_state, gold, component_get_id(app_state, "Position"));
-    if (gold_pos && player_pos) {
-        gold_pos->x = player_pos->x;
-        gold_pos->y = player_pos->y + 1; // Below player
-        // Store gold in tile
-        dungeon_place_entity_at_position(&app_state->dungeon, gold, gold_pos->x, gold_pos->y);
-        LOG_INFO("Placed gold (treasure) at (%d, %d) - below player", (int)gold_pos->x, (int)gold_pos->y);
-    }
+    // The level's items are recorded into the command buffer and created in one flush:
+    // gold below the player, the sword to their left
+    static const struct { const char *template_name; int dx; int dy; } level_items[] = {
+        { "gold", 0, 1 },
+        { "sword", -1, 0 }
+    };
+    const size_t level_item_count = sizeof(level_items) / sizeof(level_items[0]);
+    Entity pending_items[sizeof(level_items) / sizeof(level_items[0])];
     
-    // Create sword entity from template
-    Entity sword = create_entity_from_template("sword");
-    if (sword == INVALID_ENTITY) {
-        LOG_ERROR("Failed to create sword entity from template");
-        return 0;
+    for (size_t i = 0; i < level_item_count; i++) {
+        pending_items[i] = create_entity_from_template_deferred(level_items[i].template_name);
+        if (pending_items[i] == INVALID_ENTITY) {
+            LOG_ERROR("Failed to record %s entity from template", level_items[i].template_name);
+            return 0;
+        }
+        
+        if (player_placed) {
+            Position item_pos = { player_x + level_items[i].dx, player_y + level_items[i].dy, INVALID_ENTITY };
+            ECS_CMD_SET(app_state, pending_items[i], Position, &item_pos);
+        }
     }
+    ecs_commands_flush(app_state);
     
-    // Place sword to the left of the player
-    Position *sword_pos = (Position *)entity_get_component(app_state, sword, component_get_id(app_state, "Position"));
-    if (sword_pos && player_pos) {
-        sword_pos->x = player_pos->x - 1; // Left of player
-        sword_pos->y = player_pos->y;
-        // Store sword in tile
-        dungeon_place_entity_at_position(&app_state->dungeon, sword, sword_pos->x, sword_pos->y);
-        LOG_INFO("Placed sword at (%d, %d) - left of player", (int)sword_pos->x, (int)sword_pos->y);
+    for (size_t i = 0; i < level_item_count; i++) {
+        Entity item = ecs_commands_resolve(app_state, pending_items[i]);
+        if (item == INVALID_ENTITY) {
+            LOG_ERROR("Failed to create %s entity from template", level_items[i].template_name);
+            return 0;
+        }
+        
+        // Store item in tile
+        Position *item_pos = ECS_GET(app_state, item, Position);
+        if (item_pos && player_placed) {
+            dungeon_place_entity_at_position(&app_state->dungeon, item, item_pos->x, item_pos->y);
+            LOG_INFO("Placed %s at (%d, %d)", level_items[i].template_name, item_pos->x, item_pos->y);
+        }
     }
     
     return 1;
@@ -0,0 +1,179 @@
+#include "glyph_atlas.h"
+#include "log.h"
+#include "error.h"
+#include "appstate.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool glyph_atlas_build(GlyphAtlas *atlas, SDL_Renderer *renderer, TTF_Font *font) {
+    if (!atlas || !renderer || !font) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_NULL_POINTER, "Glyph atlas needs a renderer and font");
+    }
+
+    memset(atlas, 0, sizeof(GlyphAtlas));
+
+    // Render every glyph once, white, and measure the largest
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface *glyph_surfaces[GLYPH_ATLAS_COUNT];
+    for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+        char text[2] = {(char)(GLYPH_ATLAS_FIRST + i), '\0'};
+        glyph_surfaces[i] = TTF_RenderText_Solid(font, text, white);
+        if (glyph_surfaces[i]) {
+            if (glyph_surfaces[i]->w > atlas->slot_width) atlas->slot_width = glyph_surfaces[i]->w;
+            if (glyph_surfaces[i]->h > atlas->slot_height) atlas->slot_height = glyph_surfaces[i]->h;
+        }
+    }
+
+    int rows = (GLYPH_ATLAS_SLOTS + GLYPH_ATLAS_COLUMNS - 1) / GLYPH_ATLAS_COLUMNS;
+    SDL_Surface *sheet = NULL;
+    if (atlas->slot_width > 0 && atlas->slot_height > 0) {
+        atlas->texture_width = atlas->slot_width * GLYPH_ATLAS_COLUMNS;
+        atlas->texture_height = atlas->slot_height * rows;
+        sheet = SDL_CreateRGBSurfaceWithFormat(0, atlas->texture_width, atlas->texture_height,
+                                               32, SDL_PIXELFORMAT_ARGB8888);
+    }
+
+    if (sheet) {
+        // New surfaces start fully transparent; Solid glyph surfaces are color keyed so only ink is copied
+        for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+            if (!glyph_surfaces[i]) continue;
+
+            SDL_Rect slot = {
+                (i % GLYPH_ATLAS_COLUMNS) * atlas->slot_width,
+                (i / GLYPH_ATLAS_COLUMNS) * atlas->slot_height,
+                glyph_surfaces[i]->w,
+                glyph_surfaces[i]->h
+            };
+            SDL_BlitSurface(glyph_surfaces[i], NULL, sheet, &slot);
+            atlas->glyphs[i] = slot;
+        }
+
+        // Last slot is opaque white so fills can share the glyph texture
+        atlas->solid = (SDL_Rect){
+            (GLYPH_ATLAS_COUNT % GLYPH_ATLAS_COLUMNS) * atlas->slot_width,
+            (GLYPH_ATLAS_COUNT / GLYPH_ATLAS_COLUMNS) * atlas->slot_height,
+            atlas->slot_width,
+            atlas->slot_height
+        };
+        SDL_FillRect(sheet, &atlas->solid, SDL_MapRGBA(sheet->format, 255, 255, 255, 255));
+
+        atlas->texture = SDL_CreateTextureFromSurface(renderer, sheet);
+        SDL_FreeSurface(sheet);
+    }
+
+    for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+        if (glyph_surfaces[i]) SDL_FreeSurface(glyph_surfaces[i]);
+    }
+
+    if (!atlas->texture) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INITIALIZATION_FAILED, "Failed to build glyph atlas: %s", SDL_GetError());
+    }
+
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+    atlas->initialized = true;
+
+    LOG_INFO("Built glyph atlas: %d glyphs in %dx%d slots", GLYPH_ATLAS_COUNT, atlas->slot_width, atlas->slot_height);
+    return true;
+}
+
+void glyph_atlas_destroy(GlyphAtlas *atlas) {
+    if (!atlas) return;
+
+    if (atlas->texture) {
+        SDL_DestroyTexture(atlas->texture);
+    }
+    memset(atlas, 0, sizeof(GlyphAtlas));
+}
+
+bool glyph_batch_init(GlyphBatch *batch, int quad_capacity) {
+    if (!batch || quad_capacity <= 0) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INVALID_PARAMETER, "Glyph batch needs a positive capacity");
+    }
+
+    memset(batch, 0, sizeof(GlyphBatch));
+    batch->vertices = malloc(sizeof(SDL_Vertex) * 4 * (size_t)quad_capacity);
+    batch->indices = malloc(sizeof(int) * 6 * (size_t)quad_capacity);
+    if (!batch->vertices || !batch->indices) {
+        glyph_batch_free(batch);
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate glyph batch for %d quads", quad_capacity);
+    }
+
+    // Quad q uses vertices 4q..4q+3 as top-left, top-right, bottom-left, bottom-right
+    for (int q = 0; q < quad_capacity; q++) {
+        int *index = &batch->indices[q * 6];
+        int base = q * 4;
+        index[0] = base;
+        index[1] = base + 1;
+        index[2] = base + 2;
+        index[3] = base + 2;
+        index[4] = base + 1;
+        index[5] = base + 3;
+    }
+    batch->quad_capacity = quad_capacity;
+    return true;
+}
+
+void glyph_batch_free(GlyphBatch *batch) {
+    if (!batch) return;
+
+    free(batch->vertices);
+    free(batch->indices);
+    memset(batch, 0, sizeof(GlyphBatch));
+}
+
+// Append one quad mapping the atlas rect (u0,v0)-(u1,v1) onto (x,y,w,h)
+static void glyph_batch_push_quad(GlyphBatch *batch, SDL_Renderer *renderer, const GlyphAtlas *atlas,
+                                  float x, float y, float w, float h,
+                                  float u0, float v0, float u1, float v1, SDL_Color color) {
+    if (batch->quad_count >= batch->quad_capacity) {
+        glyph_batch_submit(batch, renderer, atlas);
+    }
+
+    SDL_Vertex *vertex = &batch->vertices[batch->quad_count * 4];
+    vertex[0] = (SDL_Vertex){{x, y}, color, {u0, v0}};
+    vertex[1] = (SDL_Vertex){{x + w, y}, color, {u1, v0}};
+    vertex[2] = (SDL_Vertex){{x, y + h}, color, {u0, v1}};
+    vertex[3] = (SDL_Vertex){{x + w, y + h}, color, {u1, v1}};
+    batch->quad_count++;
+}
+
+void glyph_batch_add_glyph(GlyphBatch *batch, SDL_Renderer *renderer, const GlyphAtlas *atlas,
+                           char character, int x, int y, int cell_size, SDL_Color color) {
+    if (!batch || !atlas || !atlas->initialized) return;
+
+    int index = (unsigned char)character - GLYPH_ATLAS_FIRST;
+    if (index < 0 || index >= GLYPH_ATLAS_COUNT || atlas->glyphs[index].w == 0) return;
+
+    const SDL_Rect *source = &atlas->glyphs[index];
+    float tw = (float)atlas->texture_width;
+    float th = (float)atlas->texture_height;
+    glyph_batch_push_quad(batch, renderer, atlas,
+                          (float)(x + (cell_size - source->w) / 2), (float)(y + (cell_size - source->h) / 2),
+                          (float)source->w, (float)source->h,
+                          source->x / tw, source->y / th,
+                          (source->x + source->w) / tw, (source->y + source->h) / th, color);
+}
+
+void glyph_batch_add_solid(GlyphBatch *batch, SDL_Renderer *renderer, const GlyphAtlas *atlas,
+                           int x, int y, int width, int height, SDL_Color color) {
+    if (!batch || !atlas || !atlas->initialized) return;
+
+    // Sample the middle of the white block so filtering never reaches a neighbouring glyph
+    float u = (atlas->solid.x + atlas->solid.w * 0.5f) / (float)atlas->texture_width;
+    float v = (atlas->solid.y + atlas->solid.h * 0.5f) / (float)atlas->texture_height;
+    glyph_batch_push_quad(batch, renderer, atlas, (float)x, (float)y, (float)width, (float)height,
+                          u, v, u, v, color);
+}
+
+void glyph_batch_submit(GlyphBatch *batch, SDL_Renderer *renderer, const GlyphAtlas *atlas) {
+    if (!batch || batch->quad_count == 0) return;
+
+    if (renderer && atlas && atlas->texture) {
+        if (SDL_RenderGeometry(renderer, atlas->texture, batch->vertices, batch->quad_count * 4,
+                               batch->indices, batch->quad_count * 6) < 0) {
+            LOG_ERROR("SDL_RenderGeometry failed: %s", SDL_GetError());
+        }
+        batch->submits++;
+    }
+    batch->quad_count = 0;
+}
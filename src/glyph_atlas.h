@@ -0,0 +1,56 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Printable ASCII range baked into the atlas
+#define GLYPH_ATLAS_FIRST 32
+#define GLYPH_ATLAS_LAST 126
+#define GLYPH_ATLAS_COUNT (GLYPH_ATLAS_LAST - GLYPH_ATLAS_FIRST + 1)
+#define GLYPH_ATLAS_COLUMNS 16
+#define GLYPH_ATLAS_SLOTS (GLYPH_ATLAS_COUNT + 1) // Glyphs plus one solid white block
+
+// White glyphs for one font on one texture; color comes from per-vertex tint
+typedef struct {
+    SDL_Texture *texture;
+    int texture_width;
+    int texture_height;
+    int slot_width;                 // Atlas slot size (largest glyph)
+    int slot_height;
+    SDL_Rect glyphs[GLYPH_ATLAS_COUNT]; // Source rect per glyph, sized like TTF_RenderText output
+    SDL_Rect solid;                 // Opaque white block for tinted fills
+    bool initialized;
+} GlyphAtlas;
+
+// Textured quads waiting for one SDL_RenderGeometry call
+typedef struct {
+    SDL_Vertex *vertices;           // 4 per quad
+    int *indices;                   // 6 per quad, prebuilt for the full capacity
+    int quad_count;
+    int quad_capacity;
+    uint32_t submits;               // SDL_RenderGeometry calls since the counter was last reset
+} GlyphBatch;
+
+// Build the atlas once per font/renderer pair
+bool glyph_atlas_build(GlyphAtlas *atlas, SDL_Renderer *renderer, TTF_Font *font);
+void glyph_atlas_destroy(GlyphAtlas *atlas);
+
+bool glyph_batch_init(GlyphBatch *batch, int quad_capacity);
+void glyph_batch_free(GlyphBatch *batch);
+
+// Queue one character centered in a cell_size x cell_size cell. Characters outside
+// the printable range queue nothing.
+void glyph_batch_add_glyph(GlyphBatch *batch, SDL_Renderer *renderer, const GlyphAtlas *atlas,
+                           char character, int x, int y, int cell_size, SDL_Color color);
+
+// Queue a filled rectangle using the atlas solid block
+void glyph_batch_add_solid(GlyphBatch *batch, SDL_Renderer *renderer, const GlyphAtlas *atlas,
+                           int x, int y, int width, int height, SDL_Color color);
+
+// Draw everything queued, in order, with one SDL_RenderGeometry call
+void glyph_batch_submit(GlyphBatch *batch, SDL_Renderer *renderer, const GlyphAtlas *atlas);
+
+#endif // GLYPH_ATLAS_H
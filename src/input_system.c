@@ -5,10 +5,35 @@
 #include "appstate.h"
 #include "components.h"
 #include "messageview.h"
+#include "profiler.h"
+#include "render_system.h"
+#include "frame_scheduler.h"
 
 // Key state tracking for proper key press detection
 static bool key_was_down[SDL_NUM_SCANCODES] = {false};
 
+// Scripted input ring, consumed before the keyboard is read
+static Action input_script[INPUT_SCRIPT_CAPACITY];
+static uint32_t input_script_head = 0;
+static uint32_t input_script_count = 0;
+
+bool input_system_queue_action(ActionType type, int action_data) {
+    if (input_script_count >= INPUT_SCRIPT_CAPACITY) {
+        ERROR_SET(RESULT_ERROR_SYSTEM_LIMIT, "Input script full (%d actions)", INPUT_SCRIPT_CAPACITY);
+        return false;
+    }
+    
+    uint32_t tail = (input_script_head + input_script_count) % INPUT_SCRIPT_CAPACITY;
+    input_script[tail].type = type;
+    input_script[tail].action_data = action_data;
+    input_script_count++;
+    return true;
+}
+
+uint32_t input_system_queued_actions(void) {
+    return input_script_count;
+}
+
 void input_system(Entity entity, AppState *app_state) {
     if (!app_state) {
         ERROR_SET(RESULT_ERROR_NULL_POINTER, "app_state cannot be NULL");
@@ -25,7 +50,7 @@ void input_system(Entity entity, AppState *app_state) {
         return;
     }
     
-    Action *action = (Action *)entity_get_component(app_state, entity, component_get_id(app_state, "Action"));
+    Action *action = ECS_GET(app_state, entity, Action);
     if (!action) {
         // Not having an Action component is not an error for input system
         return;
@@ -35,6 +60,19 @@ void input_system(Entity entity, AppState *app_state) {
     action->type = ACTION_NONE;
     action->action_data = DIRECTION_NONE;
     
+    // Scripted input drives the player for one frame instead of the keyboard
+    if (input_script_count > 0 && entity == app_state->player) {
+        *action = input_script[input_script_head];
+        input_script_head = (input_script_head + 1) % INPUT_SCRIPT_CAPACITY;
+        input_script_count--;
+        
+        // Scripted actions play one per frame without waiting for input
+        if (input_script_count > 0) {
+            frame_scheduler_request_frame(app_state);
+        }
+        return;
+    }
+    
     // Get current keyboard state
     const Uint8 *keystate = SDL_GetKeyboardState(NULL);
     
@@ -49,6 +87,33 @@ void input_system(Entity entity, AppState *app_state) {
         key_was_down[SDL_SCANCODE_M] = false;
     }
     
+    // Handle profiler overlay toggle hotkey (Ctrl+P)
+    if (keystate[SDL_SCANCODE_P] && (SDL_GetModState() & KMOD_CTRL)) {
+        if (!key_was_down[SDL_SCANCODE_P]) {
+            profiler_toggle_overlay(app_state);
+        }
+        key_was_down[SDL_SCANCODE_P] = true;
+        return;
+    } else {
+        key_was_down[SDL_SCANCODE_P] = false;
+    }
+    
+    // Map zoom hotkeys (Ctrl+= in, Ctrl+- out)
+    if ((keystate[SDL_SCANCODE_EQUALS] || keystate[SDL_SCANCODE_MINUS]) && (SDL_GetModState() & KMOD_CTRL)) {
+        if (keystate[SDL_SCANCODE_EQUALS] && !key_was_down[SDL_SCANCODE_EQUALS]) {
+            render_system_zoom(app_state, 1);
+        }
+        if (keystate[SDL_SCANCODE_MINUS] && !key_was_down[SDL_SCANCODE_MINUS]) {
+            render_system_zoom(app_state, -1);
+        }
+        key_was_down[SDL_SCANCODE_EQUALS] = keystate[SDL_SCANCODE_EQUALS];
+        key_was_down[SDL_SCANCODE_MINUS] = keystate[SDL_SCANCODE_MINUS];
+        return;
+    } else {
+        key_was_down[SDL_SCANCODE_EQUALS] = false;
+        key_was_down[SDL_SCANCODE_MINUS] = false;
+    }
+    
     // Only process movement if message window doesn't have focus
     if (messageview_has_focus(app_state)) {
         return;
@@ -111,7 +176,7 @@ void input_system_register(void) {
         return;
     }
     
-    uint32_t component_mask = (1 << component_get_id(app_state, "Action"));
+    uint32_t component_mask = COMPONENT_BIT(Action);
     
     SystemConfig config = {
         .name = "InputSystem",
@@ -120,7 +185,10 @@ void input_system_register(void) {
         .pre_update = NULL,
         .post_update = NULL,
         .priority = SYSTEM_PRIORITY_NORMAL,
-        .dependencies = NULL
+        .dependencies = NULL,
+        // Reads the SDL keyboard state and toggles UI, so it stays on the main thread
+        .write_mask = component_mask,
+        .threading = SYSTEM_THREADING_MAIN
     };
     
     if (system_register(app_state, &config)) {
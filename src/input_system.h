@@ -2,6 +2,10 @@
 #define INPUT_SYSTEM_H
 
 #include "ecs.h"
+#include "components.h"
+
+// Scripted actions waiting to be delivered
+#define INPUT_SCRIPT_CAPACITY 256
 
 // Forward declaration
 struct AppState;
@@ -9,6 +13,11 @@ struct AppState;
 // Process input for a specific entity
 void input_system(Entity entity, struct AppState *app_state);
 
+// Queue an action for the player, delivered one per frame ahead of the keyboard.
+// Lets headless runs and benchmarks drive the game without a display.
+bool input_system_queue_action(ActionType type, int action_data);
+uint32_t input_system_queued_actions(void);
+
 // Initialize input system
 void input_system_init(void);
 
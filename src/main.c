@@ -13,12 +13,18 @@
 #include "messages.h"
 #include "messageview.h"
 #include "game_state.h"
+#include "profiler.h"
+#include "frame_scheduler.h"
 
 // Cleanup function to handle all resources
 static void cleanup_game_systems(void) {
     AppState *as = appstate_get();
     if (as && as->initialized) {
         template_system_cleanup();
+        
+        // Dump timings while systems are still registered
+        frame_scheduler_cleanup(as);
+        profiler_cleanup(as);
         ecs_shutdown(as);
         
         // Clean up view systems before render system (which calls TTF_Quit)
@@ -48,6 +54,19 @@ static void cleanup_game_systems(void) {
     }
 }
 
+// Dispatch one SDL event to the active game state
+static void handle_event(GameStateManager *state_manager, AppState *app_state, SDL_Event *event) {
+    // Render target contents are lost on these; repaint the whole game area
+    if (event->type == SDL_RENDER_TARGETS_RESET || event->type == SDL_RENDER_DEVICE_RESET) {
+        render_system_invalidate(app_state);
+    }
+    // A device reset also loses every cached text texture
+    if (event->type == SDL_RENDER_DEVICE_RESET) {
+        render_system_device_reset(app_state);
+    }
+    game_state_manager_handle_input(state_manager, event);
+}
+
 // Initialize game systems
 static int init_game_systems(void) {
     // Get AppState for ECS initialization
@@ -60,12 +79,18 @@ static int init_game_systems(void) {
     // Initialize ECS
     ecs_init(as);
     
+    // Initialize profiler (collects only when config.profiler.enabled or the overlay is toggled on)
+    profiler_init(as);
+    
     // Initialize render system (includes SDL initialization) but don't register yet
     if (!render_system_init(as)) {
         LOG_ERROR("Failed to initialize render system");
         return false;
     }
 
+    // Frame pacing needs the renderer for adaptive vsync
+    frame_scheduler_init(as);
+    
     // Initialize view systems
     playerview_init();
     statusview_init();
@@ -181,18 +206,30 @@ int main(int argc, char* argv[]) {
     
     // Timing variables for delta time
     Uint32 last_time = SDL_GetTicks();
+    AppState *app_state = appstate_get();
     
-    // Main loop - much simpler now!
+    // Main loop: the frame scheduler decides when a frame is worth running
     while (!game_state_manager_should_quit(state_manager)) {
+        SDL_Event event;
+        FrameWake wake = frame_scheduler_wait(app_state, &event);
+        if (wake == FRAME_WAKE_NONE) {
+            continue;
+        }
+        
         // Calculate delta time
         Uint32 current_time = SDL_GetTicks();
         float delta_time = (current_time - last_time) / 1000.0f;
         last_time = current_time;
         
-        // Handle input events
-        SDL_Event event;
+        frame_scheduler_frame_begin(app_state);
+        profiler_frame_begin(app_state);
+        
+        // Handle input events, starting with the one that woke us
+        if (wake == FRAME_WAKE_EVENT) {
+            handle_event(state_manager, app_state, &event);
+        }
         while (SDL_PollEvent(&event)) {
-            game_state_manager_handle_input(state_manager, &event);
+            handle_event(state_manager, app_state, &event);
         }
         
         // Update current state
@@ -201,8 +238,7 @@ int main(int argc, char* argv[]) {
         // Render current state
         game_state_manager_render(state_manager);
         
-        // Cap frame rate
-        SDL_Delay(16); // ~60 FPS
+        profiler_frame_end(app_state);
     }
     
     // Cleanup
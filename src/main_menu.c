@@ -6,26 +6,6 @@
 #include <SDL2/SDL_ttf.h>
 #include <string.h>
 
-// Helper function to render text at a specific position
-static void render_text_at_position(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, SDL_Color color) {
-    if (!font || !text) return;
-    
-    SDL_Surface *text_surface = TTF_RenderText_Solid(font, text, color);
-    if (text_surface) {
-        SDL_Texture *text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
-        if (text_texture) {
-            int text_w, text_h;
-            SDL_QueryTexture(text_texture, NULL, NULL, &text_w, &text_h);
-            
-            SDL_Rect text_rect = {x, y, text_w, text_h};
-            SDL_RenderCopy(renderer, text_texture, NULL, &text_rect);
-            
-            SDL_DestroyTexture(text_texture);
-        }
-        SDL_FreeSurface(text_surface);
-    }
-}
-
 // Main menu initialization
 void main_menu_init(MainMenu *menu) {
     if (!menu) return;
@@ -97,13 +77,13 @@ void main_menu_render(MainMenu *menu, SDL_Renderer *renderer) {
     SDL_Color gray = {128, 128, 128, 255};
     
     // Get screen dimensions
-    int screen_width = WINDOW_WIDTH * CELL_SIZE;
-    int screen_height = WINDOW_HEIGHT * CELL_SIZE;
+    int screen_width = app_state->render.window_width_px;
+    int screen_height = app_state->render.window_height_px;
     
     // Title
     int title_y = screen_height / 4;
-    render_text_at_position(renderer, large_font, "ADVENTURE GAME", screen_width / 2 - 100, title_y, white);
-    render_text_at_position(renderer, large_font, "Basic Fantasy RPG", screen_width / 2 - 80, title_y + 30, gray);
+    render_system_draw_text(app_state, renderer, large_font, "ADVENTURE GAME", screen_width / 2 - 100, title_y, white);
+    render_system_draw_text(app_state, renderer, large_font, "Basic Fantasy RPG", screen_width / 2 - 80, title_y + 30, gray);
     
     // Menu options
     const char* menu_texts[] = {
@@ -121,14 +101,14 @@ void main_menu_render(MainMenu *menu, SDL_Renderer *renderer) {
         
         // Add selection indicator
         if (i == (int)menu->selected_option) {
-            render_text_at_position(renderer, large_font, ">", screen_width / 2 - 120, y_pos, yellow);
+            render_system_draw_text(app_state, renderer, large_font, ">", screen_width / 2 - 120, y_pos, yellow);
         }
         
-        render_text_at_position(renderer, large_font, menu_texts[i], screen_width / 2 - 100, y_pos, color);
+        render_system_draw_text(app_state, renderer, large_font, menu_texts[i], screen_width / 2 - 100, y_pos, color);
     }
     
         // Instructions
-    render_text_at_position(renderer, large_font, "Use arrow keys to navigate, Enter to select", 
+    render_system_draw_text(app_state, renderer, large_font, "Use arrow keys to navigate, Enter to select", 
                             screen_width / 2 - 200, screen_height - 100, gray);
     
     SDL_RenderPresent(renderer);
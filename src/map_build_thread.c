@@ -0,0 +1,143 @@
+#include "map_build_thread.h"
+#include "log.h"
+#include "error.h"
+#include "appstate.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool map_build_thread_init(MapBuildThread *thread, uint32_t cell_count) {
+    if (!thread) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_NULL_POINTER, "MapBuildThread cannot be NULL");
+    }
+
+    memset(thread, 0, sizeof(MapBuildThread));
+    thread->snapshot.cells = calloc(cell_count, sizeof(ZBufferCell));
+    if (!thread->snapshot.cells) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate render snapshot cells");
+    }
+    return true;
+}
+
+void map_build_thread_cleanup(MapBuildThread *thread) {
+    if (!thread) return;
+
+    map_build_thread_stop(thread);
+    free(thread->snapshot.cells);
+    free(thread->snapshot.text);
+    thread->snapshot.cells = NULL;
+    thread->snapshot.text = NULL;
+    thread->snapshot.text_size = 0;
+    thread->snapshot.text_capacity = 0;
+}
+
+bool map_build_thread_start(MapBuildThread *thread) {
+    if (!thread) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_NULL_POINTER, "MapBuildThread cannot be NULL");
+    }
+    if (thread->running) return true;
+
+    // Nothing may be in flight when the builds change threads
+    map_build_thread_finish_build(thread, NULL);
+    thread->pool = thread_pool_create(1);
+    if (!thread->pool) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INITIALIZATION_FAILED, "Failed to create map build thread");
+    }
+
+    thread->running = true;
+    thread->builds = 0;
+    LOG_INFO("Map build thread started");
+    return true;
+}
+
+void map_build_thread_stop(MapBuildThread *thread) {
+    if (!thread || !thread->running) return;
+
+    map_build_thread_finish_build(thread, NULL);
+    thread_pool_destroy(thread->pool);
+    thread->pool = NULL;
+    thread->running = false;
+    LOG_INFO("Map build thread stopped after %llu builds", (unsigned long long)thread->builds);
+}
+
+RenderSnapshot *map_build_thread_begin_snapshot(MapBuildThread *thread) {
+    if (!thread) return NULL;
+
+    // The cells are about to be rebuilt
+    map_build_thread_finish_build(thread, NULL);
+
+    RenderSnapshot *snapshot = &thread->snapshot;
+    snapshot->command_count = 0;
+    snapshot->dropped_commands = 0;
+    snapshot->text_size = 0;
+    snapshot->invalidate = false;
+    snapshot->purge_text = false;
+    snapshot->sequence = ++thread->next_sequence;
+    return snapshot;
+}
+
+static void map_build_thread_build_job(void *data, uint32_t worker_index) {
+    (void)worker_index;
+    MapBuildThread *thread = (MapBuildThread *)data;
+    thread->build(&thread->snapshot, &thread->stats, thread->user);
+}
+
+void map_build_thread_build(MapBuildThread *thread, MapBuildFunction build, void *user) {
+    if (!thread || !build) return;
+
+    map_build_thread_finish_build(thread, NULL);
+    memset(&thread->stats, 0, sizeof(MapBuildStats));
+    thread->build = build;
+    thread->user = user;
+    thread->building = true;
+
+    if (thread->running && thread_pool_submit(thread->pool, 0, map_build_thread_build_job, thread)) {
+        thread->builds++;
+        return;
+    }
+    map_build_thread_build_job(thread, 0);
+}
+
+bool map_build_thread_finish_build(MapBuildThread *thread, MapBuildStats *stats) {
+    if (!thread || !thread->building) return false;
+
+    if (thread->running) {
+        thread_pool_wait(thread->pool);
+    }
+    thread->building = false;
+    if (stats) {
+        *stats = thread->stats;
+    }
+    return true;
+}
+
+bool render_snapshot_add_text(RenderSnapshot *snapshot, const char *text, uint32_t *offset) {
+    if (!snapshot || !text || !offset) return false;
+
+    size_t length = strlen(text) + 1;
+    if (length > UINT32_MAX - snapshot->text_size) return false;
+
+    if (snapshot->text_size + length > snapshot->text_capacity) {
+        size_t capacity = snapshot->text_capacity ? snapshot->text_capacity : RENDER_SNAPSHOT_TEXT_INITIAL;
+        while (capacity < snapshot->text_size + length) {
+            capacity *= 2;
+        }
+        if (capacity > UINT32_MAX) return false;
+
+        char *grown = realloc(snapshot->text, capacity);
+        if (!grown) {
+            LOG_ERROR("Failed to grow render snapshot text to %zu bytes", capacity);
+            return false;
+        }
+        snapshot->text = grown;
+        snapshot->text_capacity = (uint32_t)capacity;
+    }
+
+    *offset = snapshot->text_size;
+    memcpy(snapshot->text + snapshot->text_size, text, length);
+    snapshot->text_size += (uint32_t)length;
+    return true;
+}
+
+const char *render_snapshot_text(const RenderSnapshot *snapshot, const RenderCommand *command) {
+    return snapshot->text + command->text;
+}
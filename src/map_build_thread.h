@@ -0,0 +1,115 @@
+#ifndef MAP_BUILD_THREAD_H
+#define MAP_BUILD_THREAD_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "thread_pool.h"
+#include "zbuffer.h"
+
+#define RENDER_SNAPSHOT_MAX_COMMANDS 128
+#define RENDER_SNAPSHOT_TEXT_INITIAL 4096  // Text arena bytes before the first grow
+
+typedef enum {
+    RENDER_COMMAND_FILL,          // rect in color; alpha < 255 blends
+    RENDER_COMMAND_OUTLINE,       // 1px rect outline in color
+    RENDER_COMMAND_TEXT,          // text at (x, y) in font and color
+    RENDER_COMMAND_GAME_AREA      // the snapshot's cells, drawn through the glyph batch
+} RenderCommandType;
+
+typedef struct {
+    RenderCommandType type;
+    SDL_Rect rect;
+    SDL_Color color;
+    TTF_Font *font;
+    bool cached;                  // Text goes through the shared text cache
+    uint32_t text;                // Offset of the NUL-terminated string in the snapshot's text arena
+} RenderCommand;
+
+// Everything needed to draw one frame. The main thread records the draw commands,
+// then the game area cells are built on the map build thread (or inline when it is
+// stopped) while the main thread draws the commands ahead of the game area. There is
+// one snapshot: the frame waits for its build, and all drawing and presenting
+// happens on the main thread.
+typedef struct {
+    ZBufferCell *cells;           // Composited game area cells at the current zoom
+    RenderCommand commands[RENDER_SNAPSHOT_MAX_COMMANDS];
+    uint32_t command_count;
+    uint32_t dropped_commands;    // Recorded past capacity or out of text space
+    char *text;                   // Strings of the TEXT commands, reset every snapshot
+    uint32_t text_size;
+    uint32_t text_capacity;
+    bool invalidate;              // Redraw the whole game area
+    bool purge_text;              // Render device was reset; cached text textures are gone
+    uint64_t sequence;
+} RenderSnapshot;
+
+// Filled in by whoever built a snapshot's game area; passed to the profiler on the main thread
+typedef struct {
+    uint64_t fov_ticks;           // Performance counter ticks per pass
+    uint64_t background_ticks;
+    uint64_t entities_ticks;
+    uint64_t composite_ticks;
+    uint32_t entities_drawn;
+    bool fov_updated;             // The player had a field of view to update
+    bool fov_recomputed;          // ...and the cached grid could not be reused
+} MapBuildStats;
+
+// Filled in while drawing a snapshot on the main thread
+typedef struct {
+    uint64_t sequence;
+    uint32_t cells_redrawn;
+    uint32_t draw_calls;          // Map draw calls (geometry batches plus texture copies)
+    uint32_t text_hits;
+    uint32_t text_misses;
+    uint64_t draw_cells_ticks;    // Performance counter ticks in the game area pass
+    uint64_t frame_ticks;         // Whole snapshot including present
+} RenderFrameStats;
+
+typedef void (*MapBuildFunction)(RenderSnapshot *snapshot, MapBuildStats *stats, void *user);
+
+typedef struct {
+    RenderSnapshot snapshot;
+    uint64_t next_sequence;
+
+    ThreadPool *pool;             // One worker while running, NULL otherwise
+    bool running;
+    bool building;                // A build was started and not yet finished
+
+    MapBuildFunction build;
+    void *user;
+    MapBuildStats stats;       // Written by the build, read after it finishes
+    uint64_t builds;
+} MapBuildThread;
+
+// Snapshot cell buffer of cell_count cells
+bool map_build_thread_init(MapBuildThread *thread, uint32_t cell_count);
+void map_build_thread_cleanup(MapBuildThread *thread);
+
+// Build snapshot game areas on a dedicated worker instead of the caller's thread
+bool map_build_thread_start(MapBuildThread *thread);
+
+// Finish the build in progress (if any) and join; builds return to the caller's thread
+void map_build_thread_stop(MapBuildThread *thread);
+
+// The snapshot, emptied for recording. Finishes any build still in progress.
+RenderSnapshot *map_build_thread_begin_snapshot(MapBuildThread *thread);
+
+// Build the snapshot's game area with build(snapshot, stats, user): handed to the
+// worker while running, otherwise done before returning. The build may only touch
+// the snapshot cells and simulation state nothing else reads or writes until it
+// finishes; no SDL rendering, SDL_ttf or profiler calls.
+void map_build_thread_build(MapBuildThread *thread, MapBuildFunction build, void *user);
+
+// Wait for the build started by map_build_thread_build. Its stats are copied out the
+// first time; false if there was no build left to finish.
+bool map_build_thread_finish_build(MapBuildThread *thread, MapBuildStats *stats);
+
+// Copy text into the snapshot's arena; false (and nothing recorded) if it cannot grow
+bool render_snapshot_add_text(RenderSnapshot *snapshot, const char *text, uint32_t *offset);
+
+// String of a TEXT command
+const char *render_snapshot_text(const RenderSnapshot *snapshot, const RenderCommand *command);
+
+#endif // MAP_BUILD_THREAD_H
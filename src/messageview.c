@@ -22,6 +22,9 @@ bool messageview_init(struct AppState *app_state) {
 }
 
 void messageview_cleanup(struct AppState *app_state) {
+    // Cached strings hold this window's font and textures
+    text_cache_purge(&app_state->render.text_cache, app_state->message_view.renderer);
+    
     if (app_state->message_view.font) {
         TTF_CloseFont(app_state->message_view.font);
         app_state->message_view.font = NULL;
@@ -196,20 +199,7 @@ static void render_text_line(const char *text, int x, int y, SDL_Color color, st
         return;
     }
     
-    SDL_Surface *text_surface = TTF_RenderText_Solid(app_state->message_view.font, text, color);
-    if (!text_surface) {
-        return;
-    }
-    
-    SDL_Texture *text_texture = SDL_CreateTextureFromSurface(app_state->message_view.renderer, text_surface);
-    SDL_FreeSurface(text_surface);
-    
-    if (text_texture) {
-        SDL_Rect dest_rect = {x, y, 0, 0};
-        SDL_QueryTexture(text_texture, NULL, NULL, &dest_rect.w, &dest_rect.h);
-        SDL_RenderCopy(app_state->message_view.renderer, text_texture, NULL, &dest_rect);
-        SDL_DestroyTexture(text_texture);
-    }
+    render_system_draw_text(app_state, app_state->message_view.renderer, app_state->message_view.font, text, x, y, color);
 }
 
 void messageview_draw_scrollbar(struct AppState *app_state) {
@@ -17,37 +17,15 @@ void playerview_cleanup(void) {
     LOG_INFO("Player view cleaned up");
 }
 
-// Helper function to render text at a specific position
-static void render_text_at_position(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, SDL_Color color) {
-    if (!font || !text) return;
-    
-    SDL_Surface *text_surface = TTF_RenderText_Solid(font, text, color);
-    if (text_surface) {
-        SDL_Texture *text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
-        if (text_texture) {
-            int text_w, text_h;
-            SDL_QueryTexture(text_texture, NULL, NULL, &text_w, &text_h);
-            
-            SDL_Rect text_rect = {x, y, text_w, text_h};
-            SDL_RenderCopy(renderer, text_texture, NULL, &text_rect);
-            
-            SDL_DestroyTexture(text_texture);
-        }
-        SDL_FreeSurface(text_surface);
-    }
-}
-
 void playerview_render(SDL_Renderer *renderer, AppState *app_state) {
     if (!renderer || !app_state) return;
     
     // Draw sidebar background
-    SDL_SetRenderDrawColor(renderer, 32, 32, 32, 255); // Dark gray background
-    SDL_Rect sidebar_rect = {0, 0, SIDEBAR_WIDTH * CELL_SIZE, GAME_AREA_HEIGHT * CELL_SIZE};
-    SDL_RenderFillRect(renderer, &sidebar_rect);
+    SDL_Rect sidebar_rect = app_state->render.sidebar_rect;
+    render_system_fill_rect(app_state, renderer, &sidebar_rect, (SDL_Color){32, 32, 32, 255}); // Dark gray background
     
     // Draw border
-    SDL_SetRenderDrawColor(renderer, 128, 128, 128, 255); // Light gray border
-    SDL_RenderDrawRect(renderer, &sidebar_rect);
+    render_system_outline_rect(app_state, renderer, &sidebar_rect, (SDL_Color){128, 128, 128, 255}); // Light gray border
     
     TTF_Font *font = render_system_get_small_font(app_state);
     if (!font) {
@@ -56,8 +34,8 @@ void playerview_render(SDL_Renderer *renderer, AppState *app_state) {
     }
     
     // Get player components
-    BaseInfo *player_info = (BaseInfo *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "BaseInfo"));
-    Actor *player_actor = (Actor *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "Actor"));
+    BaseInfo *player_info = ECS_GET(app_state, app_state->player, BaseInfo);
+    Actor *player_actor = ECS_GET(app_state, app_state->player, Actor);
     
     SDL_Color white = {255, 255, 255, 255};
     SDL_Color green = {0, 255, 0, 255};
@@ -72,7 +50,7 @@ void playerview_render(SDL_Renderer *renderer, AppState *app_state) {
     if (player_info) {
         char name_line[16];
         snprintf(name_line, sizeof(name_line), "%c %s", player_info->character, player_info->name);
-        render_text_at_position(renderer, font, name_line, x_offset, y_offset, white);
+        render_system_draw_text(app_state, renderer, font, name_line, x_offset, y_offset, white);
         y_offset += line_height + 4; // Small gap after name
     }
     
@@ -83,25 +61,25 @@ void playerview_render(SDL_Renderer *renderer, AppState *app_state) {
         // HP
         SDL_Color hp_color = player_actor->hp > 70 ? green : (player_actor->hp > 30 ? yellow : red);
         snprintf(stats_line, sizeof(stats_line), "HP:%d", player_actor->hp);
-        render_text_at_position(renderer, font, stats_line, x_offset, y_offset, hp_color);
+        render_system_draw_text(app_state, renderer, font, stats_line, x_offset, y_offset, hp_color);
         y_offset += line_height;
         
         // Energy
         snprintf(stats_line, sizeof(stats_line), "En:%d", player_actor->energy);
-        render_text_at_position(renderer, font, stats_line, x_offset, y_offset, white);
+        render_system_draw_text(app_state, renderer, font, stats_line, x_offset, y_offset, white);
         y_offset += line_height;
         
         // Strength
         snprintf(stats_line, sizeof(stats_line), "St:%d", player_actor->strength);
-        render_text_at_position(renderer, font, stats_line, x_offset, y_offset, white);
+        render_system_draw_text(app_state, renderer, font, stats_line, x_offset, y_offset, white);
         y_offset += line_height;
         
         // Attack/Defense
         snprintf(stats_line, sizeof(stats_line), "At:%d", player_actor->attack);
-        render_text_at_position(renderer, font, stats_line, x_offset, y_offset, white);
+        render_system_draw_text(app_state, renderer, font, stats_line, x_offset, y_offset, white);
         y_offset += line_height;
         
         snprintf(stats_line, sizeof(stats_line), "Df:%d", player_actor->defense);
-        render_text_at_position(renderer, font, stats_line, x_offset, y_offset, white);
+        render_system_draw_text(app_state, renderer, font, stats_line, x_offset, y_offset, white);
     }
 }
@@ -0,0 +1,407 @@
+#include "profiler.h"
+#include "appstate.h"
+#include "render_system.h"
+#include "frame_scheduler.h"
+#include "log.h"
+#include "error.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Overlay layout
+#define PROFILER_OVERLAY_MARGIN 6
+#define PROFILER_OVERLAY_LINE_HEIGHT 16
+#define PROFILER_OVERLAY_WIDTH 520
+
+void profiler_init(struct AppState *app_state) {
+    if (!app_state) return;
+
+    memset(&app_state->profiler, 0, sizeof(ProfilerState));
+    app_state->profiler.enabled = app_state->config.profiler.enabled;
+    app_state->profiler.frequency = SDL_GetPerformanceFrequency();
+
+    if (app_state->profiler.enabled) {
+        LOG_INFO("Profiler enabled (Ctrl+P toggles overlay)");
+    }
+}
+
+void profiler_cleanup(struct AppState *app_state) {
+    if (!app_state) return;
+
+    if (app_state->profiler.enabled && app_state->config.profiler.dump_path[0] != '\0') {
+        profiler_dump(app_state, app_state->config.profiler.dump_path);
+    }
+    app_state->profiler.enabled = false;
+    app_state->profiler.overlay_visible = false;
+}
+
+bool profiler_enabled(struct AppState *app_state) {
+    return app_state && app_state->profiler.enabled;
+}
+
+// ===== TIMING PRIMITIVES =====
+
+uint64_t profiler_now(void) {
+    return SDL_GetPerformanceCounter();
+}
+
+float profiler_ticks_to_us(struct AppState *app_state, uint64_t ticks) {
+    if (!app_state || app_state->profiler.frequency == 0) return 0.0f;
+    return (float)((double)ticks * 1000000.0 / (double)app_state->profiler.frequency);
+}
+
+void profiler_ring_push(ProfilerRing *ring, float value_us) {
+    ring->samples[ring->head] = value_us;
+    ring->head = (ring->head + 1) % PROFILER_HISTORY;
+    if (ring->count < PROFILER_HISTORY) {
+        ring->count++;
+    }
+}
+
+static int compare_float(const void *a, const void *b) {
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+ProfilerStats profiler_ring_stats(const ProfilerRing *ring) {
+    ProfilerStats stats = {0.0f, 0.0f, 0.0f, 0.0f};
+    if (!ring || ring->count == 0) return stats;
+
+    float sorted[PROFILER_HISTORY];
+    double sum = 0.0;
+    for (uint32_t i = 0; i < ring->count; i++) {
+        sorted[i] = ring->samples[i];
+        sum += ring->samples[i];
+    }
+    qsort(sorted, ring->count, sizeof(float), compare_float);
+
+    // Nearest-rank percentile
+    uint32_t p99_rank = (ring->count * 99 + 99) / 100;
+    stats.min_us = sorted[0];
+    stats.avg_us = (float)(sum / ring->count);
+    stats.p99_us = sorted[p99_rank - 1];
+    stats.last_us = ring->samples[(ring->head + PROFILER_HISTORY - 1) % PROFILER_HISTORY];
+    return stats;
+}
+
+// ===== SYSTEM INSTRUMENTATION =====
+
+SystemProfile *profiler_system_profile_create(void) {
+    SystemProfile *profile = calloc(1, sizeof(SystemProfile));
+    if (!profile) {
+        ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate system profile");
+    }
+    return profile;
+}
+
+void profiler_system_profile_destroy(SystemProfile *profile) {
+    free(profile);
+}
+
+void profiler_record_system(struct AppState *app_state, SystemProfile *profile,
+                            const uint64_t phase_ticks[PROFILER_PHASE_COUNT], uint32_t entities_processed) {
+    if (!app_state || !profile) return;
+
+    float total_us = 0.0f;
+    for (int phase = 0; phase < PROFILER_PHASE_COUNT; phase++) {
+        float us = profiler_ticks_to_us(app_state, phase_ticks[phase]);
+        profiler_ring_push(&profile->phases[phase], us);
+        total_us += us;
+    }
+    profiler_ring_push(&profile->total, total_us);
+
+    profile->last_entities = entities_processed;
+    profile->total_entities += entities_processed;
+    profile->runs++;
+}
+
+// ===== FRAME AND SECTIONS =====
+
+void profiler_frame_begin(struct AppState *app_state) {
+    if (!profiler_enabled(app_state)) return;
+    app_state->profiler.frame_start = profiler_now();
+}
+
+void profiler_frame_end(struct AppState *app_state) {
+    if (!profiler_enabled(app_state)) return;
+
+    // The overlay shows live timings, so keep frames coming while it is up
+    if (app_state->profiler.overlay_visible) {
+        frame_scheduler_request_frame(app_state);
+    }
+
+    if (app_state->profiler.frame_start == 0) return;
+    profiler_ring_push(&app_state->profiler.frame,
+                       profiler_ticks_to_us(app_state, profiler_now() - app_state->profiler.frame_start));
+    app_state->profiler.frame_count++;
+}
+
+uint64_t profiler_section_begin(struct AppState *app_state) {
+    return profiler_enabled(app_state) ? profiler_now() : 0;
+}
+
+static ProfilerSection *profiler_find_named(ProfilerSection *list, uint32_t *count, uint32_t capacity,
+                                            const char *name, bool create) {
+    for (uint32_t i = 0; i < *count; i++) {
+        if (strcmp(list[i].name, name) == 0) {
+            return &list[i];
+        }
+    }
+
+    if (!create || *count >= capacity) {
+        return NULL;
+    }
+
+    ProfilerSection *section = &list[(*count)++];
+    strncpy(section->name, name, sizeof(section->name) - 1);
+    section->name[sizeof(section->name) - 1] = '\0';
+    return section;
+}
+
+static ProfilerSection *profiler_find_section(struct AppState *app_state, const char *name, bool create) {
+    return profiler_find_named(app_state->profiler.sections, &app_state->profiler.section_count,
+                               PROFILER_MAX_SECTIONS, name, create);
+}
+
+static ProfilerSection *profiler_find_counter(struct AppState *app_state, const char *name, bool create) {
+    return profiler_find_named(app_state->profiler.counters, &app_state->profiler.counter_count,
+                               PROFILER_MAX_COUNTERS, name, create);
+}
+
+void profiler_section_end(struct AppState *app_state, const char *name, uint64_t start) {
+    if (start == 0) return;
+    profiler_section_record(app_state, name, profiler_now() - start);
+}
+
+void profiler_section_record(struct AppState *app_state, const char *name, uint64_t ticks) {
+    if (!profiler_enabled(app_state) || !name) return;
+
+    ProfilerSection *section = profiler_find_section(app_state, name, true);
+    if (section) {
+        profiler_ring_push(&section->ring, profiler_ticks_to_us(app_state, ticks));
+    }
+}
+
+void profiler_count(struct AppState *app_state, const char *name, uint32_t value) {
+    if (!profiler_enabled(app_state) || !name) return;
+
+    ProfilerSection *counter = profiler_find_counter(app_state, name, true);
+    if (counter) {
+        profiler_ring_push(&counter->ring, (float)value);
+    }
+}
+
+// ===== QUERIES =====
+
+ProfilerStats profiler_get_frame_stats(struct AppState *app_state) {
+    ProfilerStats empty = {0.0f, 0.0f, 0.0f, 0.0f};
+    return app_state ? profiler_ring_stats(&app_state->profiler.frame) : empty;
+}
+
+bool profiler_get_section_stats(struct AppState *app_state, const char *name, ProfilerStats *stats) {
+    if (!app_state || !name || !stats) return false;
+
+    ProfilerSection *section = profiler_find_section(app_state, name, false);
+    if (!section) return false;
+
+    *stats = profiler_ring_stats(&section->ring);
+    return true;
+}
+
+bool profiler_get_counter_stats(struct AppState *app_state, const char *name, ProfilerStats *stats) {
+    if (!app_state || !name || !stats) return false;
+
+    ProfilerSection *counter = profiler_find_counter(app_state, name, false);
+    if (!counter) return false;
+
+    *stats = profiler_ring_stats(&counter->ring);
+    return true;
+}
+
+const SystemProfile *profiler_get_system_profile(struct AppState *app_state, const char *system_name) {
+    if (!app_state || !system_name) return NULL;
+
+    for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+        if (strcmp(app_state->ecs.systems.systems[i].name, system_name) == 0) {
+            return app_state->ecs.systems.systems[i].profile;
+        }
+    }
+    return NULL;
+}
+
+// ===== OVERLAY =====
+
+void profiler_toggle_overlay(struct AppState *app_state) {
+    if (!app_state) return;
+
+    if (!app_state->profiler.enabled) {
+        // Turning the overlay on starts collection if the config left it off
+        app_state->profiler.enabled = true;
+        app_state->profiler.frequency = SDL_GetPerformanceFrequency();
+    }
+    app_state->profiler.overlay_visible = !app_state->profiler.overlay_visible;
+    LOG_INFO("Profiler overlay %s", app_state->profiler.overlay_visible ? "shown" : "hidden");
+}
+
+// Overlay numbers change every frame, so its lines bypass the text cache
+static void profiler_overlay_line(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, SDL_Color color) {
+    render_system_draw_text_uncached(appstate_get(), renderer, font, text, x, y, color);
+}
+
+void profiler_render_overlay(SDL_Renderer *renderer, TTF_Font *font, struct AppState *app_state) {
+    if (!renderer || !font || !app_state || !app_state->profiler.overlay_visible) return;
+
+    uint32_t line_count = 2 + app_state->ecs.systems.system_count + app_state->profiler.section_count +
+                          app_state->profiler.counter_count;
+    int x = app_state->render.map_area.x + PROFILER_OVERLAY_MARGIN;
+    int y = app_state->render.map_area.y + PROFILER_OVERLAY_MARGIN;
+
+    // Translucent backdrop so the map stays readable underneath
+    SDL_Rect backdrop = {x - 4, y - 4, PROFILER_OVERLAY_WIDTH, (int)line_count * PROFILER_OVERLAY_LINE_HEIGHT + 8};
+    render_system_fill_rect(app_state, renderer, &backdrop, (SDL_Color){0, 0, 0, 192});
+
+    SDL_Color header = {255, 255, 0, 255};
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Color cyan = {0, 255, 255, 255};
+    char line[160];
+
+    ProfilerStats frame = profiler_get_frame_stats(app_state);
+    snprintf(line, sizeof(line), "Frame  avg %.2f ms  p99 %.2f ms  min %.2f ms",
+             frame.avg_us / 1000.0f, frame.p99_us / 1000.0f, frame.min_us / 1000.0f);
+    profiler_overlay_line(renderer, font, line, x, y, header);
+    y += PROFILER_OVERLAY_LINE_HEIGHT;
+
+    profiler_overlay_line(renderer, font, "System        pre    ent   post    avg    p99 (us)   n", x, y, header);
+    y += PROFILER_OVERLAY_LINE_HEIGHT;
+
+    for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+        const System *system = &app_state->ecs.systems.systems[i];
+        const SystemProfile *profile = system->profile;
+        if (!profile) continue;
+
+        ProfilerStats pre = profiler_ring_stats(&profile->phases[PROFILER_PHASE_PRE_UPDATE]);
+        ProfilerStats ent = profiler_ring_stats(&profile->phases[PROFILER_PHASE_ENTITIES]);
+        ProfilerStats post = profiler_ring_stats(&profile->phases[PROFILER_PHASE_POST_UPDATE]);
+        ProfilerStats total = profiler_ring_stats(&profile->total);
+        snprintf(line, sizeof(line), "%-12.12s %6.0f %6.0f %6.0f %6.0f %6.0f %7u",
+                 system->name, pre.avg_us, ent.avg_us, post.avg_us, total.avg_us, total.p99_us,
+                 profile->last_entities);
+        profiler_overlay_line(renderer, font, line, x, y, white);
+        y += PROFILER_OVERLAY_LINE_HEIGHT;
+    }
+
+    for (uint32_t i = 0; i < app_state->profiler.section_count; i++) {
+        ProfilerStats stats = profiler_ring_stats(&app_state->profiler.sections[i].ring);
+        snprintf(line, sizeof(line), "  %-18.18s avg %6.0f  p99 %6.0f us",
+                 app_state->profiler.sections[i].name, stats.avg_us, stats.p99_us);
+        profiler_overlay_line(renderer, font, line, x, y, cyan);
+        y += PROFILER_OVERLAY_LINE_HEIGHT;
+    }
+
+    for (uint32_t i = 0; i < app_state->profiler.counter_count; i++) {
+        ProfilerStats stats = profiler_ring_stats(&app_state->profiler.counters[i].ring);
+        snprintf(line, sizeof(line), "  %-18.18s avg %6.0f  last %5.0f",
+                 app_state->profiler.counters[i].name, stats.avg_us, stats.last_us);
+        profiler_overlay_line(renderer, font, line, x, y, cyan);
+        y += PROFILER_OVERLAY_LINE_HEIGHT;
+    }
+}
+
+// ===== DUMP =====
+
+static const char *PHASE_NAMES[PROFILER_PHASE_COUNT] = {"pre_update", "entities", "post_update"};
+
+static void dump_csv_row(FILE *file, const char *kind, const char *name, const char *phase, ProfilerStats stats,
+                         uint64_t runs, double avg_entities) {
+    fprintf(file, "%s,%s,%s,%.3f,%.3f,%.3f,%.3f,%llu,%.1f\n", kind, name, phase,
+            stats.min_us, stats.avg_us, stats.p99_us, stats.last_us, (unsigned long long)runs, avg_entities);
+}
+
+static void dump_json_stats(FILE *file, ProfilerStats stats) {
+    fprintf(file, "{\"min_us\": %.3f, \"avg_us\": %.3f, \"p99_us\": %.3f, \"last_us\": %.3f}",
+            stats.min_us, stats.avg_us, stats.p99_us, stats.last_us);
+}
+
+bool profiler_dump(struct AppState *app_state, const char *path) {
+    if (!app_state || !path) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_NULL_POINTER, "profiler_dump requires app_state and path");
+    }
+
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_FILE_IO, "Failed to open profiler dump '%s'", path);
+    }
+
+    size_t length = strlen(path);
+    bool json = length >= 5 && strcmp(path + length - 5, ".json") == 0;
+    ProfilerStats frame = profiler_get_frame_stats(app_state);
+
+    if (json) {
+        fprintf(file, "{\n  \"frame\": ");
+        dump_json_stats(file, frame);
+        fprintf(file, ",\n  \"systems\": [");
+        bool first = true;
+        for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+            const System *system = &app_state->ecs.systems.systems[i];
+            const SystemProfile *profile = system->profile;
+            if (!profile) continue;
+
+            fprintf(file, "%s\n    {\"name\": \"%s\", \"runs\": %llu, \"avg_entities\": %.1f, \"total\": ",
+                    first ? "" : ",", system->name, (unsigned long long)profile->runs,
+                    profile->runs ? (double)profile->total_entities / profile->runs : 0.0);
+            dump_json_stats(file, profiler_ring_stats(&profile->total));
+            for (int phase = 0; phase < PROFILER_PHASE_COUNT; phase++) {
+                fprintf(file, ", \"%s\": ", PHASE_NAMES[phase]);
+                dump_json_stats(file, profiler_ring_stats(&profile->phases[phase]));
+            }
+            fprintf(file, "}");
+            first = false;
+        }
+        fprintf(file, "\n  ],\n  \"sections\": [");
+        for (uint32_t i = 0; i < app_state->profiler.section_count; i++) {
+            fprintf(file, "%s\n    {\"name\": \"%s\", \"time\": ", i ? "," : "", app_state->profiler.sections[i].name);
+            dump_json_stats(file, profiler_ring_stats(&app_state->profiler.sections[i].ring));
+            fprintf(file, "}");
+        }
+        fprintf(file, "\n  ],\n  \"counters\": [");
+        for (uint32_t i = 0; i < app_state->profiler.counter_count; i++) {
+            ProfilerStats stats = profiler_ring_stats(&app_state->profiler.counters[i].ring);
+            fprintf(file, "%s\n    {\"name\": \"%s\", \"min\": %.0f, \"avg\": %.1f, \"p99\": %.0f, \"last\": %.0f}",
+                    i ? "," : "", app_state->profiler.counters[i].name,
+                    stats.min_us, stats.avg_us, stats.p99_us, stats.last_us);
+        }
+        fprintf(file, "\n  ]\n}\n");
+    } else {
+        fprintf(file, "kind,name,phase,min_us,avg_us,p99_us,last_us,runs,avg_entities\n");
+        dump_csv_row(file, "frame", "frame", "total", frame, app_state->profiler.frame_count, 0.0);
+        for (uint32_t i = 0; i < app_state->ecs.systems.system_count; i++) {
+            const System *system = &app_state->ecs.systems.systems[i];
+            const SystemProfile *profile = system->profile;
+            if (!profile) continue;
+
+            double avg_entities = profile->runs ? (double)profile->total_entities / profile->runs : 0.0;
+            for (int phase = 0; phase < PROFILER_PHASE_COUNT; phase++) {
+                dump_csv_row(file, "system", system->name, PHASE_NAMES[phase],
+                             profiler_ring_stats(&profile->phases[phase]), profile->runs, avg_entities);
+            }
+            dump_csv_row(file, "system", system->name, "total", profiler_ring_stats(&profile->total),
+                         profile->runs, avg_entities);
+        }
+        for (uint32_t i = 0; i < app_state->profiler.section_count; i++) {
+            dump_csv_row(file, "section", app_state->profiler.sections[i].name, "total",
+                         profiler_ring_stats(&app_state->profiler.sections[i].ring),
+                         app_state->profiler.sections[i].ring.count, 0.0);
+        }
+        // Counter rows reuse the timing columns for plain counts
+        for (uint32_t i = 0; i < app_state->profiler.counter_count; i++) {
+            dump_csv_row(file, "counter", app_state->profiler.counters[i].name, "count",
+                         profiler_ring_stats(&app_state->profiler.counters[i].ring),
+                         app_state->profiler.counters[i].ring.count, 0.0);
+        }
+    }
+
+    fclose(file);
+    LOG_INFO("Profiler statistics written to %s", path);
+    return true;
+}
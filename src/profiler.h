@@ -0,0 +1,106 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Profiler configuration
+#define PROFILER_HISTORY 128          // Samples kept per ring for rolling statistics
+#define PROFILER_MAX_SECTIONS 16      // Named code sections (e.g. "FOV")
+#define PROFILER_MAX_COUNTERS 16      // Named per-frame counts (e.g. "Cells redrawn")
+#define PROFILER_NAME_LENGTH 32
+
+// Phases of one system run
+typedef enum {
+    PROFILER_PHASE_PRE_UPDATE = 0,
+    PROFILER_PHASE_ENTITIES,
+    PROFILER_PHASE_POST_UPDATE,
+    PROFILER_PHASE_COUNT
+} ProfilerPhase;
+
+// Fixed-size history of timings in microseconds
+typedef struct {
+    float samples[PROFILER_HISTORY];
+    uint32_t head;                    // Next slot to write
+    uint32_t count;                   // Valid samples (<= PROFILER_HISTORY)
+} ProfilerRing;
+
+// Rolling statistics over a ring, in microseconds
+typedef struct {
+    float min_us;
+    float avg_us;
+    float p99_us;
+    float last_us;
+} ProfilerStats;
+
+// Timing history for one system, owned by System.profile
+typedef struct SystemProfile {
+    ProfilerRing phases[PROFILER_PHASE_COUNT];
+    ProfilerRing total;
+    uint32_t last_entities;           // Entities processed by the last run
+    uint64_t total_entities;
+    uint64_t runs;
+} SystemProfile;
+
+typedef struct {
+    char name[PROFILER_NAME_LENGTH];
+    ProfilerRing ring;
+} ProfilerSection;
+
+typedef struct {
+    bool enabled;
+    bool overlay_visible;
+    uint64_t frequency;               // Performance counter ticks per second
+    uint64_t frame_start;
+    ProfilerRing frame;               // Update + render time per frame
+    uint64_t frame_count;
+    ProfilerSection sections[PROFILER_MAX_SECTIONS];
+    uint32_t section_count;
+    ProfilerSection counters[PROFILER_MAX_COUNTERS]; // Rings hold counts rather than microseconds
+    uint32_t counter_count;
+} ProfilerState;
+
+// Forward declarations
+struct AppState;
+
+// Profiler lifetime; enabled state comes from config.profiler.enabled
+void profiler_init(struct AppState *app_state);
+void profiler_cleanup(struct AppState *app_state);
+bool profiler_enabled(struct AppState *app_state);
+
+// Timing primitives
+uint64_t profiler_now(void);
+float profiler_ticks_to_us(struct AppState *app_state, uint64_t ticks);
+void profiler_ring_push(ProfilerRing *ring, float value_us);
+ProfilerStats profiler_ring_stats(const ProfilerRing *ring);
+
+// System instrumentation, driven by system_run_all
+struct SystemProfile *profiler_system_profile_create(void);
+void profiler_system_profile_destroy(struct SystemProfile *profile);
+void profiler_record_system(struct AppState *app_state, struct SystemProfile *profile,
+                            const uint64_t phase_ticks[PROFILER_PHASE_COUNT], uint32_t entities_processed);
+
+// Frame and named section timing
+void profiler_frame_begin(struct AppState *app_state);
+void profiler_frame_end(struct AppState *app_state);
+uint64_t profiler_section_begin(struct AppState *app_state);
+void profiler_section_end(struct AppState *app_state, const char *name, uint64_t start);
+void profiler_section_record(struct AppState *app_state, const char *name, uint64_t ticks); // Duration measured elsewhere (e.g. another thread)
+void profiler_count(struct AppState *app_state, const char *name, uint32_t value);
+
+// Queries for tools and the overlay
+ProfilerStats profiler_get_frame_stats(struct AppState *app_state);
+bool profiler_get_section_stats(struct AppState *app_state, const char *name, ProfilerStats *stats);
+bool profiler_get_counter_stats(struct AppState *app_state, const char *name, ProfilerStats *stats);
+const struct SystemProfile *profiler_get_system_profile(struct AppState *app_state, const char *system_name);
+
+// Overlay toggled with Ctrl+P while playing
+void profiler_toggle_overlay(struct AppState *app_state);
+void profiler_render_overlay(SDL_Renderer *renderer, TTF_Font *font, struct AppState *app_state);
+
+// Write collected statistics to path; ".json" selects JSON, anything else CSV
+bool profiler_dump(struct AppState *app_state, const char *path);
+
+#endif // PROFILER_H
@@ -1,169 +1,236 @@
 #include "render_system.h"
 #include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include "log.h"
 #include "appstate.h"
 #include "components.h"
 #include "playerview.h"
 #include "statusview.h"
 #include "messageview.h"
+#include "profiler.h"
+#include "glyph_atlas.h"
 
 // Render system now uses AppState->render instead of globals
 #define VIEWPORT_MARGIN 5
-#define CHUNK_X (GAME_AREA_WIDTH - 2 * VIEWPORT_MARGIN)
-#define CHUNK_Y (GAME_AREA_HEIGHT - 2 * VIEWPORT_MARGIN)
+#define MAP_BATCH_MAX_QUADS 32768 // Larger redraws submit in several batches
 
-// Helper function to render a tile at screen coordinates (to a specific renderer)
-static void render_tile_at_screen_pos_to_renderer(SDL_Renderer *target_renderer, TTF_Font *font, int screen_x, int screen_y, char symbol, uint8_t color) {
-    // Set color based on the tile color
-    uint8_t r, g, b;
+static const int zoom_cell_sizes[RENDER_ZOOM_LEVEL_COUNT] = RENDER_ZOOM_LEVELS;
+
+// Map a tile color index to RGB
+static SDL_Color render_color_from_index(uint8_t color) {
     switch (color) {
-        case 0x01: // Red
-            r = 255; g = 0; b = 0;
-            break;
-        case 0x02: // Green
-            r = 0; g = 255; b = 0;
-            break;
-        case 0x03: // Blue
-            r = 0; g = 0; b = 255;
-            break;
-        case 0x04: // Yellow
-            r = 255; g = 255; b = 0;
-            break;
-        case 0x05: // Magenta
-            r = 255; g = 0; b = 255;
-            break;
-        case 0x06: // Cyan
-            r = 0; g = 255; b = 255;
-            break;
-        case 0x07: // White
-            r = 255; g = 255; b = 255;
-            break;
-        case 0x08: // Dark gray (for explored areas)
-            r = 64; g = 64; b = 64;
-            break;
-        default: // Default to white
-            r = 255; g = 255; b = 255;
-            break;
+        case 0x01: return (SDL_Color){255, 0, 0, 255};     // Red
+        case 0x02: return (SDL_Color){0, 255, 0, 255};     // Green
+        case 0x03: return (SDL_Color){0, 0, 255, 255};     // Blue
+        case 0x04: return (SDL_Color){255, 255, 0, 255};   // Yellow
+        case 0x05: return (SDL_Color){255, 0, 255, 255};   // Magenta
+        case 0x06: return (SDL_Color){0, 255, 255, 255};   // Cyan
+        case 0x07: return (SDL_Color){255, 255, 255, 255}; // White
+        case 0x08: return (SDL_Color){64, 64, 64, 255};    // Dark gray (for explored areas)
+        default:   return (SDL_Color){255, 255, 255, 255}; // Default to white
     }
+}
+
+// Fallback tile drawing when no font (and so no glyph atlas) is available
+static void render_tile_at_screen_pos_to_renderer(SDL_Renderer *target_renderer, int screen_x, int screen_y,
+                                                  int cell_size, uint8_t color) {
+    SDL_Color tile_color = render_color_from_index(color);
+    SDL_Rect char_rect = {
+        screen_x,
+        screen_y,
+        cell_size,
+        cell_size
+    };
     
-    // Try to render the character as text
-    if (font) {
-        // Create a string from the character
-        char char_str[2] = {symbol, '\0'};
-        
-        // Set the text color
-        SDL_Color text_color = {r, g, b, 255};
-        
-        // Render the text surface
-        SDL_Surface *text_surface = TTF_RenderText_Solid(font, char_str, text_color);
-        if (text_surface) {
-            // Create texture from surface
-            SDL_Texture *text_texture = SDL_CreateTextureFromSurface(target_renderer, text_surface);
-            if (text_texture) {
-                // Get text dimensions
-                int text_w, text_h;
-                SDL_QueryTexture(text_texture, NULL, NULL, &text_w, &text_h);
-                
-                // Center the text in the cell
-                int text_x = screen_x + (CELL_SIZE - text_w) / 2;
-                int text_y = screen_y + (CELL_SIZE - text_h) / 2;
-                
-                // Render the text
-                SDL_Rect text_rect = {text_x, text_y, text_w, text_h};
-                SDL_RenderCopy(target_renderer, text_texture, NULL, &text_rect);
-                
-                // Clean up
-                SDL_DestroyTexture(text_texture);
+    SDL_SetRenderDrawColor(target_renderer, tile_color.r, tile_color.g, tile_color.b, 255);
+    SDL_RenderFillRect(target_renderer, &char_rect);
+    
+    // Draw a border to make it more visible
+    SDL_SetRenderDrawColor(target_renderer, 255, 255, 255, 255);
+    SDL_RenderDrawRect(target_renderer, &char_rect);
+}
+
+// Queue one game area cell at (x, y) in the current target. The cell's background
+// color is filled first when it has one; clear paints cells without one black.
+static void render_game_area_cell(AppState *app_state, int x, int y, ZBufferCell cell, bool clear) {
+    SDL_Renderer *renderer = app_state->render.renderer;
+    GlyphAtlas *atlas = &app_state->render.map_atlas;
+    GlyphBatch *batch = &app_state->render.map_batch;
+    int cell_size = app_state->render.cell_size;
+    uint8_t bg = zcell_bg(cell);
+    bool fill = clear || bg != 0;
+    SDL_Color fill_color = bg != 0 ? render_color_from_index(bg) : (SDL_Color){0, 0, 0, 255};
+    
+    if (atlas->initialized && batch->quad_capacity > 0) {
+        if (fill) {
+            glyph_batch_add_solid(batch, renderer, atlas, x, y, cell_size, cell_size, fill_color);
+        }
+        if (cell != ZCELL_EMPTY) {
+            glyph_batch_add_glyph(batch, renderer, atlas, zcell_glyph(cell), x, y, cell_size,
+                                  render_color_from_index(zcell_fg(cell)));
+        }
+        return;
+    }
+    
+    if (fill) {
+        SDL_Rect cell_rect = {x, y, cell_size, cell_size};
+        SDL_SetRenderDrawColor(renderer, fill_color.r, fill_color.g, fill_color.b, 255);
+        SDL_RenderFillRect(renderer, &cell_rect);
+    }
+    if (cell != ZCELL_EMPTY) {
+        render_tile_at_screen_pos_to_renderer(renderer, x, y, cell_size, zcell_fg(cell));
+    }
+}
+
+// Pre-render the graph paper grid (very dark, barely visible) once for the whole game area
+static bool init_grid_overlay(AppState *app_state) {
+    int cell_size = app_state->render.cell_size;
+    SDL_Surface *grid = SDL_CreateRGBSurfaceWithFormat(0, app_state->render.game_area_width * cell_size,
+                                                       app_state->render.game_area_height * cell_size,
+                                                       32, SDL_PIXELFORMAT_ARGB8888);
+    if (!grid) {
+        LOG_ERROR("Failed to create grid surface: %s", SDL_GetError());
+        return false;
+    }
+    
+    // Same 1px cell outlines SDL_RenderDrawRect drew per cell; the rest stays transparent
+    Uint32 line = SDL_MapRGBA(grid->format, 16, 16, 16, 255);
+    for (int cell_y = 0; cell_y < app_state->render.game_area_height; cell_y++) {
+        for (int cell_x = 0; cell_x < app_state->render.game_area_width; cell_x++) {
+            int x = cell_x * cell_size;
+            int y = cell_y * cell_size;
+            SDL_Rect edges[4] = {
+                {x, y, cell_size, 1},
+                {x, y + cell_size - 1, cell_size, 1},
+                {x, y, 1, cell_size},
+                {x + cell_size - 1, y, 1, cell_size}
+            };
+            for (int i = 0; i < 4; i++) {
+                SDL_FillRect(grid, &edges[i], line);
             }
-            SDL_FreeSurface(text_surface);
         }
-    } else {
-        // Fallback to rectangle rendering if font is not available
-        SDL_Rect char_rect = {
-            screen_x,
-            screen_y,
-            CELL_SIZE,
-            CELL_SIZE
-        };
-        
-        SDL_SetRenderDrawColor(target_renderer, r, g, b, 255);
-        SDL_RenderFillRect(target_renderer, &char_rect);
-        
-        // Draw a border to make it more visible
-        SDL_SetRenderDrawColor(target_renderer, 255, 255, 255, 255);
-        SDL_RenderDrawRect(target_renderer, &char_rect);
     }
     
-    // Draw graph paper grid lines (very dark, barely visible)
-    SDL_SetRenderDrawColor(target_renderer, 16, 16, 16, 255); // Very dark gray
-    SDL_Rect grid_rect = {screen_x, screen_y, CELL_SIZE, CELL_SIZE};
-    SDL_RenderDrawRect(target_renderer, &grid_rect);
+    app_state->render.grid_overlay = SDL_CreateTextureFromSurface(app_state->render.renderer, grid);
+    SDL_FreeSurface(grid);
+    if (!app_state->render.grid_overlay) {
+        LOG_ERROR("Failed to create grid overlay texture: %s", SDL_GetError());
+        return false;
+    }
+    
+    SDL_SetTextureBlendMode(app_state->render.grid_overlay, SDL_BLENDMODE_BLEND);
+    return true;
 }
 
 // Helper function to write to z-buffer
-static void write_to_z_buffer(ZBufferCell *buffer, int screen_x, int screen_y, char character, uint8_t color) {
-    if (screen_x >= 0 && screen_x < GAME_AREA_WIDTH && screen_y >= 0 && screen_y < GAME_AREA_HEIGHT) {
-        int index = screen_y * GAME_AREA_WIDTH + screen_x;
-        buffer[index].character = character;
-        buffer[index].color = color;
-        buffer[index].has_content = true;
+static void write_to_z_buffer(AppState *app_state, RenderLayer layer, int screen_x, int screen_y,
+                              char character, uint8_t color) {
+    int width = app_state->render.game_area_width;
+    if (screen_x >= 0 && screen_x < width && screen_y >= 0 && screen_y < app_state->render.game_area_height) {
+        ZBufferCell *buffer = zbuffer_layer(&app_state->render.z_buffer, layer);
+        if (buffer) {
+            buffer[screen_y * width + screen_x] = zcell_pack(character, color, 0, layer);
+        }
     }
 }
 
 
 
+// Keep the viewport inside the dungeon; a viewport wider than the dungeon centers it
+static int clamp_viewport_axis(int origin, int size, int dungeon_size) {
+    if (size >= dungeon_size) return (dungeon_size - size) / 2;
+    if (origin < 0) return 0;
+    if (origin > dungeon_size - size) return dungeon_size - size;
+    return origin;
+}
+
 // Helper function to update viewport based on player position
 static void update_viewport(AppState *app_state) {
     if (!app_state) return;
     
     // Get player position
-    Position *player_pos = (Position *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "Position"));
+    Position *player_pos = ECS_GET(app_state, app_state->player, Position);
     if (!player_pos) return;
     
     int player_x = (int)player_pos->x;
     int player_y = (int)player_pos->y;
+    int width = app_state->render.game_area_width;
+    int height = app_state->render.game_area_height;
+    
+    // Small (zoomed in) viewports shrink the margin so a scroll always moves
+    int margin_x = width / 4 < VIEWPORT_MARGIN ? width / 4 : VIEWPORT_MARGIN;
+    int margin_y = height / 4 < VIEWPORT_MARGIN ? height / 4 : VIEWPORT_MARGIN;
+    int chunk_x = width - 2 * margin_x;
+    int chunk_y = height - 2 * margin_y;
 
     // Left
-    if (player_x - app_state->render.viewport_x < VIEWPORT_MARGIN) {
-        app_state->render.viewport_x -= CHUNK_X;
+    if (player_x - app_state->render.viewport_x < margin_x) {
+        app_state->render.viewport_x -= chunk_x;
     }
     // Right
-    if (player_x - app_state->render.viewport_x >= GAME_AREA_WIDTH - VIEWPORT_MARGIN) {
-        app_state->render.viewport_x += CHUNK_X;
+    if (player_x - app_state->render.viewport_x >= width - margin_x) {
+        app_state->render.viewport_x += chunk_x;
     }
     // Top
-    if (player_y - app_state->render.viewport_y < VIEWPORT_MARGIN) {
-        app_state->render.viewport_y -= CHUNK_Y;
+    if (player_y - app_state->render.viewport_y < margin_y) {
+        app_state->render.viewport_y -= chunk_y;
     }
     // Bottom
-    if (player_y - app_state->render.viewport_y >= GAME_AREA_HEIGHT - VIEWPORT_MARGIN) {
-        app_state->render.viewport_y += CHUNK_Y;
+    if (player_y - app_state->render.viewport_y >= height - margin_y) {
+        app_state->render.viewport_y += chunk_y;
     }
 
     // Clamp viewport to dungeon bounds
-    if (app_state->render.viewport_x < 0) app_state->render.viewport_x = 0;
-    if (app_state->render.viewport_y < 0) app_state->render.viewport_y = 0;
-    if (app_state->render.viewport_x > DUNGEON_WIDTH - GAME_AREA_WIDTH) app_state->render.viewport_x = DUNGEON_WIDTH - GAME_AREA_WIDTH;
-    if (app_state->render.viewport_y > DUNGEON_HEIGHT - GAME_AREA_HEIGHT) app_state->render.viewport_y = DUNGEON_HEIGHT - GAME_AREA_HEIGHT;
+    app_state->render.viewport_x = clamp_viewport_axis(app_state->render.viewport_x, width, DUNGEON_WIDTH);
+    app_state->render.viewport_y = clamp_viewport_axis(app_state->render.viewport_y, height, DUNGEON_HEIGHT);
+}
+
+// Center the viewport on the player, e.g. after a zoom changed its size
+static void center_viewport(AppState *app_state) {
+    Position *player_pos = ECS_GET(app_state, app_state->player, Position);
+    if (!player_pos) return;
+    
+    int width = app_state->render.game_area_width;
+    int height = app_state->render.game_area_height;
+    app_state->render.viewport_x = clamp_viewport_axis((int)player_pos->x - width / 2, width, DUNGEON_WIDTH);
+    app_state->render.viewport_y = clamp_viewport_axis((int)player_pos->y - height / 2, height, DUNGEON_HEIGHT);
 }
 
 // Initialize z-buffer system
 static bool init_z_buffers(AppState *app_state) {
     if (!app_state || !app_state->render.renderer) return false;
     
-    // Allocate z-buffer arrays for game area only
-    size_t buffer_size = GAME_AREA_WIDTH * GAME_AREA_HEIGHT * sizeof(ZBufferCell);
-    app_state->render.z_buffer_0 = malloc(buffer_size);
-    app_state->render.z_buffer_1 = malloc(buffer_size);
+    // Map layers for game area only, sized for the current zoom
+    size_t cell_count = (size_t)app_state->render.game_area_width * (size_t)app_state->render.game_area_height;
+    if (!zbuffer_init(&app_state->render.z_buffer, (uint32_t)cell_count)) {
+        LOG_ERROR("Failed to allocate z-buffer layers");
+        return false;
+    }
+    
+    app_state->render.previous_cells = calloc(cell_count, sizeof(ZBufferCell));
+    if (!app_state->render.previous_cells) {
+        LOG_ERROR("Failed to allocate previous cell buffer");
+        return false;
+    }
     
-    if (!app_state->render.z_buffer_0 || !app_state->render.z_buffer_1) {
-        LOG_ERROR("Failed to allocate z-buffer arrays");
+    // Snapshot buffers frames are recorded into
+    if (!map_build_thread_init(&app_state->render.map_build, (uint32_t)cell_count)) {
+        LOG_ERROR("Failed to allocate render snapshots");
         return false;
     }
     
-    // Initialize buffers
-    memset(app_state->render.z_buffer_0, 0, buffer_size);
-    memset(app_state->render.z_buffer_1, 0, buffer_size);
+    // Without render targets every frame redraws the whole game area directly
+    if (SDL_RenderTargetSupported(app_state->render.renderer)) {
+        app_state->render.game_area_target = SDL_CreateTexture(app_state->render.renderer, SDL_PIXELFORMAT_RGBA8888,
+                                                               SDL_TEXTUREACCESS_TARGET,
+                                                               app_state->render.game_area_width * app_state->render.cell_size,
+                                                               app_state->render.game_area_height * app_state->render.cell_size);
+    }
+    if (!app_state->render.game_area_target) {
+        LOG_WARN("Game area render target unavailable, redrawing every cell each frame: %s", SDL_GetError());
+    }
+    app_state->render.game_area_valid = false;
     
     return true;
 }
@@ -172,143 +239,523 @@ static bool init_z_buffers(AppState *app_state) {
 static void cleanup_z_buffers(AppState *app_state) {
     if (!app_state) return;
     
-    if (app_state->render.z_buffer_0) {
-        free(app_state->render.z_buffer_0);
-        app_state->render.z_buffer_0 = NULL;
+    // Stops the map build thread if it is still running
+    map_build_thread_cleanup(&app_state->render.map_build);
+    
+    zbuffer_free(&app_state->render.z_buffer);
+    if (app_state->render.previous_cells) {
+        free(app_state->render.previous_cells);
+        app_state->render.previous_cells = NULL;
+    }
+    if (app_state->render.game_area_target) {
+        SDL_DestroyTexture(app_state->render.game_area_target);
+        app_state->render.game_area_target = NULL;
+    }
+    app_state->render.game_area_valid = false;
+}
+
+// Composite the dungeon under the viewport into the background layer. The player's
+// FOV is resolved once per pass and tiles are read straight out of the dungeon array
+// a column at a time (tiles are stored [x][y]), with each tile type mapped through a
+// small glyph table instead of per-cell getters. Every cell of the layer is written,
+// so it never needs clearing between frames.
+void render_system_compose_background(AppState *app_state) {
+    if (!app_state || !app_state->dungeon.width) return;
+    
+    ZBufferCell *background = zbuffer_layer(&app_state->render.z_buffer, RENDER_LAYER_BACKGROUND);
+    if (!background) return;
+    int width = app_state->render.game_area_width;
+    int height = app_state->render.game_area_height;
+    
+    // Without a player FOV nothing is visible or explored
+    CompactFieldOfView *player_fov = ECS_GET(app_state, app_state->player, FieldOfView);
+    if (!player_fov) {
+        memset(background, 0, (size_t)width * (size_t)height * sizeof(ZBufferCell));
+        return;
+    }
+    
+    // Tile type -> cell when in view [0] and when only explored [1] (darkened)
+    ZBufferCell tile_glyphs[TILE_TYPE_COUNT][2];
+    for (int type = 0; type < TILE_TYPE_COUNT; type++) {
+        TileInfo *info = dungeon_get_tile_info((TileType)type);
+        tile_glyphs[type][0] = zcell_pack(info->symbol, info->color, 0, RENDER_LAYER_BACKGROUND);
+        tile_glyphs[type][1] = zcell_pack(info->symbol, 0x08, 0, RENDER_LAYER_BACKGROUND);
     }
-    if (app_state->render.z_buffer_1) {
-        free(app_state->render.z_buffer_1);
-        app_state->render.z_buffer_1 = NULL;
+    
+    // Clip the viewport to the dungeon once instead of bounds checking every cell
+    int viewport_x = app_state->render.viewport_x;
+    int viewport_y = app_state->render.viewport_y;
+    int x_begin = viewport_x < 0 ? -viewport_x : 0;
+    int y_begin = viewport_y < 0 ? -viewport_y : 0;
+    int x_end = DUNGEON_WIDTH - viewport_x < width ? DUNGEON_WIDTH - viewport_x : width;
+    int y_end = DUNGEON_HEIGHT - viewport_y < height ? DUNGEON_HEIGHT - viewport_y : height;
+    
+    // Only a viewport hanging off the dungeon has cells the loop below skips
+    if (x_begin > 0 || y_begin > 0 || x_end < width || y_end < height) {
+        memset(background, 0, (size_t)width * (size_t)height * sizeof(ZBufferCell));
+    }
+    
+    // World coordinates of the FOV grid's [0][0]
+    int fov_x = player_fov->center_x - player_fov->radius;
+    int fov_y = player_fov->center_y - player_fov->radius;
+    
+    for (int screen_x = x_begin; screen_x < x_end; screen_x++) {
+        int dungeon_x = viewport_x + screen_x;
+        const Tile *column = app_state->dungeon.tiles[dungeon_x];
+        const uint64_t *explored = app_state->dungeon.explored[dungeon_x];
+        
+        int compact_x = dungeon_x - fov_x;
+        const uint64_t *visible = (compact_x >= 0 && compact_x < FOV_GRID_SIZE) ? player_fov->visible[compact_x] : NULL;
+        
+        ZBufferCell *cell = &background[y_begin * width + screen_x];
+        for (int screen_y = y_begin; screen_y < y_end; screen_y++, cell += width) {
+            int dungeon_y = viewport_y + screen_y;
+            const Tile *tile = &column[dungeon_y];
+            int compact_y = dungeon_y - fov_y;
+            
+            if (visible && compact_y >= 0 && compact_y < FOV_GRID_SIZE && bitrow_test(visible, compact_y)) {
+                *cell = tile_glyphs[tile->type][0];
+            } else {
+                *cell = bitrow_test(explored, dungeon_y) ? tile_glyphs[tile->type][1] : ZCELL_EMPTY;
+            }
+        }
     }
 }
 
-// Render the dungeon background to z-buffer 0
-static void render_dungeon_background(AppState *app_state) {
-    if (!app_state || !app_state->dungeon.width || !app_state->render.z_buffer_0) return;
+// Write the visible actors and items inside the viewport to their layers. Walks the
+// viewport's tiles through the dungeon's occupancy slots, so the work follows what
+// is on screen rather than how many entities exist. Returns entities written.
+static uint32_t render_visible_entities(AppState *app_state) {
+    if (!app_state->render.z_buffer.cells) return 0;
     
-    // Clear z-buffer 0
-    memset(app_state->render.z_buffer_0, 0, GAME_AREA_WIDTH * GAME_AREA_HEIGHT * sizeof(ZBufferCell));
+    CompactFieldOfView *player_fov = ECS_GET(app_state, app_state->player, FieldOfView);
+    if (!player_fov) return 0;
     
-    for (int screen_y = 0; screen_y < GAME_AREA_HEIGHT; screen_y++) {
-        for (int screen_x = 0; screen_x < GAME_AREA_WIDTH; screen_x++) {
-            // Calculate dungeon coordinates
+    uint32_t written = 0;
+    for (int screen_y = 0; screen_y < app_state->render.game_area_height; screen_y++) {
+        int dungeon_y = app_state->render.viewport_y + screen_y;
+        if (dungeon_y < 0 || dungeon_y >= DUNGEON_HEIGHT) continue;
+        
+        for (int screen_x = 0; screen_x < app_state->render.game_area_width; screen_x++) {
             int dungeon_x = app_state->render.viewport_x + screen_x;
-            int dungeon_y = app_state->render.viewport_y + screen_y;
+            if (dungeon_x < 0 || dungeon_x >= DUNGEON_WIDTH) continue;
+            
+            // Only render what the player can see
+            if (!field_is_visible_compact(player_fov, dungeon_x, dungeon_y)) continue;
+            
+            Entity actor, item;
+            if (!dungeon_get_entities_at_position(&app_state->dungeon, dungeon_x, dungeon_y, &actor, &item)) {
+                continue;
+            }
             
-            // Check bounds
-            if (dungeon_x >= 0 && dungeon_x < DUNGEON_WIDTH && 
-                dungeon_y >= 0 && dungeon_y < DUNGEON_HEIGHT) {
+            // The actors layer sits above items, so an actor standing on one is drawn on top
+            Entity entities[2] = {item, actor};
+            RenderLayer layers[2] = {RENDER_LAYER_ITEMS, RENDER_LAYER_ACTORS};
+            for (int i = 0; i < 2; i++) {
+                if (entities[i] == INVALID_ENTITY) continue;
                 
-                // Get visibility status from player's FOV
-                uint8_t visibility = 0;
-                CompactFieldOfView *player_fov = (CompactFieldOfView *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "FieldOfView"));
-                if (player_fov) {
-                    if (field_is_visible_compact(player_fov, dungeon_x, dungeon_y)) {
-                        visibility = 1; // Currently visible
-                    } else if (dungeon_is_explored(&app_state->dungeon, dungeon_x, dungeon_y)) {
-                        visibility = 2; // Explored but not currently visible
-                    } else {
-                        visibility = 0; // Not visible and not explored
-                    }
+                BaseInfo *base_info = ECS_GET(app_state, entities[i], BaseInfo);
+                if (!base_info) continue;
+                
+                write_to_z_buffer(app_state, layers[i], screen_x, screen_y, base_info->character, base_info->color);
+                written++;
+            }
+        }
+    }
+    return written;
+}
+
+// Draw the game area from resolved cells and return how many cells were drawn. Cells
+// are queued as atlas quads and submitted with one SDL_RenderGeometry call; the grid
+// is one overlay copy. With a render target, unchanged cells keep last frame's pixels
+// and an unchanged frame queues nothing. draw_calls receives the map draw calls made.
+static uint32_t render_game_area(AppState *app_state, const ZBufferCell *cells, uint32_t *draw_calls) {
+    SDL_Renderer *renderer = app_state->render.renderer;
+    SDL_Texture *target = app_state->render.game_area_target;
+    GlyphBatch *batch = &app_state->render.map_batch;
+    uint32_t redrawn = 0;
+    int width = app_state->render.game_area_width;
+    int height = app_state->render.game_area_height;
+    int cell_size = app_state->render.cell_size;
+    
+    // Whole cells only, centered in the map area
+    const SDL_Rect *map_area = &app_state->render.map_area;
+    SDL_Rect game_area = {
+        map_area->x + (map_area->w - width * cell_size) / 2,
+        map_area->y + (map_area->h - height * cell_size) / 2,
+        width * cell_size,
+        height * cell_size
+    };
+    
+    batch->submits = 0;
+    uint32_t copies = 0;
+    
+    if (!target || !app_state->render.previous_cells) {
+        // No persistent target: draw every cell straight to the window
+        for (int screen_y = 0; screen_y < height; screen_y++) {
+            for (int screen_x = 0; screen_x < width; screen_x++) {
+                ZBufferCell cell = cells[screen_y * width + screen_x];
+                if (cell == ZCELL_EMPTY) continue;
+                
+                render_game_area_cell(app_state, game_area.x + screen_x * cell_size,
+                                      game_area.y + screen_y * cell_size, cell, false);
+                redrawn++;
+            }
+        }
+        glyph_batch_submit(batch, renderer, &app_state->render.map_atlas);
+    } else {
+        bool full_redraw = !app_state->render.game_area_valid;
+        bool target_bound = false;
+        
+        for (int screen_y = 0; screen_y < height; screen_y++) {
+            for (int screen_x = 0; screen_x < width; screen_x++) {
+                int index = screen_y * width + screen_x;
+                ZBufferCell cell = cells[index];
+                if (!full_redraw && cell == app_state->render.previous_cells[index]) {
+                    continue;
                 }
                 
-                // Only render if visible or explored
-                if (visibility > 0) {
-                    // Get tile from dungeon                
-                Tile *tile = dungeon_get_tile(&app_state->dungeon, dungeon_x, dungeon_y);
-                    if (tile) {
-                        TileInfo *info = dungeon_get_tile_info(tile->type);
-                        if (info) {
-                            // Adjust color based on visibility
-                            uint8_t color = info->color;
-                            if (visibility == 2) { // Explored but not visible
-                                // Darken the color for explored areas
-                                color = 0x08; // Dark gray
-                            }
-                            
-                            // Write to z-buffer 0
-                            write_to_z_buffer(app_state->render.z_buffer_0, screen_x, screen_y, info->symbol, color);
-                        }
+                // Bind the target lazily so unchanged frames skip it entirely
+                if (!target_bound) {
+                    SDL_SetRenderTarget(renderer, target);
+                    if (full_redraw) {
+                        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                        SDL_RenderClear(renderer);
                     }
+                    target_bound = true;
                 }
+                
+                // Cell positions are relative to the target, not the window
+                render_game_area_cell(app_state, screen_x * cell_size, screen_y * cell_size, cell, !full_redraw);
+                
+                app_state->render.previous_cells[index] = cell;
+                redrawn++;
             }
         }
+        
+        if (target_bound) {
+            glyph_batch_submit(batch, renderer, &app_state->render.map_atlas);
+            SDL_SetRenderTarget(renderer, NULL);
+        }
+        app_state->render.game_area_valid = true;
+        
+        SDL_RenderCopy(renderer, target, NULL, &game_area);
+        copies++;
+    }
+    
+    if (app_state->render.grid_overlay) {
+        SDL_RenderCopy(renderer, app_state->render.grid_overlay, NULL, &game_area);
+        copies++;
+    }
+    
+    *draw_calls = batch->submits + copies;
+    return redrawn;
+}
+
+// Window and panel rectangles from config.render, and the starting zoom level: the
+// one closest to the configured cell size
+static void render_system_layout(AppState *app_state) {
+    const RenderConfig *config = &app_state->config.render;
+    int cell_size = (int)config->cell_size;
+    int sidebar_px = (int)config->sidebar_width * cell_size;
+    int map_width_px = (int)config->game_area_width * cell_size;
+    int map_height_px = (int)config->game_area_height * cell_size;
+    int status_px = (int)config->status_line_height * cell_size;
+    
+    app_state->render.window_width_px = sidebar_px + map_width_px;
+    app_state->render.window_height_px = map_height_px + status_px;
+    app_state->render.sidebar_rect = (SDL_Rect){0, 0, sidebar_px, map_height_px};
+    app_state->render.map_area = (SDL_Rect){sidebar_px, 0, map_width_px, map_height_px};
+    app_state->render.status_rect = (SDL_Rect){0, map_height_px, app_state->render.window_width_px, status_px};
+    
+    int level = 0;
+    for (int i = 1; i < RENDER_ZOOM_LEVEL_COUNT; i++) {
+        if (abs(zoom_cell_sizes[i] - cell_size) < abs(zoom_cell_sizes[level] - cell_size)) {
+            level = i;
+        }
+    }
+    app_state->render.zoom_level = level;
+    app_state->render.zoom_pending = -1;
+    app_state->render.cell_size = zoom_cell_sizes[level];
+    app_state->render.game_area_width = map_width_px / app_state->render.cell_size;
+    app_state->render.game_area_height = map_height_px / app_state->render.cell_size;
+}
+
+// Open the map font at the zoom's cell size and bake its atlas, batch and grid.
+// Each piece is optional: the map falls back to colored rectangles, per-cell draws
+// or no grid lines.
+static void init_map_glyphs(AppState *app_state) {
+    if (app_state->render.font_path) {
+        app_state->render.map_font = TTF_OpenFont(app_state->render.font_path, app_state->render.cell_size);
+    }
+    if (!app_state->render.map_font ||
+        !glyph_atlas_build(&app_state->render.map_atlas, app_state->render.renderer, app_state->render.map_font)) {
+        LOG_WARN("Map will render without glyphs");
+    }
+    
+    // Two quads per cell covers a full redraw (clear + glyph) in one submission up to the cap
+    int quads = app_state->render.game_area_width * app_state->render.game_area_height * 2;
+    if (!glyph_batch_init(&app_state->render.map_batch, quads < MAP_BATCH_MAX_QUADS ? quads : MAP_BATCH_MAX_QUADS)) {
+        LOG_WARN("Map cells will be drawn individually");
+    }
+    if (!init_grid_overlay(app_state)) {
+        LOG_WARN("Map will render without grid lines");
+    }
+}
+
+static void cleanup_map_glyphs(AppState *app_state) {
+    glyph_atlas_destroy(&app_state->render.map_atlas);
+    glyph_batch_free(&app_state->render.map_batch);
+    if (app_state->render.grid_overlay) {
+        SDL_DestroyTexture(app_state->render.grid_overlay);
+        app_state->render.grid_overlay = NULL;
+    }
+    if (app_state->render.map_font) {
+        TTF_CloseFont(app_state->render.map_font);
+        app_state->render.map_font = NULL;
+    }
+}
+
+// Rebuild everything sized by the map grid for zoom level. On allocation failure
+// the previous level is restored.
+static bool apply_zoom(AppState *app_state, int level) {
+    int previous = app_state->render.zoom_level;
+    bool map_build_running = app_state->render.map_build.running;
+    
+    // Stops the map build thread, so no build is writing the buffers while they change
+    cleanup_z_buffers(app_state);
+    cleanup_map_glyphs(app_state);
+    
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int zoom = attempt == 0 ? level : previous;
+        app_state->render.zoom_level = zoom;
+        app_state->render.cell_size = zoom_cell_sizes[zoom];
+        app_state->render.game_area_width = app_state->render.map_area.w / app_state->render.cell_size;
+        app_state->render.game_area_height = app_state->render.map_area.h / app_state->render.cell_size;
+        
+        init_map_glyphs(app_state);
+        if (init_z_buffers(app_state)) break;
+        
+        LOG_ERROR("Failed to allocate the map at %dpx cells", app_state->render.cell_size);
+        cleanup_z_buffers(app_state);
+        cleanup_map_glyphs(app_state);
+        if (attempt == 1) return false;
+    }
+    
+    center_viewport(app_state);
+    app_state->render.invalidate_pending = true;
+    LOG_INFO("Map zoom %dpx: %dx%d cells", app_state->render.cell_size,
+             app_state->render.game_area_width, app_state->render.game_area_height);
+    
+    if (map_build_running && !render_system_start_map_build(app_state)) {
+        LOG_WARN("Map build thread could not be restarted after zoom");
     }
+    return app_state->render.zoom_level == level;
 }
 
-// Pre-update function to handle screen clearing and viewport updates
+// Pre-update function to handle zoom and viewport updates
 static void render_system_pre_update(AppState *app_state) {
     if (!app_state || !app_state->render.renderer) {
         LOG_ERROR("Renderer not initialized");
         return;
     }
     
+    // Zoom requests rebuild the map buffers before anything is written to them
+    if (app_state->render.zoom_pending >= 0) {
+        int level = app_state->render.zoom_pending;
+        app_state->render.zoom_pending = -1;
+        if (level != app_state->render.zoom_level) {
+            apply_zoom(app_state, level);
+        }
+    }
+    
     // Update viewport based on player position
     update_viewport(app_state);
+}
+
+// Build the snapshot's game area: player FOV, background, entities and the layer
+// composite. Runs on the map build thread while it is active, otherwise inline; it only
+// writes the player's FOV, the z-buffer and the snapshot cells, and leaves the
+// profiler to render_system_finish_build on the main thread.
+static void render_system_build_game_area(RenderSnapshot *snapshot, MapBuildStats *stats, void *user) {
+    AppState *app_state = (AppState *)user;
     
     // Calculate field of view from player position
-    if (app_state) {
-        Position *player_pos = (Position *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "Position"));
-        CompactFieldOfView *player_fov = (CompactFieldOfView *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "FieldOfView"));
-        if (player_pos && player_fov) {
-            field_calculate_fov_compact(player_fov, &app_state->dungeon, (int)player_pos->x, (int)player_pos->y);
+    Position *player_pos = ECS_GET(app_state, app_state->player, Position);
+    CompactFieldOfView *player_fov = ECS_GET(app_state, app_state->player, FieldOfView);
+    if (player_pos && player_fov) {
+        // The cached grid stands until the player moves or a wall near them changes
+        uint64_t fov_start = profiler_now();
+        stats->fov_recomputed = field_update_fov_compact(player_fov, &app_state->dungeon, (int)player_pos->x, (int)player_pos->y);
+        stats->fov_ticks = profiler_now() - fov_start;
+        stats->fov_updated = true;
+    }
+    
+    // Clear last frame's entity, effect and overlay layers; the background is rewritten in full
+    zbuffer_clear(&app_state->render.z_buffer, ZBUFFER_LAYER_BIT(RENDER_LAYER_BACKGROUND));
+    
+    // Render dungeon background to its layer
+    uint64_t background_start = profiler_now();
+    render_system_compose_background(app_state);
+    stats->background_ticks = profiler_now() - background_start;
+    
+    // Entities inside the viewport to the item and actor layers
+    uint64_t entities_start = profiler_now();
+    stats->entities_drawn = render_visible_entities(app_state);
+    stats->entities_ticks = profiler_now() - entities_start;
+    
+    // Layers are composited now so drawing the snapshot doesn't depend on the z-buffer
+    uint64_t composite_start = profiler_now();
+    zbuffer_composite(&app_state->render.z_buffer, snapshot->cells);
+    stats->composite_ticks = profiler_now() - composite_start;
+}
+
+// Wait for the game area build and report it to the profiler; a no-op once done
+static void render_system_finish_build(AppState *app_state) {
+    MapBuildStats stats;
+    if (!map_build_thread_finish_build(&app_state->render.map_build, &stats)) return;
+    
+    if (stats.fov_updated) {
+        profiler_section_record(app_state, "FOV", stats.fov_ticks);
+        if (stats.fov_recomputed) {
+            app_state->render.fov_recomputes++;
+        } else {
+            app_state->render.fov_cache_hits++;
         }
+        profiler_count(app_state, "FOV recomputes", stats.fov_recomputed ? 1 : 0);
+        profiler_count(app_state, "FOV cache hits", stats.fov_recomputed ? 0 : 1);
     }
+    profiler_section_record(app_state, "Background", stats.background_ticks);
+    profiler_section_record(app_state, "Entities", stats.entities_ticks);
+    profiler_count(app_state, "Entities drawn", stats.entities_drawn);
+    profiler_section_record(app_state, "Composite", stats.composite_ticks);
+}
+
+// Draw one recorded frame and present it, always on the main thread. Commands ahead
+// of the game area are drawn while the map build thread may still be building it.
+static void render_system_draw_snapshot(AppState *app_state, const RenderSnapshot *snapshot, RenderFrameStats *stats) {
+    SDL_Renderer *renderer = app_state->render.renderer;
+    uint64_t frame_start = profiler_now();
     
-    // Clear z-buffer 1 (entity layer)
-    if (app_state->render.z_buffer_1) {
-        memset(app_state->render.z_buffer_1, 0, GAME_AREA_WIDTH * GAME_AREA_HEIGHT * sizeof(ZBufferCell));
+    if (snapshot->purge_text) {
+        text_cache_purge(&app_state->render.text_cache, NULL);
+    }
+    if (snapshot->invalidate) {
+        app_state->render.game_area_valid = false;
     }
     
-    // Render dungeon background to z-buffer 0
-    render_dungeon_background(app_state);
+    // Clear main renderer
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    
+    for (uint32_t i = 0; i < snapshot->command_count; i++) {
+        const RenderCommand *command = &snapshot->commands[i];
+        switch (command->type) {
+            case RENDER_COMMAND_FILL:
+                if (command->color.a < 255) {
+                    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+                }
+                SDL_SetRenderDrawColor(renderer, command->color.r, command->color.g, command->color.b, command->color.a);
+                SDL_RenderFillRect(renderer, &command->rect);
+                if (command->color.a < 255) {
+                    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+                }
+                break;
+            case RENDER_COMMAND_OUTLINE:
+                SDL_SetRenderDrawColor(renderer, command->color.r, command->color.g, command->color.b, command->color.a);
+                SDL_RenderDrawRect(renderer, &command->rect);
+                break;
+            case RENDER_COMMAND_TEXT:
+                text_cache_draw(command->cached ? &app_state->render.text_cache : NULL, renderer, command->font,
+                                render_snapshot_text(snapshot, command), command->rect.x, command->rect.y,
+                                command->color, NULL, NULL);
+                break;
+            case RENDER_COMMAND_GAME_AREA: {
+                render_system_finish_build(app_state);
+                
+                // Render game area from the snapshot, touching only cells that changed
+                uint64_t draw_start = profiler_now();
+                stats->cells_redrawn = render_game_area(app_state, snapshot->cells, &stats->draw_calls);
+                stats->draw_cells_ticks = profiler_now() - draw_start;
+                break;
+            }
+        }
+    }
+    
+    text_cache_take_frame_counts(&app_state->render.text_cache, &stats->text_hits, &stats->text_misses);
+    
+    // Present the final frame
+    SDL_RenderPresent(renderer);
+    stats->frame_ticks = profiler_now() - frame_start;
+}
+
+// Commands for the main renderer are recorded while post_update builds a snapshot
+static RenderSnapshot *render_system_recording(AppState *app_state, SDL_Renderer *renderer) {
+    if (!app_state || !app_state->render.recording || renderer != app_state->render.renderer) return NULL;
+    return app_state->render.recording;
 }
 
-// Post-update function to render from z-buffers and present the frame
+// Next command slot, or NULL when the snapshot is full and the command is dropped
+static RenderCommand *render_system_push_command(RenderSnapshot *snapshot, RenderCommandType type) {
+    if (snapshot->command_count >= RENDER_SNAPSHOT_MAX_COMMANDS) {
+        snapshot->dropped_commands++;
+        return NULL;
+    }
+    RenderCommand *command = &snapshot->commands[snapshot->command_count++];
+    command->type = type;
+    return command;
+}
+
+// Post-update function: record the views, build the game area while the commands
+// ahead of it are drawn, then draw the map and present the frame
 static void render_system_post_update(AppState *app_state) {
-    if (!app_state || !app_state->render.renderer) return;
+    if (!app_state || !app_state->render.renderer || !app_state->render.previous_cells) return;
     
-    // Clear main renderer
-    SDL_SetRenderDrawColor(app_state->render.renderer, 0, 0, 0, 255);
-    SDL_RenderClear(app_state->render.renderer);
+    MapBuildThread *thread = &app_state->render.map_build;
+    RenderSnapshot *snapshot = map_build_thread_begin_snapshot(thread);
+    snapshot->invalidate = app_state->render.invalidate_pending;
+    snapshot->purge_text = app_state->render.purge_text_pending;
+    app_state->render.invalidate_pending = false;
+    app_state->render.purge_text_pending = false;
+    
+    app_state->render.recording = snapshot;
     
     // Render player view sidebar
     playerview_render(app_state->render.renderer, app_state);
     
-    // Render game area from z-buffers: check entity layer first, then background
-    for (int screen_y = 0; screen_y < GAME_AREA_HEIGHT; screen_y++) {
-        for (int screen_x = 0; screen_x < GAME_AREA_WIDTH; screen_x++) {
-            int index = screen_y * GAME_AREA_WIDTH + screen_x;
-            
-            // Calculate actual screen position (offset by sidebar)
-            int actual_screen_x = (screen_x + GAME_AREA_X_OFFSET) * CELL_SIZE;
-            int actual_screen_y = (screen_y + GAME_AREA_Y_OFFSET) * CELL_SIZE;
-            
-            // Check entity layer first (z-buffer 1)
-            if (app_state->render.z_buffer_1 && app_state->render.z_buffer_1[index].has_content) {
-                render_tile_at_screen_pos_to_renderer(app_state->render.renderer, app_state->render.font_medium,
-                                                     actual_screen_x, actual_screen_y,
-                                                     app_state->render.z_buffer_1[index].character, 
-                                                     app_state->render.z_buffer_1[index].color);
-            }
-            // Fall back to background layer (z-buffer 0)
-            else if (app_state->render.z_buffer_0 && app_state->render.z_buffer_0[index].has_content) {
-                render_tile_at_screen_pos_to_renderer(app_state->render.renderer, app_state->render.font_medium,
-                                                     actual_screen_x, actual_screen_y,
-                                                     app_state->render.z_buffer_0[index].character, 
-                                                     app_state->render.z_buffer_0[index].color);
-            }
-        }
-    }
+    render_system_push_command(snapshot, RENDER_COMMAND_GAME_AREA);
     
     // Render status line LAST to ensure it's on top
     statusview_render(app_state->render.renderer, app_state);
     
-    // Render message window (handles its own window)
-    messageview_render(app_state->render.renderer, app_state);
+    // Profiler overlay sits over the game area
+    profiler_render_overlay(app_state->render.renderer, app_state->render.font_small, app_state);
     
-    // Present the final frame
-    SDL_RenderPresent(app_state->render.renderer);
+    app_state->render.recording = NULL;
+    
+    // The views have read the ECS, and drawing only touches SDL, the text cache and
+    // the recorded commands, so the build owns the ECS, dungeon and z-buffer until
+    // it is finished at the game area command
+    map_build_thread_build(thread, render_system_build_game_area, app_state);
+    
+    RenderFrameStats stats;
+    memset(&stats, 0, sizeof(RenderFrameStats));
+    stats.sequence = snapshot->sequence;
+    render_system_draw_snapshot(app_state, snapshot, &stats);
+    
+    // Also covers a game area command dropped for lack of space
+    render_system_finish_build(app_state);
+    
+    app_state->render.cells_redrawn = stats.cells_redrawn;
+    profiler_section_record(app_state, "Draw cells", stats.draw_cells_ticks);
+    profiler_section_record(app_state, "Present", stats.frame_ticks);
+    profiler_count(app_state, "Cells redrawn", stats.cells_redrawn);
+    profiler_count(app_state, "Map draw calls", stats.draw_calls);
+    profiler_count(app_state, "Text hits", stats.text_hits);
+    profiler_count(app_state, "Text misses", stats.text_misses);
+    
+    // Render message window (handles its own window and renderer)
+    messageview_render(app_state->render.renderer, app_state);
 }
 
 int render_system_init(AppState *app_state) {
@@ -317,8 +764,12 @@ int render_system_init(AppState *app_state) {
         return 0;
     }
     
-    // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+    text_cache_init(&app_state->render.text_cache, (size_t)app_state->config.render.text_cache_kb * 1024);
+    render_system_layout(app_state);
+    
+    // Initialize SDL; headless runs never touch the video subsystem
+    bool headless = app_state->config.render.headless;
+    if (SDL_Init(headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO) < 0) {
         LOG_ERROR("SDL could not initialize! SDL_Error: %s", SDL_GetError());
         return 0;
     }
@@ -330,28 +781,51 @@ int render_system_init(AppState *app_state) {
         return 0;
     }
     
-    // Create window
-    app_state->render.window = SDL_CreateWindow("Adventure Game - ECS", 
-                               SDL_WINDOWPOS_UNDEFINED, 
-                               SDL_WINDOWPOS_UNDEFINED,
-                               WINDOW_WIDTH_PX, 
-                               WINDOW_HEIGHT_PX, 
-                               SDL_WINDOW_SHOWN);
-    if (app_state->render.window == NULL) {
-        LOG_ERROR("Window could not be created! SDL_Error: %s", SDL_GetError());
-        TTF_Quit();
-        SDL_Quit();
-        return 0;
-    }
-    
-    // Create renderer
-    app_state->render.renderer = SDL_CreateRenderer(app_state->render.window, -1, SDL_RENDERER_ACCELERATED);
-    if (app_state->render.renderer == NULL) {
-        LOG_ERROR("Renderer could not be created! SDL_Error: %s", SDL_GetError());
-        SDL_DestroyWindow(app_state->render.window);
-        TTF_Quit();
-        SDL_Quit();
-        return 0;
+    if (headless) {
+        // Offscreen: a software renderer drawing into a plain surface
+        app_state->render.headless_surface = SDL_CreateRGBSurfaceWithFormat(0, app_state->render.window_width_px, app_state->render.window_height_px,
+                                                                           32, SDL_PIXELFORMAT_ARGB8888);
+        if (app_state->render.headless_surface == NULL) {
+            LOG_ERROR("Headless surface could not be created! SDL_Error: %s", SDL_GetError());
+            TTF_Quit();
+            SDL_Quit();
+            return 0;
+        }
+        
+        app_state->render.renderer = SDL_CreateSoftwareRenderer(app_state->render.headless_surface);
+        if (app_state->render.renderer == NULL) {
+            LOG_ERROR("Software renderer could not be created! SDL_Error: %s", SDL_GetError());
+            SDL_FreeSurface(app_state->render.headless_surface);
+            app_state->render.headless_surface = NULL;
+            TTF_Quit();
+            SDL_Quit();
+            return 0;
+        }
+        LOG_INFO("Rendering headless to a %dx%d offscreen surface", app_state->render.window_width_px, app_state->render.window_height_px);
+    } else {
+        // Create window
+        app_state->render.window = SDL_CreateWindow("Adventure Game - ECS", 
+                                   SDL_WINDOWPOS_UNDEFINED, 
+                                   SDL_WINDOWPOS_UNDEFINED,
+                                   app_state->render.window_width_px, 
+                                   app_state->render.window_height_px, 
+                                   SDL_WINDOW_SHOWN);
+        if (app_state->render.window == NULL) {
+            LOG_ERROR("Window could not be created! SDL_Error: %s", SDL_GetError());
+            TTF_Quit();
+            SDL_Quit();
+            return 0;
+        }
+        
+        // Create renderer
+        app_state->render.renderer = SDL_CreateRenderer(app_state->render.window, -1, SDL_RENDERER_ACCELERATED);
+        if (app_state->render.renderer == NULL) {
+            LOG_ERROR("Renderer could not be created! SDL_Error: %s", SDL_GetError());
+            SDL_DestroyWindow(app_state->render.window);
+            TTF_Quit();
+            SDL_Quit();
+            return 0;
+        }
     }
     
     // Initialize fonts - try multiple paths for each size
@@ -382,6 +856,7 @@ int render_system_init(AppState *app_state) {
     for (int i = 0; font_paths[i] != NULL; i++) {
         app_state->render.font_medium = TTF_OpenFont(font_paths[i], 16);
         if (app_state->render.font_medium) {
+            app_state->render.font_path = font_paths[i];
             LOG_INFO("Loaded medium font: %s", font_paths[i]);
             break;
         }
@@ -400,11 +875,15 @@ int render_system_init(AppState *app_state) {
         LOG_WARN("Could not load all required fonts");
     }
     
+    // Map glyphs, batch and grid for the starting zoom level
+    init_map_glyphs(app_state);
+    
     // Initialize z-buffer system
     if (!init_z_buffers(app_state)) {
         LOG_ERROR("Failed to initialize z-buffer system");
         
         // Cleanup fonts on failure
+        cleanup_map_glyphs(app_state);
         if (app_state->render.font_small) {
             TTF_CloseFont(app_state->render.font_small);
             app_state->render.font_small = NULL;
@@ -418,7 +897,13 @@ int render_system_init(AppState *app_state) {
             app_state->render.font_large = NULL;
         }
         SDL_DestroyRenderer(app_state->render.renderer);
-        SDL_DestroyWindow(app_state->render.window);
+        if (app_state->render.window) {
+            SDL_DestroyWindow(app_state->render.window);
+        }
+        if (app_state->render.headless_surface) {
+            SDL_FreeSurface(app_state->render.headless_surface);
+            app_state->render.headless_surface = NULL;
+        }
         TTF_Quit();
         SDL_Quit();
         return 0;
@@ -435,6 +920,10 @@ void render_system_cleanup(AppState *app_state) {
     // Clean up z-buffers first
     cleanup_z_buffers(app_state);
     
+    // Atlas, grid and text textures belong to the renderer, so free them before the renderer goes
+    text_cache_cleanup(&app_state->render.text_cache);
+    cleanup_map_glyphs(app_state);
+    
     // Cleanup all fonts
     if (app_state->render.font_small) {
         TTF_CloseFont(app_state->render.font_small);
@@ -456,11 +945,119 @@ void render_system_cleanup(AppState *app_state) {
         SDL_DestroyWindow(app_state->render.window);
         app_state->render.window = NULL;
     }
+    if (app_state->render.headless_surface) {
+        SDL_FreeSurface(app_state->render.headless_surface);
+        app_state->render.headless_surface = NULL;
+    }
     TTF_Quit();
     SDL_Quit();
     app_state->render.initialized = false;
 }
 
+void render_system_zoom(AppState *app_state, int delta) {
+    if (!app_state || !app_state->render.initialized) return;
+    
+    int level = (app_state->render.zoom_pending >= 0 ? app_state->render.zoom_pending : app_state->render.zoom_level) + delta;
+    if (level < 0) level = 0;
+    if (level >= RENDER_ZOOM_LEVEL_COUNT) level = RENDER_ZOOM_LEVEL_COUNT - 1;
+    app_state->render.zoom_pending = level;
+}
+
+void render_system_invalidate(AppState *app_state) {
+    if (!app_state) return;
+    // Applied by whoever draws the next snapshot
+    app_state->render.invalidate_pending = true;
+}
+
+void render_system_device_reset(AppState *app_state) {
+    if (!app_state) return;
+    app_state->render.invalidate_pending = true;
+    app_state->render.purge_text_pending = true;
+}
+
+bool render_system_start_map_build(AppState *app_state) {
+    if (!app_state || !app_state->render.renderer) return false;
+    if (!app_state->config.render.map_build_thread || app_state->render.map_build.running) return true;
+    
+    return map_build_thread_start(&app_state->render.map_build);
+}
+
+void render_system_stop_map_build(AppState *app_state) {
+    if (!app_state) return;
+    map_build_thread_stop(&app_state->render.map_build);
+}
+
+static void render_system_text(AppState *app_state, SDL_Renderer *renderer, TTF_Font *font,
+                               const char *text, int x, int y, SDL_Color color, bool cached) {
+    if (!font || !text || text[0] == '\0') return;
+    
+    RenderSnapshot *snapshot = render_system_recording(app_state, renderer);
+    if (snapshot) {
+        RenderCommand *command = render_system_push_command(snapshot, RENDER_COMMAND_TEXT);
+        if (command) {
+            command->rect = (SDL_Rect){x, y, 0, 0};
+            command->color = color;
+            command->font = font;
+            command->cached = cached;
+            if (!render_snapshot_add_text(snapshot, text, &command->text)) {
+                // Out of text space: take the command back
+                snapshot->command_count--;
+                snapshot->dropped_commands++;
+            }
+        }
+        return;
+    }
+    
+    bool use_cache = cached && app_state;
+    text_cache_draw(use_cache ? &app_state->render.text_cache : NULL, renderer, font, text, x, y, color, NULL, NULL);
+}
+
+void render_system_draw_text(AppState *app_state, SDL_Renderer *renderer, TTF_Font *font,
+                             const char *text, int x, int y, SDL_Color color) {
+    render_system_text(app_state, renderer, font, text, x, y, color, true);
+}
+
+void render_system_draw_text_uncached(AppState *app_state, SDL_Renderer *renderer, TTF_Font *font,
+                                      const char *text, int x, int y, SDL_Color color) {
+    render_system_text(app_state, renderer, font, text, x, y, color, false);
+}
+
+static void render_system_rect(AppState *app_state, SDL_Renderer *renderer, const SDL_Rect *rect,
+                               SDL_Color color, RenderCommandType type) {
+    if (!renderer || !rect) return;
+    
+    RenderSnapshot *snapshot = render_system_recording(app_state, renderer);
+    if (snapshot) {
+        RenderCommand *command = render_system_push_command(snapshot, type);
+        if (command) {
+            command->rect = *rect;
+            command->color = color;
+        }
+        return;
+    }
+    
+    if (type == RENDER_COMMAND_FILL && color.a < 255) {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    }
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    if (type == RENDER_COMMAND_FILL) {
+        SDL_RenderFillRect(renderer, rect);
+        if (color.a < 255) {
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        }
+    } else {
+        SDL_RenderDrawRect(renderer, rect);
+    }
+}
+
+void render_system_fill_rect(AppState *app_state, SDL_Renderer *renderer, const SDL_Rect *rect, SDL_Color color) {
+    render_system_rect(app_state, renderer, rect, color, RENDER_COMMAND_FILL);
+}
+
+void render_system_outline_rect(AppState *app_state, SDL_Renderer *renderer, const SDL_Rect *rect, SDL_Color color) {
+    render_system_rect(app_state, renderer, rect, color, RENDER_COMMAND_OUTLINE);
+}
+
 SDL_Renderer* render_system_get_renderer(AppState *app_state) {
     if (!app_state) return NULL;
     return app_state->render.renderer;
@@ -489,7 +1086,7 @@ void render_system_register(void) {
         return;
     }
     
-    uint32_t component_mask = (1 << component_get_id(app_state, "Position")) | (1 << component_get_id(app_state, "BaseInfo"));
+    uint32_t component_mask = COMPONENT_BIT(Position) | COMPONENT_BIT(BaseInfo);
     
     // Render system should run last and depends on input and action systems
     static const char* dependencies[] = {"InputSystem", "ActionSystem", NULL};
@@ -497,11 +1094,15 @@ void render_system_register(void) {
     SystemConfig config = {
         .name = "RenderSystem",
         .component_mask = component_mask,
-        .function = render_system,
+        .function = NULL,  // Entities are found through the viewport's tiles in the game area build
         .pre_update = render_system_pre_update,
         .post_update = render_system_post_update,
         .priority = SYSTEM_PRIORITY_LAST,
-        .dependencies = dependencies
+        .dependencies = dependencies,
+        // Updates the player's FOV; pre/post update own the renderer, so main thread only
+        .read_mask = component_mask | COMPONENT_BIT(FieldOfView),
+        .write_mask = COMPONENT_BIT(FieldOfView),
+        .threading = SYSTEM_THREADING_MAIN
     };
     
     if (system_register(app_state, &config)) {
@@ -510,49 +1111,3 @@ void render_system_register(void) {
         LOG_ERROR("Failed to register render system");
     }
 }
-
-void render_system(Entity entity, AppState *app_state) {
-    if (!app_state || !app_state->render.renderer || !app_state->render.z_buffer_1) {
-        LOG_ERROR("Renderer, app_state, or z-buffer not initialized");
-        return;
-    }
-    
-    // Get component data
-    Position *pos = (Position *)entity_get_component(app_state, entity, component_get_id(app_state, "Position"));
-    BaseInfo *base_info = (BaseInfo *)entity_get_component(app_state, entity, component_get_id(app_state, "BaseInfo"));
-    
-    if (!pos || !base_info) {
-        LOG_ERROR("Missing position or base info component");
-        return;
-    }
-    
-    // Don't render entities that are in someone's inventory
-    if (pos->entity != INVALID_ENTITY) {
-        // This entity is being carried by someone, don't render on map
-        return;
-    }
-    
-    // Convert world coordinates to screen coordinates (relative to viewport)
-    int screen_x = (int)(pos->x - app_state->render.viewport_x);
-    int screen_y = (int)(pos->y - app_state->render.viewport_y);
-    
-    // Only process if entity is visible in game area viewport
-    if (screen_x >= 0 && screen_x < GAME_AREA_WIDTH && 
-        screen_y >= 0 && screen_y < GAME_AREA_HEIGHT) {
-        
-        // Check if entity is visible (only render if player can see it)
-        int dungeon_x = (int)pos->x;
-        int dungeon_y = (int)pos->y;
-        
-        bool entity_visible = false;
-        CompactFieldOfView *player_fov = (CompactFieldOfView *)entity_get_component(app_state, app_state->player, component_get_id(app_state, "FieldOfView"));
-        if (player_fov) {
-            entity_visible = field_is_visible_compact(player_fov, dungeon_x, dungeon_y);
-        }
-        
-        // Only write to z-buffer if entity is visible
-        if (entity_visible) {
-            write_to_z_buffer(app_state->render.z_buffer_1, screen_x, screen_y, base_info->character, base_info->color);
-        }
-    }
-} 
@@ -10,38 +10,54 @@
 // Forward declaration
 struct AppState;
 
-// Window and cell constants
-#define CELL_SIZE 16 // pixels
-
-// Layout constants
-#define SIDEBAR_WIDTH 12 // in cells (reduced from 20 for better proportions)
-#define GAME_AREA_WIDTH 48 // in cells (increased from 40)
-#define GAME_AREA_HEIGHT 30 // in cells
-#define STATUS_LINE_HEIGHT 1 // in cells
-
-// Total window dimensions
-#define WINDOW_WIDTH (SIDEBAR_WIDTH + GAME_AREA_WIDTH) // 60 cells total
-#define WINDOW_HEIGHT (GAME_AREA_HEIGHT + STATUS_LINE_HEIGHT) // 31 cells total
-
-#define WINDOW_WIDTH_PX (WINDOW_WIDTH * CELL_SIZE)
-#define WINDOW_HEIGHT_PX (WINDOW_HEIGHT * CELL_SIZE)    
-
-// Layout positions
-#define GAME_AREA_X_OFFSET SIDEBAR_WIDTH // Game area starts after sidebar
-#define GAME_AREA_Y_OFFSET 0
-#define STATUS_LINE_Y_OFFSET GAME_AREA_HEIGHT // Status line starts after game area
+// Layout comes from config.render at runtime (see RenderState). The map area keeps
+// its pixel size; zooming changes its cell size and so how many cells it shows.
+#define RENDER_ZOOM_LEVEL_COUNT 4
+#define RENDER_ZOOM_LEVELS {8, 12, 16, 24} // Map cell sizes in pixels
 
 #define WINDOW_TITLE "Adventure Game"
 
-// Rendering system function
-void render_system(Entity entity, struct AppState *app_state);
-
 // Initialize the rendering system (includes SDL initialization)
 int render_system_init(struct AppState *app_state);
 
 // Cleanup the rendering system (includes SDL cleanup)
 void render_system_cleanup(struct AppState *app_state);
 
+// Force the next frame to redraw every game area cell (e.g. after SDL_RENDER_TARGETS_RESET)
+void render_system_invalidate(struct AppState *app_state);
+
+// After SDL_RENDER_DEVICE_RESET: redraw everything and drop cached text textures
+void render_system_device_reset(struct AppState *app_state);
+
+// With config.render.map_build_thread, build each gameplay frame's map cells (FOV, background,
+// entities, composite) on a worker while the main thread draws the sidebar commands. The
+// frame still waits for the build before drawing the map; presenting, SDL rendering and
+// SDL_ttf stay on the main thread.
+bool render_system_start_map_build(struct AppState *app_state);
+void render_system_stop_map_build(struct AppState *app_state);
+
+// Step the map zoom by delta levels (negative zooms out, showing more cells). Applied at
+// the start of the next render pass; rebuilds the z-buffers, glyph atlas and grid.
+void render_system_zoom(struct AppState *app_state, int delta);
+
+// Composite visible and explored dungeon tiles under the viewport into z-buffer 0.
+// Called from the game area build each frame; public for benchmarks.
+void render_system_compose_background(struct AppState *app_state);
+
+// Draw text through the shared text cache; strings are rasterized once per
+// (renderer, font, text, color) and reused until evicted
+void render_system_draw_text(struct AppState *app_state, SDL_Renderer *renderer, TTF_Font *font,
+                             const char *text, int x, int y, SDL_Color color);
+
+// As render_system_draw_text, for text that changes most frames (not worth caching)
+void render_system_draw_text_uncached(struct AppState *app_state, SDL_Renderer *renderer, TTF_Font *font,
+                                      const char *text, int x, int y, SDL_Color color);
+
+// Filled (alpha < 255 blends) and 1px outlined rectangles. Like the text calls, these are
+// recorded into the frame snapshot when drawing to the main renderer during the render pass.
+void render_system_fill_rect(struct AppState *app_state, SDL_Renderer *renderer, const SDL_Rect *rect, SDL_Color color);
+void render_system_outline_rect(struct AppState *app_state, SDL_Renderer *renderer, const SDL_Rect *rect, SDL_Color color);
+
 // Get the renderer (for other systems that might need it)
 SDL_Renderer* render_system_get_renderer(struct AppState *app_state);
 
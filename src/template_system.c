@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "ecs.h"
+#include "ecs_commands.h"
 #include "components.h"
 #include "appstate.h"
 
@@ -147,52 +148,40 @@ int load_templates_from_file(const char* filename) {
     return 0;
 }
 
-Entity create_entity_from_template(const char* template_name) {
+// Find a loaded template by name, setting the error state if there is none
+static Template *template_find(const char *template_name) {
     if (!template_name) {
         ERROR_SET(RESULT_ERROR_NULL_POINTER, "template_name cannot be NULL");
-        return INVALID_ENTITY;
+        return NULL;
     }
     
     // Check for empty template name
     if (strlen(template_name) == 0) {
         ERROR_SET(RESULT_ERROR_INVALID_PARAMETER, "Template name cannot be empty");
-        return INVALID_ENTITY;
+        return NULL;
     }
     
-    // Get AppState for ECS operations
-    AppState *app_state = appstate_get();
-    if (!app_state) {
-        ERROR_SET(RESULT_ERROR_INITIALIZATION_FAILED, "AppState not available");
-        return INVALID_ENTITY;
-    }
-    
-    // Find template
-    Template* template = NULL;
     for (int i = 0; i < template_count; i++) {
         if (templates[i].name && strcmp(templates[i].name, template_name) == 0) {
-            template = &templates[i];
-            break;
+            return &templates[i];
         }
     }
+    
+    ERROR_SET(RESULT_ERROR_NOT_FOUND, "Template '%s' not found", template_name);
+    return NULL;
+}
 
-    if (!template) {
-        ERROR_SET(RESULT_ERROR_NOT_FOUND, "Template '%s' not found", template_name);
-        return INVALID_ENTITY;
-    }
-
-    // Create entity
-    Entity entity = entity_create(app_state);
-    if (entity == INVALID_ENTITY) {
-        ERROR_SET(RESULT_ERROR_INITIALIZATION_FAILED, "Failed to create entity from template '%s'", template_name);
-        return INVALID_ENTITY;
-    }
-
+// Add every component of a template to entity, either directly or recorded into the
+// calling thread's command buffer (entity is then a provisional handle). False if the
+// template has no component list.
+static bool template_add_components(AppState *app_state, Template *template, Entity entity, bool deferred) {
+    const char *template_name = template->name;
+    
     // Get components array
     cJSON* components = cJSON_GetObjectItem(template->data, "components");
     if (!components || !cJSON_IsArray(components)) {
         LOG_ERROR("No components found in template '%s'", template_name);
-        entity_destroy(app_state, entity);
-        return INVALID_ENTITY;
+        return false;
     }
 
     // Add each component
@@ -290,17 +279,67 @@ Entity create_entity_from_template(const char* template_name) {
         }
 
         if (component_data) {
-            if (!component_add(app_state, entity, component_id, component_data)) {
+            bool added = deferred ? ecs_cmd_add(app_state, entity, component_id, component_data)
+                                  : component_add(app_state, entity, component_id, component_data);
+            if (!added) {
                 LOG_ERROR("Failed to add component '%s' to entity from template '%s'", component_type, template_name);
-                free(component_data);
-            } else {
-                free(component_data); // Component data has been copied, free the temporary allocation
             }
+            free(component_data); // Component data has been copied, free the temporary allocation
         }
     }
+    return true;
+}
+
+Entity create_entity_from_template(const char* template_name) {
+    // Get AppState for ECS operations
+    AppState *app_state = appstate_get();
+    if (!app_state) {
+        ERROR_SET(RESULT_ERROR_INITIALIZATION_FAILED, "AppState not available");
+        return INVALID_ENTITY;
+    }
+    
+    Template *template = template_find(template_name);
+    if (!template) {
+        return INVALID_ENTITY;
+    }
 
+    // Create entity
+    Entity entity = entity_create(app_state);
+    if (entity == INVALID_ENTITY) {
+        ERROR_SET(RESULT_ERROR_INITIALIZATION_FAILED, "Failed to create entity from template '%s'", template_name);
+        return INVALID_ENTITY;
+    }
 
+    if (!template_add_components(app_state, template, entity, false)) {
+        entity_destroy(app_state, entity);
+        return INVALID_ENTITY;
+    }
 
     LOG_INFO("Created entity %d from template '%s'", entity, template_name);
     return entity;
-} 
+}
+
+Entity create_entity_from_template_deferred(const char* template_name) {
+    AppState *app_state = appstate_get();
+    if (!app_state) {
+        ERROR_SET(RESULT_ERROR_INITIALIZATION_FAILED, "AppState not available");
+        return INVALID_ENTITY;
+    }
+    
+    Template *template = template_find(template_name);
+    if (!template) {
+        return INVALID_ENTITY;
+    }
+
+    Entity entity = ecs_cmd_create(app_state);
+    if (entity == INVALID_ENTITY) {
+        ERROR_SET(RESULT_ERROR_INITIALIZATION_FAILED, "Failed to record entity from template '%s'", template_name);
+        return INVALID_ENTITY;
+    }
+
+    if (!template_add_components(app_state, template, entity, true)) {
+        ecs_cmd_destroy(app_state, entity);
+        return INVALID_ENTITY;
+    }
+    return entity;
+}
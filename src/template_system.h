@@ -12,6 +12,11 @@ void template_system_cleanup(void);
 // Create an entity from a template
 Entity create_entity_from_template(const char* template_name);
 
+// Record an entity and its template components into the calling thread's command
+// buffer. Returns a provisional handle, resolved with ecs_commands_resolve after the
+// flush that creates it.
+Entity create_entity_from_template_deferred(const char* template_name);
+
 // Load templates from a JSON file
 int load_templates_from_file(const char* filename);
 
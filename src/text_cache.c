@@ -0,0 +1,245 @@
+#include "text_cache.h"
+#include "log.h"
+#include <string.h>
+
+// FNV-1a over the string, then the rest of the key
+static uint32_t text_cache_hash(SDL_Renderer *renderer, TTF_Font *font, const char *text, SDL_Color color) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        hash = (hash ^ *c) * 16777619u;
+    }
+    hash = (hash ^ (uint32_t)(uintptr_t)renderer) * 16777619u;
+    hash = (hash ^ (uint32_t)(uintptr_t)font) * 16777619u;
+    hash = (hash ^ ((uint32_t)color.r | (uint32_t)color.g << 8 | (uint32_t)color.b << 16 | (uint32_t)color.a << 24)) * 16777619u;
+    return hash;
+}
+
+static bool text_cache_color_equal(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+void text_cache_init(TextCache *cache, size_t byte_budget) {
+    if (!cache) return;
+
+    memset(cache, 0, sizeof(TextCache));
+    for (int i = 0; i < TEXT_CACHE_BUCKETS; i++) {
+        cache->buckets[i] = TEXT_CACHE_NONE;
+    }
+    for (int i = 0; i < TEXT_CACHE_CAPACITY; i++) {
+        cache->entries[i].bucket_next = (uint16_t)(i + 1 < TEXT_CACHE_CAPACITY ? i + 1 : TEXT_CACHE_NONE);
+    }
+    cache->free_head = 0;
+    cache->lru_head = TEXT_CACHE_NONE;
+    cache->lru_tail = TEXT_CACHE_NONE;
+    cache->byte_budget = byte_budget;
+    cache->initialized = true;
+}
+
+static void text_cache_lru_unlink(TextCache *cache, uint16_t index) {
+    TextCacheEntry *entry = &cache->entries[index];
+    if (entry->lru_prev != TEXT_CACHE_NONE) {
+        cache->entries[entry->lru_prev].lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next != TEXT_CACHE_NONE) {
+        cache->entries[entry->lru_next].lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+}
+
+static void text_cache_lru_push_front(TextCache *cache, uint16_t index) {
+    TextCacheEntry *entry = &cache->entries[index];
+    entry->lru_prev = TEXT_CACHE_NONE;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head != TEXT_CACHE_NONE) {
+        cache->entries[cache->lru_head].lru_prev = index;
+    } else {
+        cache->lru_tail = index;
+    }
+    cache->lru_head = index;
+}
+
+// Unlink an entry from its bucket and the LRU list, free its texture and return it to the free list
+static void text_cache_remove(TextCache *cache, uint16_t index) {
+    TextCacheEntry *entry = &cache->entries[index];
+
+    uint16_t *link = &cache->buckets[entry->hash & (TEXT_CACHE_BUCKETS - 1)];
+    while (*link != TEXT_CACHE_NONE && *link != index) {
+        link = &cache->entries[*link].bucket_next;
+    }
+    if (*link == index) {
+        *link = entry->bucket_next;
+    }
+    text_cache_lru_unlink(cache, index);
+
+    if (entry->texture) {
+        SDL_DestroyTexture(entry->texture);
+    }
+    cache->bytes -= entry->bytes;
+    cache->count--;
+
+    memset(entry, 0, sizeof(TextCacheEntry));
+    entry->bucket_next = cache->free_head;
+    cache->free_head = index;
+}
+
+void text_cache_cleanup(TextCache *cache) {
+    if (!cache || !cache->initialized) return;
+
+    LOG_INFO("Text cache: %llu hits, %llu misses, %llu evictions, %u entries (%zu bytes) at shutdown",
+             (unsigned long long)cache->hits, (unsigned long long)cache->misses,
+             (unsigned long long)cache->evictions, cache->count, cache->bytes);
+    text_cache_purge(cache, NULL);
+    cache->initialized = false;
+}
+
+void text_cache_purge(TextCache *cache, SDL_Renderer *renderer) {
+    if (!cache || !cache->initialized) return;
+
+    uint16_t index = cache->lru_head;
+    while (index != TEXT_CACHE_NONE) {
+        uint16_t next = cache->entries[index].lru_next;
+        if (!renderer || cache->entries[index].renderer == renderer) {
+            text_cache_remove(cache, index);
+        }
+        index = next;
+    }
+}
+
+// Rasterize text into a texture of its own; NULL if TTF or the renderer fails
+static SDL_Texture *text_cache_rasterize(SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                                        SDL_Color color, int *width, int *height) {
+    SDL_Surface *text_surface = TTF_RenderText_Solid(font, text, color);
+    if (!text_surface) return NULL;
+
+    SDL_Texture *text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
+    *width = text_surface->w;
+    *height = text_surface->h;
+    SDL_FreeSurface(text_surface);
+    return text_texture;
+}
+
+// Draw a texture the cache did not take and destroy it
+static void text_cache_draw_texture_once(SDL_Renderer *renderer, SDL_Texture *text_texture, int x, int y,
+                                         int text_width, int text_height, int *width, int *height) {
+    SDL_Rect text_rect = {x, y, text_width, text_height};
+    SDL_RenderCopy(renderer, text_texture, NULL, &text_rect);
+    SDL_DestroyTexture(text_texture);
+    if (width) *width = text_width;
+    if (height) *height = text_height;
+}
+
+// Rasterize and draw without touching the cache
+static void text_cache_draw_uncached(SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                                     int x, int y, SDL_Color color, int *width, int *height) {
+    int text_width, text_height;
+    SDL_Texture *text_texture = text_cache_rasterize(renderer, font, text, color, &text_width, &text_height);
+    if (text_texture) {
+        text_cache_draw_texture_once(renderer, text_texture, x, y, text_width, text_height, width, height);
+    }
+}
+
+static uint16_t text_cache_find(TextCache *cache, SDL_Renderer *renderer, TTF_Font *font,
+                                const char *text, SDL_Color color, uint32_t hash) {
+    uint16_t index = cache->buckets[hash & (TEXT_CACHE_BUCKETS - 1)];
+    while (index != TEXT_CACHE_NONE) {
+        const TextCacheEntry *entry = &cache->entries[index];
+        if (entry->hash == hash && entry->renderer == renderer && entry->font == font &&
+            text_cache_color_equal(entry->color, color) && strcmp(entry->text, text) == 0) {
+            return index;
+        }
+        index = entry->bucket_next;
+    }
+    return TEXT_CACHE_NONE;
+}
+
+// Take a rasterized texture into a new entry, evicting least recently used entries to
+// make room. TEXT_CACHE_NONE (and the texture left to the caller) if it is larger than
+// the whole byte budget or no entry could be freed.
+static uint16_t text_cache_insert(TextCache *cache, SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                                  SDL_Color color, uint32_t hash, SDL_Texture *text_texture, int width, int height) {
+    size_t bytes = (size_t)width * (size_t)height * 4;
+    if (bytes > cache->byte_budget) return TEXT_CACHE_NONE;
+
+    while (cache->lru_tail != TEXT_CACHE_NONE &&
+           (cache->free_head == TEXT_CACHE_NONE || cache->bytes + bytes > cache->byte_budget)) {
+        text_cache_remove(cache, cache->lru_tail);
+        cache->evictions++;
+    }
+
+    uint16_t index = cache->free_head;
+    if (index == TEXT_CACHE_NONE) return TEXT_CACHE_NONE;
+    TextCacheEntry *entry = &cache->entries[index];
+    cache->free_head = entry->bucket_next;
+
+    entry->renderer = renderer;
+    entry->font = font;
+    entry->color = color;
+    entry->hash = hash;
+    strcpy(entry->text, text);
+    entry->texture = text_texture;
+    entry->width = width;
+    entry->height = height;
+    entry->bytes = bytes;
+    entry->used = true;
+
+    uint16_t *bucket = &cache->buckets[hash & (TEXT_CACHE_BUCKETS - 1)];
+    entry->bucket_next = *bucket;
+    *bucket = index;
+    text_cache_lru_push_front(cache, index);
+
+    cache->bytes += bytes;
+    cache->count++;
+    return index;
+}
+
+void text_cache_draw(TextCache *cache, SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                     int x, int y, SDL_Color color, int *width, int *height) {
+    if (!renderer || !font || !text || text[0] == '\0') return;
+
+    if (!cache || !cache->initialized || strlen(text) >= TEXT_CACHE_MAX_TEXT) {
+        text_cache_draw_uncached(renderer, font, text, x, y, color, width, height);
+        return;
+    }
+
+    uint32_t hash = text_cache_hash(renderer, font, text, color);
+    uint16_t index = text_cache_find(cache, renderer, font, text, color, hash);
+    if (index != TEXT_CACHE_NONE) {
+        cache->hits++;
+        cache->frame_hits++;
+        if (index != cache->lru_head) {
+            text_cache_lru_unlink(cache, index);
+            text_cache_lru_push_front(cache, index);
+        }
+    } else {
+        cache->misses++;
+        cache->frame_misses++;
+        int text_width, text_height;
+        SDL_Texture *text_texture = text_cache_rasterize(renderer, font, text, color, &text_width, &text_height);
+        if (!text_texture) return;
+
+        index = text_cache_insert(cache, renderer, font, text, color, hash, text_texture, text_width, text_height);
+        if (index == TEXT_CACHE_NONE) {
+            // Too big to keep (or nowhere to keep it): still draw it this once
+            text_cache_draw_texture_once(renderer, text_texture, x, y, text_width, text_height, width, height);
+            return;
+        }
+    }
+
+    const TextCacheEntry *entry = &cache->entries[index];
+    SDL_Rect text_rect = {x, y, entry->width, entry->height};
+    SDL_RenderCopy(renderer, entry->texture, NULL, &text_rect);
+    if (width) *width = entry->width;
+    if (height) *height = entry->height;
+}
+
+void text_cache_take_frame_counts(TextCache *cache, uint32_t *hits, uint32_t *misses) {
+    if (!cache) return;
+
+    if (hits) *hits = cache->frame_hits;
+    if (misses) *misses = cache->frame_misses;
+    cache->frame_hits = 0;
+    cache->frame_misses = 0;
+}
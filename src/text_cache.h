@@ -0,0 +1,69 @@
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define TEXT_CACHE_CAPACITY 256          // Entries, independent of the byte budget
+#define TEXT_CACHE_BUCKETS 128           // Hash buckets, power of two
+#define TEXT_CACHE_MAX_TEXT 128          // Longer strings (or textures over the byte budget) are rendered uncached
+#define TEXT_CACHE_NONE UINT16_MAX
+
+// One rasterized string, keyed on (renderer, font, text, color)
+typedef struct {
+    SDL_Renderer *renderer;
+    TTF_Font *font;
+    SDL_Color color;
+    uint32_t hash;
+    char text[TEXT_CACHE_MAX_TEXT];
+    SDL_Texture *texture;
+    int width;
+    int height;
+    size_t bytes;                        // Estimated texture memory (width * height * 4)
+    uint16_t bucket_next;                // Hash chain
+    uint16_t lru_prev;                   // Towards most recently used
+    uint16_t lru_next;                   // Towards least recently used
+    bool used;
+} TextCacheEntry;
+
+typedef struct {
+    TextCacheEntry entries[TEXT_CACHE_CAPACITY];
+    uint16_t buckets[TEXT_CACHE_BUCKETS];
+    uint16_t lru_head;                   // Most recently used
+    uint16_t lru_tail;                   // Next to evict
+    uint16_t free_head;                  // Unused entries, chained through bucket_next
+    uint32_t count;
+    size_t bytes;
+    size_t byte_budget;
+
+    // Lifetime totals
+    uint64_t hits;
+    uint64_t misses;                     // Each miss is one TTF rasterization
+    uint64_t evictions;
+
+    // Since text_cache_take_frame_counts
+    uint32_t frame_hits;
+    uint32_t frame_misses;
+    bool initialized;
+} TextCache;
+
+void text_cache_init(TextCache *cache, size_t byte_budget);
+
+// Destroys every cached texture; call before the renderers go
+void text_cache_cleanup(TextCache *cache);
+
+// Drop entries for a renderer (NULL = all), e.g. before destroying it or after a device reset
+void text_cache_purge(TextCache *cache, SDL_Renderer *renderer);
+
+// Draw text with its top-left at (x, y), rasterizing only on a miss.
+// Optional width/height receive the drawn size.
+void text_cache_draw(TextCache *cache, SDL_Renderer *renderer, TTF_Font *font, const char *text,
+                     int x, int y, SDL_Color color, int *width, int *height);
+
+// Read and reset the per-frame hit/miss counts
+void text_cache_take_frame_counts(TextCache *cache, uint32_t *hits, uint32_t *misses);
+
+#endif // TEXT_CACHE_H
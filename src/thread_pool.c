@@ -0,0 +1,187 @@
+#include "thread_pool.h"
+#include "appstate.h"
+#include "log.h"
+#include "error.h"
+#include <SDL2/SDL.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+typedef struct {
+    ThreadPoolJobFunction function;
+    void *data;
+} ThreadPoolJob;
+
+// Per-worker FIFO; only touched with the pool mutex held
+typedef struct {
+    ThreadPoolJob jobs[THREAD_POOL_MAX_JOBS];
+    uint32_t head;
+    uint32_t count;
+    SDL_cond *work_available;
+} ThreadPoolQueue;
+
+typedef struct {
+    ThreadPool *pool;
+    uint32_t index;
+} ThreadPoolWorker;
+
+struct ThreadPool {
+    SDL_Thread *threads[THREAD_POOL_MAX_WORKERS];
+    SDL_threadID thread_ids[THREAD_POOL_MAX_WORKERS];
+    ThreadPoolWorker workers[THREAD_POOL_MAX_WORKERS];
+    ThreadPoolQueue queues[THREAD_POOL_MAX_WORKERS];
+    uint32_t worker_count;
+
+    SDL_mutex *mutex;
+    SDL_cond *all_done;
+    uint32_t pending;          // Jobs submitted but not yet finished
+    bool shutting_down;
+};
+
+static int thread_pool_worker_main(void *data) {
+    ThreadPoolWorker *worker = (ThreadPoolWorker *)data;
+    ThreadPool *pool = worker->pool;
+    ThreadPoolQueue *queue = &pool->queues[worker->index];
+
+    SDL_LockMutex(pool->mutex);
+    for (;;) {
+        while (queue->count == 0 && !pool->shutting_down) {
+            SDL_CondWait(queue->work_available, pool->mutex);
+        }
+        if (queue->count == 0 && pool->shutting_down) {
+            break;
+        }
+
+        ThreadPoolJob job = queue->jobs[queue->head];
+        queue->head = (queue->head + 1) % THREAD_POOL_MAX_JOBS;
+        queue->count--;
+
+        SDL_UnlockMutex(pool->mutex);
+        job.function(job.data, worker->index);
+        SDL_LockMutex(pool->mutex);
+
+        if (--pool->pending == 0) {
+            SDL_CondBroadcast(pool->all_done);
+        }
+    }
+    SDL_UnlockMutex(pool->mutex);
+    return 0;
+}
+
+ThreadPool *thread_pool_create(uint32_t worker_count) {
+    if (worker_count == 0 || worker_count > THREAD_POOL_MAX_WORKERS) {
+        ERROR_SET(RESULT_ERROR_INVALID_PARAMETER, "Worker count %u out of range [1, %d]", worker_count, THREAD_POOL_MAX_WORKERS);
+        return NULL;
+    }
+
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        ERROR_SET(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate thread pool");
+        return NULL;
+    }
+
+    pool->mutex = SDL_CreateMutex();
+    pool->all_done = SDL_CreateCond();
+    if (!pool->mutex || !pool->all_done) {
+        LOG_ERROR("Failed to create thread pool synchronization: %s", SDL_GetError());
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < worker_count; i++) {
+        pool->queues[i].work_available = SDL_CreateCond();
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+
+        char name[32];
+        snprintf(name, sizeof(name), "ecs_worker_%u", i);
+        if (pool->queues[i].work_available) {
+            pool->threads[i] = SDL_CreateThread(thread_pool_worker_main, name, &pool->workers[i]);
+        }
+        if (!pool->threads[i]) {
+            LOG_ERROR("Failed to create worker thread %u: %s", i, SDL_GetError());
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+        pool->thread_ids[i] = SDL_GetThreadID(pool->threads[i]);
+        pool->worker_count++;
+    }
+
+    LOG_INFO("Thread pool started with %u workers", worker_count);
+    return pool;
+}
+
+void thread_pool_destroy(ThreadPool *pool) {
+    if (!pool) return;
+
+    if (pool->mutex) {
+        SDL_LockMutex(pool->mutex);
+        pool->shutting_down = true;
+        for (uint32_t i = 0; i < pool->worker_count; i++) {
+            SDL_CondSignal(pool->queues[i].work_available);
+        }
+        SDL_UnlockMutex(pool->mutex);
+    }
+
+    for (uint32_t i = 0; i < THREAD_POOL_MAX_WORKERS; i++) {
+        if (pool->threads[i]) {
+            SDL_WaitThread(pool->threads[i], NULL);
+        }
+        if (pool->queues[i].work_available) {
+            SDL_DestroyCond(pool->queues[i].work_available);
+        }
+    }
+
+    if (pool->all_done) SDL_DestroyCond(pool->all_done);
+    if (pool->mutex) SDL_DestroyMutex(pool->mutex);
+    free(pool);
+}
+
+uint32_t thread_pool_worker_count(const ThreadPool *pool) {
+    return pool ? pool->worker_count : 0;
+}
+
+uint32_t thread_pool_current_worker(const ThreadPool *pool) {
+    if (!pool) return THREAD_POOL_NOT_WORKER;
+
+    SDL_threadID self = SDL_ThreadID();
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        if (pool->thread_ids[i] == self) {
+            return i;
+        }
+    }
+    return THREAD_POOL_NOT_WORKER;
+}
+
+bool thread_pool_submit(ThreadPool *pool, uint32_t worker_index, ThreadPoolJobFunction function, void *data) {
+    if (!pool || !function || worker_index >= pool->worker_count) {
+        ERROR_SET(RESULT_ERROR_INVALID_PARAMETER, "Invalid thread pool job submission");
+        return false;
+    }
+
+    SDL_LockMutex(pool->mutex);
+    ThreadPoolQueue *queue = &pool->queues[worker_index];
+    if (queue->count >= THREAD_POOL_MAX_JOBS) {
+        SDL_UnlockMutex(pool->mutex);
+        ERROR_SET(RESULT_ERROR_SYSTEM_LIMIT, "Worker %u job queue full (%d)", worker_index, THREAD_POOL_MAX_JOBS);
+        return false;
+    }
+
+    uint32_t tail = (queue->head + queue->count) % THREAD_POOL_MAX_JOBS;
+    queue->jobs[tail].function = function;
+    queue->jobs[tail].data = data;
+    queue->count++;
+    pool->pending++;
+    SDL_CondSignal(queue->work_available);
+    SDL_UnlockMutex(pool->mutex);
+    return true;
+}
+
+void thread_pool_wait(ThreadPool *pool) {
+    if (!pool) return;
+
+    SDL_LockMutex(pool->mutex);
+    while (pool->pending > 0) {
+        SDL_CondWait(pool->all_done, pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+}
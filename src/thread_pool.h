@@ -0,0 +1,32 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Thread pool configuration
+#define THREAD_POOL_MAX_WORKERS 16     // Upper bound on worker threads
+#define THREAD_POOL_MAX_JOBS 1024      // Queued jobs per worker between waits
+#define THREAD_POOL_NOT_WORKER UINT32_MAX // Returned for threads outside the pool
+
+// Job callback; worker_index identifies the worker running it (0..worker_count-1)
+typedef void (*ThreadPoolJobFunction)(void *data, uint32_t worker_index);
+
+typedef struct ThreadPool ThreadPool;
+
+// Pool lifetime
+ThreadPool *thread_pool_create(uint32_t worker_count);
+void thread_pool_destroy(ThreadPool *pool);
+uint32_t thread_pool_worker_count(const ThreadPool *pool);
+
+// Index of the calling worker thread, or THREAD_POOL_NOT_WORKER
+uint32_t thread_pool_current_worker(const ThreadPool *pool);
+
+// Queue a job on a specific worker. Jobs on one worker run in submission order,
+// so a fixed job-to-worker assignment gives reproducible per-thread ordering.
+bool thread_pool_submit(ThreadPool *pool, uint32_t worker_index, ThreadPoolJobFunction function, void *data);
+
+// Block until every submitted job has finished
+void thread_pool_wait(ThreadPool *pool);
+
+#endif // THREAD_POOL_H
@@ -4,8 +4,19 @@
 #include <stdint.h>
 
 // Entity type definition
+// An entity handle packs a slot index (low 20 bits) and a generation (high 12 bits).
+// The generation is bumped every time a slot is recycled, so stale handles can be
+// detected with a single compare against the slot's current generation.
 typedef uint32_t Entity;
 #define INVALID_ENTITY 0xFFFFFFFF
 
+#define ENTITY_INDEX_BITS 20
+#define ENTITY_INDEX_MASK ((1u << ENTITY_INDEX_BITS) - 1)
+#define ENTITY_GENERATION_MASK 0xFFFu
+#define ENTITY_INDEX(entity) ((uint32_t)(entity) & ENTITY_INDEX_MASK)
+#define ENTITY_GENERATION(entity) ((uint32_t)(entity) >> ENTITY_INDEX_BITS)
+#define ENTITY_MAKE(index, generation) \
+    ((Entity)((((uint32_t)(generation) & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | ((uint32_t)(index) & ENTITY_INDEX_MASK)))
+
 #endif
 
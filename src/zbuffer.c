@@ -0,0 +1,84 @@
+#include "zbuffer.h"
+#include "log.h"
+#include "error.h"
+#include "appstate.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Cells per composite block; the block plus one row of each layer stays in L1
+#define ZBUFFER_COMPOSITE_BLOCK 1024
+
+bool zbuffer_init(ZBuffer *zbuffer, uint32_t cell_count) {
+    if (!zbuffer || cell_count == 0) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_INVALID_PARAMETER, "Z-buffer needs a positive cell count");
+    }
+
+    memset(zbuffer, 0, sizeof(ZBuffer));
+    zbuffer->cells = calloc((size_t)cell_count * RENDER_LAYER_COUNT, sizeof(ZBufferCell));
+    if (!zbuffer->cells) {
+        ERROR_RETURN_FALSE(RESULT_ERROR_OUT_OF_MEMORY, "Failed to allocate %d z-buffer layers of %u cells",
+                           RENDER_LAYER_COUNT, cell_count);
+    }
+    zbuffer->cell_count = cell_count;
+    return true;
+}
+
+void zbuffer_free(ZBuffer *zbuffer) {
+    if (!zbuffer) return;
+
+    free(zbuffer->cells);
+    memset(zbuffer, 0, sizeof(ZBuffer));
+}
+
+ZBufferCell *zbuffer_layer(ZBuffer *zbuffer, RenderLayer layer) {
+    if (!zbuffer || !zbuffer->cells || layer >= RENDER_LAYER_COUNT) return NULL;
+
+    zbuffer->written |= ZBUFFER_LAYER_BIT(layer);
+    return zbuffer->cells + (size_t)layer * zbuffer->cell_count;
+}
+
+void zbuffer_clear(ZBuffer *zbuffer, uint32_t keep_mask) {
+    if (!zbuffer || !zbuffer->cells) return;
+
+    // Layers nothing wrote to are still zero from their last clear
+    uint32_t clear = zbuffer->written & ~keep_mask;
+    for (int layer = 0; layer < RENDER_LAYER_COUNT; layer++) {
+        if (clear & ZBUFFER_LAYER_BIT(layer)) {
+            memset(zbuffer->cells + (size_t)layer * zbuffer->cell_count, 0, zbuffer->cell_count * sizeof(ZBufferCell));
+        }
+    }
+    zbuffer->written &= keep_mask;
+}
+
+void zbuffer_composite(const ZBuffer *zbuffer, ZBufferCell *out) {
+    if (!zbuffer || !zbuffer->cells || !out) return;
+
+    const ZBufferCell *layers[RENDER_LAYER_COUNT];
+    int layer_count = 0;
+    for (int layer = 0; layer < RENDER_LAYER_COUNT; layer++) {
+        if (zbuffer->written & ZBUFFER_LAYER_BIT(layer)) {
+            layers[layer_count++] = zbuffer->cells + (size_t)layer * zbuffer->cell_count;
+        }
+    }
+
+    size_t cell_count = zbuffer->cell_count;
+    if (layer_count == 0) {
+        memset(out, 0, cell_count * sizeof(ZBufferCell));
+        return;
+    }
+
+    // The lowest written layer is the starting point; each higher one replaces the
+    // cells where it has content. The select has no branch, so it vectorizes.
+    for (size_t base = 0; base < cell_count; base += ZBUFFER_COMPOSITE_BLOCK) {
+        size_t length = cell_count - base < ZBUFFER_COMPOSITE_BLOCK ? cell_count - base : ZBUFFER_COMPOSITE_BLOCK;
+        ZBufferCell *restrict dst = out + base;
+        memcpy(dst, layers[0] + base, length * sizeof(ZBufferCell));
+
+        for (int layer = 1; layer < layer_count; layer++) {
+            const ZBufferCell *restrict src = layers[layer] + base;
+            for (size_t i = 0; i < length; i++) {
+                dst[i] = src[i] ? src[i] : dst[i];
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef ZBUFFER_H
+#define ZBUFFER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Packed z-buffer cell: glyph in bits 0-7, foreground color index in 8-15,
+// background color index in 16-23 (0 = none), layer in 24-27, flags in 28-31.
+// Zero is an empty cell, so clearing is a memset and "has content" is a compare.
+typedef uint32_t ZBufferCell;
+
+#define ZCELL_EMPTY 0u
+#define ZCELL_FLAGS_SHIFT 28
+
+// Bottom to top; higher layers cover lower ones wherever they have content
+typedef enum {
+    RENDER_LAYER_BACKGROUND,      // Dungeon tiles, rewritten in full every pass
+    RENDER_LAYER_ITEMS,
+    RENDER_LAYER_ACTORS,
+    RENDER_LAYER_EFFECTS,
+    RENDER_LAYER_OVERLAY,         // UI markers drawn over the map
+    RENDER_LAYER_COUNT
+} RenderLayer;
+
+#define ZBUFFER_LAYER_BIT(layer) (1u << (layer))
+
+static inline ZBufferCell zcell_pack(char glyph, uint8_t fg, uint8_t bg, RenderLayer layer) {
+    return (uint32_t)(unsigned char)glyph | (uint32_t)fg << 8 | (uint32_t)bg << 16 | ((uint32_t)layer & 0x0F) << 24;
+}
+
+static inline char zcell_glyph(ZBufferCell cell) { return (char)(cell & 0xFF); }
+static inline uint8_t zcell_fg(ZBufferCell cell) { return (uint8_t)(cell >> 8); }
+static inline uint8_t zcell_bg(ZBufferCell cell) { return (uint8_t)(cell >> 16); }
+static inline RenderLayer zcell_layer(ZBufferCell cell) { return (RenderLayer)((cell >> 24) & 0x0F); }
+
+// All layers in one contiguous block, layer-major, cell_count cells each
+typedef struct {
+    ZBufferCell *cells;
+    uint32_t cell_count;
+    uint32_t written;             // ZBUFFER_LAYER_BIT of layers written since their last clear
+} ZBuffer;
+
+bool zbuffer_init(ZBuffer *zbuffer, uint32_t cell_count);
+void zbuffer_free(ZBuffer *zbuffer);
+
+// A layer for writing; marks it as having content so clears and composites visit it
+ZBufferCell *zbuffer_layer(ZBuffer *zbuffer, RenderLayer layer);
+
+// Zero every written layer except those in keep_mask (layers the caller rewrites in full)
+void zbuffer_clear(ZBuffer *zbuffer, uint32_t keep_mask);
+
+// Resolve the topmost non-empty cell of the written layers into out (cell_count cells).
+// Works through the buffer in cache-sized blocks so each output cell is stored once.
+void zbuffer_composite(const ZBuffer *zbuffer, ZBufferCell *out);
+
+#endif // ZBUFFER_H